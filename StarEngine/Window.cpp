@@ -333,9 +333,18 @@ namespace star
 
 			//AttachThreadInput(m_dKeybThreadID, GetCurrentThreadId(), true);
 
+			FramePacer & framePacer = StarEngine::GetInstance()->GetFramePacer();
+
 			// Main message loop:
 			while(msg.message != WM_QUIT)
 			{
+				// Nothing to update or draw, so block until the next message arrives.
+				if(!m_IsActive || framePacer.IsIdle())
+				{
+					WaitMessage();
+					framePacer.Restart();
+				}
+
 				bool monitor_started(false);
 				if(m_IsActive)
 				{
@@ -343,27 +352,38 @@ namespace star
 					monitor_started = true;
 				}
 
-				if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+				// Handle every pending message, the frame pacer limits the loop rate.
+				while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
 				{
+					if(msg.message == WM_QUIT)
+					{
+						break;
+					}
 					TranslateMessage(&msg);
 					DispatchMessage(&msg);
 				}
+				if(msg.message == WM_QUIT)
+				{
+					break;
+				}
 
-				if(m_IsActive)
+				bool running = m_IsActive && !framePacer.IsIdle();
+				if(running)
 				{					
 					mGamePtr->Update(mContext);
 					SetWindowsTitle();
 					GraphicsManager::GetInstance()->SetHasWindowChanged(false);
 				}
 
-				if(m_IsActive) // We've processed all pending Win32 messages, and can now do a rendering update.
+				if(running) // We've processed all pending Win32 messages, and can now do a rendering update.
 				{
 					star::InputManager::GetInstance()->UpdateWin();
 				}
-				if(m_IsActive) // We've processed all pending Win32 messages, and can now do a rendering update.
+				if(running) // We've processed all pending Win32 messages, and can now do a rendering update.
 				{
 					mGamePtr->Draw();
 					SwapBuffers(Window::mHDC); // Swaps display buffers
+					framePacer.EndFrame();
 				}
 
 
@@ -649,6 +669,14 @@ namespace star
 
 	LRESULT CALLBACK Window::wEventsProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 	{
+		// Input and window changes end the low-power idle.
+		if((message >= WM_KEYFIRST && message <= WM_KEYLAST)
+			|| (message >= WM_MOUSEFIRST && message <= WM_MOUSELAST)
+			|| message == WM_SIZE || message == WM_ACTIVATE)
+		{
+			StarEngine::GetInstance()->GetFramePacer().WakeUp();
+		}
+
 		switch (message)
 		{
 			case WM_DESTROY:
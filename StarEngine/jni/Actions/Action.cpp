@@ -1,8 +1,12 @@
 #include "Action.h"
 #include "../Objects/Object.h"
+#include "../Helpers/MemoryPool.h"
 
 namespace star
 {
+	//Zero-initialized, see TypeIDSlot.
+	std::atomic<uint32> ActionType::m_NextID;
+
 	Action::Action()
 		: Entity()
 		, m_pParent(nullptr)
@@ -26,6 +30,16 @@ namespace star
 
 	}
 
+	void * Action::operator new(size_t size)
+	{
+		return MemoryPool::Allocate(size);
+	}
+
+	void Action::operator delete(void * pMemory, size_t size)
+	{
+		MemoryPool::Deallocate(pMemory, size);
+	}
+
 	void Action::Destroy()
 	{
 		m_pParent->RemoveAction(this);
@@ -58,8 +72,15 @@ namespace star
 	{
 		if(!m_IsInitialized)
 		{
+			//Actions paused before they had a parent to pause
+			//their timers with, like restored ones, pause now.
+			bool isPaused = m_IsPaused;
 			m_IsInitialized = true;
 			Initialize();
+			if(isPaused)
+			{
+				Pause();
+			}
 		}
 	}
 
@@ -72,4 +93,25 @@ namespace star
 	{
 		return m_pParent;
 	}
+
+	uint32 Action::GetTypeID() const
+	{
+		return ActionType::GetID<Action>();
+	}
+
+	void Action::Serialize(SnapshotWriter & writer) const
+	{
+	}
+
+	void Action::Deserialize(SnapshotReader & reader)
+	{
+	}
+
+	void Action::OnNameChanged(uint32 previousHash)
+	{
+		if(m_pParent)
+		{
+			m_pParent->UpdateActionName(this, previousHash);
+		}
+	}
 }
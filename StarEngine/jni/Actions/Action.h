@@ -1,10 +1,29 @@
 #pragma once
 
 #include "../Entity.h"
+#include "../Helpers/TypeID.h"
 
 namespace star
 {
 	class Object;
+	class SnapshotWriter;
+	class SnapshotReader;
+
+	//Hands out a small integer per action type, like ComponentType does
+	//for components. Actions report theirs through GetTypeID.
+	class ActionType final
+	{
+	public:
+		static const uint32 INVALID_ID = 0xFFFFFFFF;
+
+		template <typename T>
+		static uint32 GetID();
+
+	private:
+		static std::atomic<uint32> m_NextID;
+
+		ActionType();
+	};
 
 	class Action : public Entity
 	{
@@ -14,6 +33,9 @@ namespace star
 
 		virtual ~Action();
 
+		static void * operator new(size_t size);
+		static void operator delete(void * pMemory, size_t size);
+
 		void Destroy();
 
 		virtual void Restart();
@@ -26,7 +48,17 @@ namespace star
 		void SetParent(Object * parent);
 		Object * GetParent() const;
 
+		//Scene snapshot hooks. The name and paused state are stored by
+		//the snapshot itself, callbacks can't be stored at all.
+		//Derived types that are stored in snapshots or prefabs
+		//override GetTypeID with ActionType::GetID of themselves.
+		virtual uint32 GetTypeID() const;
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
+		virtual void OnNameChanged(uint32 previousHash);
+
 		virtual void Initialize() = 0;
 		virtual void Update(const Context & context) = 0;
 
@@ -35,9 +67,13 @@ namespace star
 		bool m_IsInitialized;
 
 	private:
+		friend class SceneSnapshot;
+
 		Action & operator=(const Action&);
 		Action & operator=(Action&&);
 		Action(const Action&);
 		Action(Action&&);
 	};
 }
+
+#include "Action.inl"
@@ -0,0 +1,8 @@
+namespace star
+{
+	template <typename T>
+	uint32 ActionType::GetID()
+	{
+		return TakeTypeID(TypeIDSlot<ActionType, T>::Value, m_NextID);
+	}
+}
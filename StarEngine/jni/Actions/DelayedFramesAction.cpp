@@ -1,4 +1,5 @@
 #include "DelayedFramesAction.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -45,4 +46,27 @@ namespace star
 	{
 		m_Callback = callback;
 	}
+
+	uint32 DelayedFramesAction::GetTypeID() const
+	{
+		return ActionType::GetID<DelayedFramesAction>();
+	}
+
+	void DelayedFramesAction::Serialize(SnapshotWriter & writer) const
+	{
+		writer.Write<uint32>(m_NumberOfFrames);
+		writer.Write<uint32>(m_CurrentNrOfFrames);
+	}
+
+	void DelayedFramesAction::Deserialize(SnapshotReader & reader)
+	{
+		uint32 numberOfFrames = reader.Read<uint32>();
+		uint32 currentNrOfFrames = reader.Read<uint32>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_NumberOfFrames = numberOfFrames;
+		m_CurrentNrOfFrames = currentNrOfFrames;
+	}
 }
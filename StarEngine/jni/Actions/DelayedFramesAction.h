@@ -13,6 +13,11 @@ namespace star
 
 		void SetCallback(const std::function<void()> & callback);
 
+		//The frames already passed are stored, the callback isn't.
+		virtual uint32 GetTypeID() const;
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
 		virtual void Initialize();
 		virtual void Update(const Context & context);
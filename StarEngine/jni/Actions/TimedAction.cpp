@@ -2,6 +2,7 @@
 #include "../Helpers/Helpers.h"
 #include "../Objects/Object.h"
 #include "../Scenes/BaseScene.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -15,6 +16,7 @@ namespace star
 		, m_UniqueID(_T("TA_"))
 		, m_Seconds(seconds)
 		, m_Callback(callback)
+		, m_RestoredTime(0)
 	{
 		m_UniqueID += string_cast<tstring>(ID_COUNTER++);
 	}
@@ -28,6 +30,7 @@ namespace star
 		, m_UniqueID(_T("TA_"))
 		, m_Seconds(seconds)
 		, m_Callback(callback)
+		, m_RestoredTime(0)
 	{
 		m_UniqueID += string_cast<tstring>(ID_COUNTER++);
 	}
@@ -48,6 +51,14 @@ namespace star
 					}
 				Destroy();
 			});
+		if(m_RestoredTime > 0)
+		{
+			m_pParent->GetScene()->GetStopwatch()->ForwardTimer(
+				m_UniqueID,
+				m_RestoredTime
+				);
+			m_RestoredTime = 0;
+		}
 	}
 
 	void TimedAction::Restart()
@@ -85,4 +96,37 @@ namespace star
 				);
 		}
 	}
+
+	void TimedAction::Serialize(SnapshotWriter & writer) const
+	{
+		float64 time(m_RestoredTime);
+		if(m_IsInitialized)
+		{
+			time = m_pParent->GetScene()->GetStopwatch()->
+				GetTimerAccurateTime(m_UniqueID);
+		}
+		writer.Write<float32>(m_Seconds);
+		writer.Write<float64>(time);
+	}
+
+	void TimedAction::Deserialize(SnapshotReader & reader)
+	{
+		float32 seconds = reader.Read<float32>();
+		float64 time = reader.Read<float64>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_Seconds = seconds;
+		if(m_IsInitialized)
+		{
+			auto stopwatch = m_pParent->GetScene()->GetStopwatch();
+			stopwatch->SetTargetTimeTimer(m_UniqueID, m_Seconds);
+			stopwatch->ForwardTimer(m_UniqueID, time);
+		}
+		else
+		{
+			m_RestoredTime = time;
+		}
+	}
 }
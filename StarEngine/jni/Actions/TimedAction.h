@@ -28,6 +28,10 @@ namespace star
 		
 		void SetCallback(const std::function<void()> & callback);
 
+		//The time already passed is stored, the callback isn't.
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
 		std::function<void()> m_Callback;
 		float32 m_Seconds;
@@ -35,6 +39,8 @@ namespace star
 	private:
 		static uint64 ID_COUNTER;
 		tstring m_UniqueID;
+		//Time passed according to a snapshot, forwarded on Initialize.
+		float64 m_RestoredTime;
 
 		TimedAction & operator=(const TimedAction&);
 		TimedAction & operator=(TimedAction&&);
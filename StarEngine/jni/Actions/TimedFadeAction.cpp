@@ -2,6 +2,7 @@
 #include "../Objects/Object.h"
 #include "../Helpers/Math.h"
 #include "../Components/Graphics/SpriteComponent.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -66,4 +67,32 @@ namespace star
 		m_pSpriteComponent->SetColorMultiplier(m_StartColor);
 		m_CurrentSeconds = 0;
 	}
+
+	uint32 TimedFadeAction::GetTypeID() const
+	{
+		return ActionType::GetID<TimedFadeAction>();
+	}
+
+	void TimedFadeAction::Serialize(SnapshotWriter & writer) const
+	{
+		TimedAction::Serialize(writer);
+		writer.Write<Color>(m_StartColor);
+		writer.Write<Color>(m_EndColor);
+		writer.Write<float32>(m_CurrentSeconds);
+	}
+
+	void TimedFadeAction::Deserialize(SnapshotReader & reader)
+	{
+		TimedAction::Deserialize(reader);
+		Color startColor = reader.Read<Color>();
+		Color endColor = reader.Read<Color>();
+		float32 currentSeconds = reader.Read<float32>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_StartColor = startColor;
+		m_EndColor = endColor;
+		m_CurrentSeconds = currentSeconds;
+	}
 }
@@ -2,6 +2,7 @@
 #include "../Objects/Object.h"
 #include "../Helpers/Math.h"
 #include "../Graphics/UI/UIObject.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -168,4 +169,41 @@ namespace star
 		}
 		m_CurrentSeconds = 0;
 	}
+
+	uint32 TimedMoveAction::GetTypeID() const
+	{
+		return ActionType::GetID<TimedMoveAction>();
+	}
+
+	void TimedMoveAction::Serialize(SnapshotWriter & writer) const
+	{
+		TimedAction::Serialize(writer);
+		writer.Write<vec2>(m_Direction);
+		writer.Write<vec2>(m_Target);
+		writer.Write<vec2>(m_StartPosition);
+		writer.Write<float32>(m_Speed);
+		writer.Write<float32>(m_CurrentSeconds);
+		writer.Write<bool>(m_StartPosSet);
+	}
+
+	void TimedMoveAction::Deserialize(SnapshotReader & reader)
+	{
+		TimedAction::Deserialize(reader);
+		vec2 direction = reader.Read<vec2>();
+		vec2 target = reader.Read<vec2>();
+		vec2 startPosition = reader.Read<vec2>();
+		float32 speed = reader.Read<float32>();
+		float32 currentSeconds = reader.Read<float32>();
+		bool startPosSet = reader.Read<bool>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_Direction = direction;
+		m_Target = target;
+		m_StartPosition = startPosition;
+		m_Speed = speed;
+		m_CurrentSeconds = currentSeconds;
+		m_StartPosSet = startPosSet;
+	}
 }
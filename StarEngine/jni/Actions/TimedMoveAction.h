@@ -41,6 +41,10 @@ namespace star
 
 		virtual void Restart();
 
+		virtual uint32 GetTypeID() const;
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
 		virtual void Initialize();
 		virtual void Update(const Context & context);
@@ -1,6 +1,7 @@
 #include "TimedScaleAction.h"
 #include "../Objects/Object.h"
 #include "../Helpers/Math.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -49,4 +50,32 @@ namespace star
 	{
 		m_CurrentSeconds = 0;
 	}
+
+	uint32 TimedScaleAction::GetTypeID() const
+	{
+		return ActionType::GetID<TimedScaleAction>();
+	}
+
+	void TimedScaleAction::Serialize(SnapshotWriter & writer) const
+	{
+		TimedAction::Serialize(writer);
+		writer.Write<float32>(m_CurrentSeconds);
+		writer.Write<float32>(m_BeginValue);
+		writer.Write<float32>(m_EndValue);
+	}
+
+	void TimedScaleAction::Deserialize(SnapshotReader & reader)
+	{
+		TimedAction::Deserialize(reader);
+		float32 currentSeconds = reader.Read<float32>();
+		float32 beginValue = reader.Read<float32>();
+		float32 endValue = reader.Read<float32>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_CurrentSeconds = currentSeconds;
+		m_BeginValue = beginValue;
+		m_EndValue = endValue;
+	}
 }
@@ -25,6 +25,10 @@ namespace star
 		virtual ~TimedScaleAction(void);
 	
 		virtual void Restart();
+
+		virtual uint32 GetTypeID() const;
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
 	
 	protected:
 		virtual void Update(const Context& context);
@@ -7,7 +7,7 @@ namespace star
 	PathFindNodeComponent::PathFindNodeComponent():
 		BaseComponent()
 	{
-
+		SetTickEnabled(false);
 	}
 
 	PathFindNodeComponent::~PathFindNodeComponent(void)
@@ -27,4 +27,9 @@ namespace star
 	void PathFindNodeComponent::Draw()
 	{
 	}
+
+	uint32 PathFindNodeComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<PathFindNodeComponent>();
+	}
 }
@@ -16,6 +16,8 @@ namespace star
 		void Update(const Context& context);
 		void Draw();
 
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		void InitializeComponent();
 
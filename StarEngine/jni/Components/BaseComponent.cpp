@@ -2,17 +2,29 @@
 #include "../Objects/Object.h"
 #include "../Context.h"
 #include "../Logger.h"
+#include "../Helpers/MemoryPool.h"
+#include "../Scenes/BaseScene.h"
+#include "UpdateScheduler.h"
 
 namespace star
 {
+	//Zero-initialized, see TypeIDSlot.
+	std::atomic<uint32> ComponentType::m_NextID;
+
 	BaseComponent::BaseComponent()
 		: Entity()
 		, m_pParentObject(nullptr)
 		, m_bInitialized(false)
 		, m_bIsEnabled(true)
 		, m_bIsVisible(true)
+		, m_bTickEnabled(true)
 		, m_Dimensions(0,0)
+		, m_TypeID(ComponentType::INVALID_ID)
+		, m_Handle()
+		, m_pScheduler(nullptr)
+		, m_SchedulerSlot(0)
 	{
+		m_Handle = HandleTable<BaseComponent>::GetInstance()->Register(this);
 	}
 
 	BaseComponent::BaseComponent(Object* parent)
@@ -21,12 +33,33 @@ namespace star
 		, m_bInitialized(false)
 		, m_bIsEnabled(true)
 		, m_bIsVisible(true)
+		, m_bTickEnabled(true)
 		, m_Dimensions(0,0)
+		, m_TypeID(ComponentType::INVALID_ID)
+		, m_Handle()
+		, m_pScheduler(nullptr)
+		, m_SchedulerSlot(0)
 	{
+		m_Handle = HandleTable<BaseComponent>::GetInstance()->Register(this);
 	}
 
 	BaseComponent::~BaseComponent(void)
 	{
+		if(m_pScheduler)
+		{
+			m_pScheduler->RemoveComponent(this);
+		}
+		HandleTable<BaseComponent>::GetInstance()->Unregister(m_Handle);
+	}
+
+	void * BaseComponent::operator new(size_t size)
+	{
+		return MemoryPool::Allocate(size);
+	}
+
+	void BaseComponent::operator delete(void * pMemory, size_t size)
+	{
+		MemoryPool::Deallocate(pMemory, size);
 	}
 
 	void BaseComponent::Destroy()
@@ -46,6 +79,19 @@ namespace star
 		}
 		m_bInitialized = true;
 		InitializeComponent();
+
+		//Registered types are updated per phase by the scene,
+		//components outside a scene fall back to the virtual Update.
+		BaseScene * pScene = m_pParentObject ? m_pParentObject->GetScene() : nullptr;
+		if(pScene && UpdateScheduler::IsScheduledType(m_TypeID))
+		{
+			pScene->GetUpdateScheduler()->AddComponent(this);
+			m_pParentObject->MarkTickDirty();
+		}
+		else if(pScene && pScene->IsDenseComponentStorage())
+		{
+			pScene->GetUpdateScheduler()->AddComponent(this);
+		}
 	}
 
 	void BaseComponent::BaseUpdate(const Context& context)
@@ -86,7 +132,7 @@ namespace star
 
 	TransformComponent* BaseComponent::GetTransform() const
 	{
-		 return m_pParentObject->GetComponent<TransformComponent>();
+		 return m_pParentObject->GetTransform();
 	}
 
 	bool BaseComponent::CheckCulling(
@@ -102,6 +148,11 @@ namespace star
 	void BaseComponent::SetEnabled(bool bEnabled)
 	{
 		m_bIsEnabled = bEnabled;
+		MarkCacheDirty();
+		if(m_pParentObject)
+		{
+			m_pParentObject->MarkTickDirty();
+		}
 	}
 
 	bool BaseComponent::IsEnabled() const
@@ -112,12 +163,30 @@ namespace star
 	void BaseComponent::SetVisible(bool bVisible)
 	{
 		m_bIsVisible = bVisible;
+		MarkCacheDirty();
 	}
 
 	bool BaseComponent::IsVisible() const
 	{
 		return m_bIsVisible;
 	}
+
+	void BaseComponent::SetTickEnabled(bool bTickEnabled)
+	{
+		if(m_bTickEnabled != bTickEnabled)
+		{
+			m_bTickEnabled = bTickEnabled;
+			if(m_pParentObject)
+			{
+				m_pParentObject->MarkTickDirty();
+			}
+		}
+	}
+
+	bool BaseComponent::IsTickEnabled() const
+	{
+		return m_bTickEnabled;
+	}
 	
 	const ivec2 & BaseComponent::GetDimensions() const
 	{
@@ -133,4 +202,30 @@ namespace star
 	{
 		return m_Dimensions.y; 
 	}
+
+	uint32 BaseComponent::GetTypeID() const
+	{
+		return m_TypeID;
+	}
+
+	const ComponentHandle & BaseComponent::GetHandle() const
+	{
+		return m_Handle;
+	}
+
+	void BaseComponent::Serialize(SnapshotWriter & writer) const
+	{
+	}
+
+	void BaseComponent::Deserialize(SnapshotReader & reader)
+	{
+	}
+
+	void BaseComponent::MarkCacheDirty()
+	{
+		if(m_pParentObject)
+		{
+			m_pParentObject->MarkCacheDirty();
+		}
+	}
 }
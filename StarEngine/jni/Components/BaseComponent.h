@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Entity.h"
+#include "../Helpers/Handle.h"
+#include "../Helpers/TypeID.h"
 
 namespace star
 {
@@ -8,6 +10,25 @@ namespace star
 	class BaseScene;
 	class TransformComponent;
 	class Object;
+	class UpdateScheduler;
+	class SnapshotWriter;
+	class SnapshotReader;
+
+	//Hands out a small integer per component type, in order of first use,
+	//so an object can index its components by type without RTTI.
+	class ComponentType final
+	{
+	public:
+		static const uint32 INVALID_ID = 0xFFFFFFFF;
+
+		template <typename T>
+		static uint32 GetID();
+
+	private:
+		static std::atomic<uint32> m_NextID;
+
+		ComponentType();
+	};
 
 	class BaseComponent : public Entity
 	{
@@ -16,6 +37,9 @@ namespace star
 		BaseComponent(Object* parent);
 		virtual ~BaseComponent();
 
+		static void * operator new(size_t size);
+		static void operator delete(void * pMemory, size_t size);
+
 		void Destroy();
 
 		void Initialize();
@@ -45,23 +69,52 @@ namespace star
 		void SetVisible(bool bVisible);
 		bool IsVisible() const;
 
+		//Components without per-frame work turn this off, so their
+		//object doesn't call Update on them. On by default.
+		void SetTickEnabled(bool bTickEnabled);
+		bool IsTickEnabled() const;
+
 		const ivec2 & GetDimensions() const;
 		virtual int32 GetWidth() const;
 		virtual int32 GetHeight() const;
 
+		//Concrete components override this with ComponentType::GetID
+		//of themselves, so an object keys them by their real type even
+		//when they are added through a base pointer. The base version
+		//returns the ID the component was registered under.
+		virtual uint32 GetTypeID() const;
+		const ComponentHandle & GetHandle() const;
+
+		//Scene snapshot hooks. The enabled and visible state are
+		//stored by the snapshot itself.
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
 		virtual void InitializeComponent() = 0;
+		void MarkCacheDirty();
 
 		Object* m_pParentObject;
 		bool	m_bInitialized,
 				m_bIsEnabled,
-				m_bIsVisible;
+				m_bIsVisible,
+				m_bTickEnabled;
 		ivec2	m_Dimensions;
 
 	private:
+		friend class Object;
+		friend class UpdateScheduler;
+
+		uint32 m_TypeID;
+		ComponentHandle m_Handle;
+		UpdateScheduler * m_pScheduler;
+		uint32 m_SchedulerSlot;
+
 		BaseComponent(const BaseComponent& t);
 		BaseComponent(BaseComponent&& t);
 		BaseComponent& operator=(const BaseComponent& t);
 		BaseComponent& operator=(BaseComponent&& t);
 	};
 }
+
+#include "BaseComponent.inl"
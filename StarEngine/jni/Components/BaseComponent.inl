@@ -0,0 +1,9 @@
+namespace star
+{
+	template <typename T>
+	uint32 ComponentType::GetID()
+	{
+		//One counter value per instantiation, taken the first time it is asked for.
+		return TakeTypeID(TypeIDSlot<ComponentType, T>::Value, m_NextID);
+	}
+}
@@ -8,6 +8,7 @@
 #include "../Helpers/Math.h"
 #include "../Objects/BaseCamera.h"
 #include "../Graphics/ScaleSystem.h"
+#include "../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -83,8 +84,13 @@ namespace star
 			}
 		}
 #endif
+		CalculateViewMatrix();
+	}
+
+	void CameraComponent::CalculateViewMatrix()
+	{
 #ifdef STAR2D
-		auto pos = m_pParentObject->GetTransform()->GetWorldPosition();
+		auto pos = m_pParentObject->GetTransform()->GetRenderPosition();
 		vec3 eyeVec = vec3(pos.pos2D(), 0);
 #else
 		vec3 eyeVec = m_pParentObject->GetTransform()->GetWorldPosition();
@@ -96,7 +102,7 @@ namespace star
 		mat4 rotTransform;
 	
 #ifdef STAR2D
-		float32 rotDegrees = m_pParentObject->GetTransform()->GetWorldRotation();
+		float32 rotDegrees = m_pParentObject->GetTransform()->GetRenderRotation();
 		rotDegrees = RadiansToDegrees(rotDegrees);
 		quat rotation(vec3(0, 0, rotDegrees));
 #else
@@ -290,4 +296,41 @@ namespace star
 	{
 		posInOut += GetTransform()->GetWorldPosition().pos2D();
 	}
+
+	void CameraComponent::Serialize(SnapshotWriter & writer) const
+	{
+		//The ortho size follows the viewport, which can differ on restore.
+		writer.Write<float32>(m_FOV);
+		writer.Write<float32>(m_NearPlane);
+		writer.Write<float32>(m_FarPlane);
+		writer.Write<float32>(m_Zoom);
+		writer.Write<bool>(m_bPerspectiveProjection);
+	}
+
+	void CameraComponent::Deserialize(SnapshotReader & reader)
+	{
+		float32 fov = reader.Read<float32>();
+		float32 nearPlane = reader.Read<float32>();
+		float32 farPlane = reader.Read<float32>();
+		float32 zoom = reader.Read<float32>();
+		bool perspective = reader.Read<bool>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_FOV = fov;
+		m_NearPlane = nearPlane;
+		m_FarPlane = farPlane;
+		m_Zoom = zoom;
+		m_bPerspectiveProjection = perspective;
+		if(m_bInitialized)
+		{
+			InitializeComponent();
+		}
+	}
+
+	uint32 CameraComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<CameraComponent>();
+	}
 }
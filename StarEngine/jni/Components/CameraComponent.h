@@ -38,6 +38,13 @@ namespace star
 
 		void ConvertScreenToWorld(vec2 & posInOut);
 
+		void CalculateViewMatrix();
+
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		virtual void InitializeComponent();
 
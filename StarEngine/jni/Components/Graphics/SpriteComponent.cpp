@@ -3,6 +3,7 @@
 #include "../../Graphics/SpriteBatch.h"
 #include "SpriteSheetComponent.h"
 #include "TextComponent.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -22,6 +23,9 @@ namespace star
 		, m_SpriteInfo(nullptr)
 	{
 		m_SpriteInfo = new SpriteInfo();
+#ifndef ANDROID
+		SetTickEnabled(false);
+#endif
 	}
 
 	void SpriteComponent::InitializeComponent()
@@ -84,6 +88,10 @@ having a SpriteSheet- or TextComponent."));
 
 	void SpriteComponent::SetUVCoords(const vec4& coords)
 	{
+		if(m_SpriteInfo->uvCoords != coords)
+		{
+			MarkCacheDirty();
+		}
 		m_SpriteInfo->uvCoords = coords;
 	}
 
@@ -155,6 +163,7 @@ having a SpriteSheet- or TextComponent."));
 	void SpriteComponent::SetColorMultiplier(const Color & color)
 	{
 		m_SpriteInfo->colorMultiplier = color;
+		MarkCacheDirty();
 	}
 
 	/// <summary>
@@ -164,6 +173,7 @@ having a SpriteSheet- or TextComponent."));
 	void SpriteComponent::SetHUDOptionEnabled(bool enabled)
 	{
 		m_SpriteInfo->bIsHud = enabled;
+		MarkCacheDirty();
 	}
 
 	/// <summary>
@@ -201,4 +211,58 @@ having a SpriteSheet- or TextComponent."));
 		FillSpriteInfo();
 	}
 
+	void SpriteComponent::Serialize(SnapshotWriter & writer) const
+	{
+		writer.WriteString(m_FilePath.GetPath() + m_FilePath.GetFile());
+		writer.WriteString(m_SpriteName);
+		writer.Write<uint32>(m_WidthSegments);
+		writer.Write<uint32>(m_HeightSegments);
+		writer.Write<uint32>(m_CurrentWidthSegment);
+		writer.Write<uint32>(m_CurrentHeightSegment);
+		writer.Write<Color>(m_SpriteInfo->colorMultiplier);
+		writer.Write<bool>(m_SpriteInfo->bIsHud);
+	}
+
+	void SpriteComponent::Deserialize(SnapshotReader & reader)
+	{
+		tstring filepath = reader.ReadString();
+		tstring spriteName = reader.ReadString();
+		uint32 widthSegments = reader.Read<uint32>();
+		uint32 heightSegments = reader.Read<uint32>();
+		uint32 currentWidthSegment = reader.Read<uint32>();
+		uint32 currentHeightSegment = reader.Read<uint32>();
+		Color colorMultiplier = reader.Read<Color>();
+		bool isHud = reader.Read<bool>();
+		if(!reader.IsValid() || widthSegments == 0 || heightSegments == 0)
+		{
+			return;
+		}
+
+		m_SpriteInfo->colorMultiplier = colorMultiplier;
+		m_SpriteInfo->bIsHud = isHud;
+
+		if(m_bInitialized)
+		{
+			SetTexture(filepath, spriteName, widthSegments, heightSegments);
+		}
+		else
+		{
+			m_FilePath = FilePath(filepath);
+			m_SpriteName = spriteName;
+			m_WidthSegments = widthSegments;
+			m_HeightSegments = heightSegments;
+		}
+		m_CurrentWidthSegment = currentWidthSegment;
+		m_CurrentHeightSegment = currentHeightSegment;
+		if(m_bInitialized)
+		{
+			CreateUVCoords();
+		}
+		MarkCacheDirty();
+	}
+
+	uint32 SpriteComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<SpriteComponent>();
+	}
 }
@@ -4,6 +4,7 @@
 #include "../BaseComponent.h"
 #include "../../Helpers/FilePath.h"
 #include "../../Graphics/Color.h"
+#include "../../Helpers/MemoryPool.h"
 
 namespace star
 {
@@ -24,6 +25,16 @@ namespace star
 
 		}
 
+		static void * operator new(size_t size)
+		{
+			return MemoryPool::Allocate(size);
+		}
+
+		static void operator delete(void * pMemory, size_t size)
+		{
+			MemoryPool::Deallocate(pMemory, size);
+		}
+
 		vec2 vertices;
 		vec4 uvCoords;
 		uint32 textureID;
@@ -136,6 +147,20 @@ namespace star
 			uint32 heightSegments = 1
 			);
 
+		/// <summary>
+		/// Writes the texture, segments, color and HUD state to a scene snapshot.
+		/// </summary>
+		/// <param name="writer">The snapshot writer.</param>
+		virtual void Serialize(SnapshotWriter & writer) const;
+
+		/// <summary>
+		/// Restores the state written by <see cref="Serialize"/>.
+		/// </summary>
+		/// <param name="reader">The snapshot reader.</param>
+		virtual void Deserialize(SnapshotReader & reader);
+
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		/// <summary>
 		/// Initializes the component.
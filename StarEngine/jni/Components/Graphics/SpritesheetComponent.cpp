@@ -2,6 +2,7 @@
 #include "../../Graphics/SpriteAnimationManager.h"
 #include "../../Objects/Object.h"
 #include "TextComponent.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -13,7 +14,7 @@ namespace star
 		, m_Spritesheet()
 		, m_Animations(0)
 	{
-
+		SetTickEnabled(true);
 	}
 
 	SpriteSheetComponent::~SpriteSheetComponent()
@@ -295,4 +296,38 @@ already having a Sprite- or TextComponent."));
 	{
 		return m_Animations.front().IsPlaying();
 	}
+
+	void SpriteSheetComponent::Serialize(SnapshotWriter & writer) const
+	{
+		SpriteComponent::Serialize(writer);
+		writer.WriteString(m_SpritesheetName);
+	}
+
+	void SpriteSheetComponent::Deserialize(SnapshotReader & reader)
+	{
+		SpriteComponent::Deserialize(reader);
+		tstring spritesheet = reader.ReadString();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		if(m_bInitialized)
+		{
+			SetSpritesheet(spritesheet);
+		}
+		else
+		{
+			//The segments follow from the spritesheet on initialization.
+			m_WidthSegments = 1;
+			m_HeightSegments = 1;
+			m_CurrentWidthSegment = 0;
+			m_CurrentHeightSegment = 0;
+			m_SpritesheetName = spritesheet;
+		}
+	}
+
+	uint32 SpriteSheetComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<SpriteSheetComponent>();
+	}
 }
@@ -166,6 +166,20 @@ namespace star
 		/// <returns>Is playing.</returns>
 		bool IsPlaying();
 
+		/// <summary>
+		/// Writes the sprite state and the spritesheet name to a scene snapshot.
+		/// </summary>
+		/// <param name="writer">The snapshot writer.</param>
+		void Serialize(SnapshotWriter & writer) const;
+
+		/// <summary>
+		/// Restores the state written by <see cref="Serialize"/>.
+		/// </summary>
+		/// <param name="reader">The snapshot reader.</param>
+		void Deserialize(SnapshotReader & reader);
+
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		void InitializeComponent();
 		tstring m_SpritesheetName;
@@ -4,9 +4,27 @@
 #include "SpriteComponent.h"
 #include "SpriteSheetComponent.h"
 #include "../../Graphics/SpriteBatch.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
+	TextComponent::TextComponent()
+		: BaseComponent()
+		, m_FontSize(0)
+		, m_StringLength(0)
+		, m_WrapWidth(NO_WRAPPING)
+		, m_FileName(EMPTY_STRING)
+		, m_FontName(EMPTY_STRING)
+		, m_OrigText(EMPTY_STRING)
+		, m_EditText(EMPTY_STRING)
+		, m_TextColor(Color::Black)
+		, m_TextInfo(nullptr)
+		, m_Font(nullptr)
+		, m_TextAlignment(HorizontalAlignment::left)
+	{
+		m_TextInfo = new TextInfo();
+	}
+
 	TextComponent::TextComponent(
 		const tstring& fontName
 		)
@@ -15,6 +33,7 @@ namespace star
 		, m_StringLength(0)
 		, m_WrapWidth(NO_WRAPPING)
 		, m_FileName(EMPTY_STRING)
+		, m_FontName(fontName)
 		, m_OrigText(EMPTY_STRING)
 		, m_EditText(EMPTY_STRING)
 		, m_TextColor(Color::Black)
@@ -41,6 +60,7 @@ namespace star
 		, m_StringLength(0)
 		, m_WrapWidth(NO_WRAPPING)
 		, m_FileName(fontPath)
+		, m_FontName(fontName)
 		, m_OrigText(EMPTY_STRING)
 		, m_EditText(EMPTY_STRING)
 		, m_TextColor(Color::Black)
@@ -65,7 +85,15 @@ namespace star
 
 	void TextComponent::InitializeComponent()
 	{
-		if(m_pParentObject->HasComponent<SpriteSheetComponent>(this)
+		if(m_Font == nullptr)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("Object '") + m_pParentObject->GetName() +
+				_T("': The TextComponent has no font."),
+				STARENGINE_LOG_TAG);
+			m_pParentObject->RemoveComponent(this);
+		}
+		else if(m_pParentObject->HasComponent<SpriteSheetComponent>(this)
 			|| m_pParentObject->HasComponent<SpriteComponent>(this))
 		{
 			Logger::GetInstance()->Log(false,
@@ -151,6 +179,7 @@ having a SpriteSheet- or SpriteComponent."));
 	{
 		if(m_bInitialized)
 		{
+			MarkCacheDirty();
 			m_TextInfo->horizontalTextOffset.clear();
 			if(m_TextAlignment == HorizontalAlignment::center)
 			{
@@ -365,6 +394,7 @@ having a SpriteSheet- or SpriteComponent."));
 	void TextComponent::SetColor(const Color& color)
 	{
 		m_TextColor = color;
+		MarkCacheDirty();
 	}
 
 	const Color& TextComponent::GetColor() const
@@ -491,6 +521,7 @@ having a SpriteSheet- or SpriteComponent."));
 	void TextComponent::SetVerticalSpacing(uint32 spacing)
 	{
 		m_TextInfo->verticalSpacing = spacing;
+		MarkCacheDirty();
 		if(m_bInitialized && m_WrapWidth != NO_WRAPPING)
 		{
 			CleanUpText(CheckWrapping(
@@ -503,6 +534,7 @@ having a SpriteSheet- or SpriteComponent."));
 	void TextComponent::SetHUDOptionEnabled(bool enabled)
 	{
 		m_TextInfo->bIsHud = enabled;
+		MarkCacheDirty();
 	}
 
 	bool TextComponent::IsHUDOptionEnabled() const
@@ -527,4 +559,61 @@ having a SpriteSheet- or SpriteComponent."));
 		m_TextAlignment = HorizontalAlignment::right;
 		CalculateHorizontalTextOffset();
 	}
+
+	void TextComponent::Serialize(SnapshotWriter & writer) const
+	{
+		writer.WriteString(m_FileName);
+		writer.WriteString(m_FontName);
+		writer.Write<uint32>(m_FontSize);
+		writer.WriteString(m_OrigText);
+		writer.Write<Color>(m_TextColor);
+		writer.Write<int32>(m_WrapWidth);
+		writer.Write<int32>(m_TextInfo->verticalSpacing);
+		writer.Write<bool>(m_TextInfo->bIsHud);
+		writer.Write<uint8>(uint8(m_TextAlignment));
+	}
+
+	void TextComponent::Deserialize(SnapshotReader & reader)
+	{
+		tstring fontPath = reader.ReadString();
+		tstring fontName = reader.ReadString();
+		uint32 fontSize = reader.Read<uint32>();
+		tstring text = reader.ReadString();
+		Color color = reader.Read<Color>();
+		int32 wrapWidth = reader.Read<int32>();
+		int32 verticalSpacing = reader.Read<int32>();
+		bool isHud = reader.Read<bool>();
+		uint8 alignment = reader.Read<uint8>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+
+		if(m_Font == nullptr || fontName != m_FontName)
+		{
+			if(!FontManager::GetInstance()->LoadFont(fontPath, fontName, fontSize))
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("TextComponent::Deserialize: Could not load Font '")
+					+ fontPath + _T("'."), STARENGINE_LOG_TAG);
+				return;
+			}
+			m_FileName = fontPath;
+			m_FontName = fontName;
+			m_FontSize = fontSize;
+			m_Font = FontManager::GetInstance()->GetFont(fontName);
+		}
+
+		m_TextInfo->verticalSpacing = verticalSpacing;
+		m_TextInfo->bIsHud = isHud;
+		m_TextAlignment = HorizontalAlignment(alignment);
+		m_WrapWidth = wrapWidth;
+		SetColor(color);
+		SetText(text);
+	}
+
+	uint32 TextComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<TextComponent>();
+	}
 }
@@ -3,6 +3,7 @@
 #include "../BaseComponent.h"
 #include "../../defines.h"
 #include "../../Graphics/Color.h"
+#include "../../Helpers/MemoryPool.h"
 #include <vector>
 
 namespace star
@@ -24,6 +25,17 @@ namespace star
 			, text()
 			, textHeight()
 		{}
+
+		static void * operator new(size_t size)
+		{
+			return MemoryPool::Allocate(size);
+		}
+
+		static void operator delete(void * pMemory, size_t size)
+		{
+			MemoryPool::Deallocate(pMemory, size);
+		}
+
 		const Font* font;
 		TransformComponent* transformPtr;
 		Color colorMultiplier; 
@@ -161,7 +173,23 @@ namespace star
 		/// Aligns the text right.
 		/// </summary>
 		void AlignTextRight();
+
+		/// <summary>
+		/// Writes the font, text, color, wrapping, spacing, alignment
+		/// and HUD state to a scene snapshot.
+		/// </summary>
+		/// <param name="writer">The snapshot writer.</param>
+		virtual void Serialize(SnapshotWriter & writer) const;
+
+		/// <summary>
+		/// Restores the state written by <see cref="Serialize"/>,
+		/// loading the font first if it isn't loaded yet.
+		/// </summary>
+		/// <param name="reader">The snapshot reader.</param>
+		virtual void Deserialize(SnapshotReader & reader);
 		
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		enum class HorizontalAlignment : byte
 		{
@@ -215,12 +243,21 @@ namespace star
 		virtual void FillTextInfo();
 	
 	private:
+		friend class SceneSnapshot;
+
+		/// <summary>
+		/// Creates a text component without a font, for a scene snapshot
+		/// to restore. <see cref="Deserialize"/> sets the font.
+		/// </summary>
+		TextComponent();
+
 		uint32	m_FontSize,
 				m_StringLength;
 
 		int32 m_WrapWidth;
 
 		tstring m_FileName,
+				m_FontName,
 				m_OrigText,
 				m_EditText;
 
@@ -7,6 +7,7 @@
 #include "../../Scenes/SceneManager.h"
 #include "../../Scenes/BaseScene.h"
 #include "../../Physics/Collision/CollisionManager.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -18,8 +19,6 @@ namespace star
 		, m_bIsStatic(false)
 		, m_bCanDraw(false)
 		, m_DrawColor()
-		, m_bEntered(false)
-		, m_bExited(true)
 		, m_OnEnter(nullptr)
 		, m_OnStay(nullptr)
 		, m_OnExit(nullptr)
@@ -29,6 +28,7 @@ namespace star
 		m_Layers.elements[0] = DEFAULT_LAYER_NAME;
 
 		SetVisible(false);
+		SetTickEnabled(false);
 	}
 
 	BaseColliderComponent::BaseColliderComponent(
@@ -39,8 +39,6 @@ namespace star
 		, m_bIsStatic(false)
 		, m_bCanDraw(false)
 		, m_DrawColor()
-		, m_bEntered(false)
-		, m_bExited(true)
 		, m_OnEnter(nullptr)
 		, m_OnStay(nullptr)
 		, m_OnExit(nullptr)
@@ -53,12 +51,17 @@ namespace star
 		}
 
 		SetVisible(false);
+		SetTickEnabled(false);
 	}
 
 	BaseColliderComponent::~BaseColliderComponent()
 	{
-		GetParent()->GetScene()->
-			GetCollisionManager()->RemoveComponent(this);
+		//Colliders of prefab templates never had a scene.
+		if(GetParent() && GetParent()->GetScene())
+		{
+			GetParent()->GetScene()->
+				GetCollisionManager()->RemoveComponent(this);
+		}
 		delete[] m_Layers.elements;
 	}
 
@@ -138,7 +141,16 @@ namespace star
 
 	void BaseColliderComponent::SetAsStatic(bool isStatic)
 	{
+		if(m_bIsStatic == isStatic)
+		{
+			return;
+		}
 		m_bIsStatic = isStatic;
+		if(GetParent() && GetParent()->GetScene())
+		{
+			GetParent()->GetScene()->
+				GetCollisionManager()->UpdateStaticState(this);
+		}
 	}
 
 	bool BaseColliderComponent::IsStatic() const
@@ -146,26 +158,6 @@ namespace star
 		return m_bIsStatic;
 	}
 
-	void BaseColliderComponent::SetEntered(bool hasEntered)
-	{
-		m_bEntered = hasEntered;
-	}
-
-	bool BaseColliderComponent::GetEntered() const
-	{
-		return m_bEntered;
-	}
-
-	void BaseColliderComponent::SetExited(bool hasLeft)
-	{
-		m_bExited = hasLeft;
-	}
-
-	bool BaseColliderComponent::GetExited() const
-	{
-		return m_bExited;
-	}
-
 	void BaseColliderComponent::SetDrawColor(const Color& color)
 	{
 		m_DrawColor = color;
@@ -246,4 +238,58 @@ namespace star
 		pos += u1 * distance;
 		return pos;
 	}
+
+	void BaseColliderComponent::Serialize(SnapshotWriter & writer) const
+	{
+		writer.Write<uint8>(m_Layers.amount);
+		for(uint8 i = 0 ; i < m_Layers.amount ; ++i)
+		{
+			writer.WriteString(m_Layers.elements[i]);
+		}
+		writer.Write<bool>(m_bIsTrigger);
+		writer.Write<bool>(m_bIsStatic);
+		writer.Write<bool>(m_bCanDraw);
+		writer.Write<Color>(m_DrawColor);
+	}
+
+	void BaseColliderComponent::Deserialize(SnapshotReader & reader)
+	{
+		uint8 layerCount = reader.Read<uint8>();
+		std::vector<tstring> layers;
+		for(uint8 i = 0 ; i < layerCount && reader.IsValid() ; ++i)
+		{
+			layers.push_back(reader.ReadString());
+		}
+		bool isTrigger = reader.Read<bool>();
+		bool isStatic = reader.Read<bool>();
+		bool canDraw = reader.Read<bool>();
+		Color drawColor = reader.Read<Color>();
+		if(!reader.IsValid() || layers.empty())
+		{
+			return;
+		}
+
+		//Initialized colliders are registered in their layers already.
+		if(!m_bInitialized)
+		{
+			delete[] m_Layers.elements;
+			m_Layers.amount = layerCount;
+			m_Layers.elements = new tstring[layerCount];
+			for(uint8 i = 0 ; i < layerCount ; ++i)
+			{
+				m_Layers.elements[i] = layers[i];
+			}
+		}
+		else
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("BaseColliderComponent::Deserialize: The layers of an initialized collider are kept."),
+				STARENGINE_LOG_TAG);
+		}
+
+		SetAsTrigger(isTrigger);
+		SetAsStatic(isStatic);
+		EnableDrawing(canDraw);
+		SetDrawColor(drawColor);
+	}
 }
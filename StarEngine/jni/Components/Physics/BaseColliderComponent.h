@@ -8,6 +8,7 @@
 namespace star
 {
 	struct Context;
+	struct AABB;
 	class CircleColliderComponent;
 	class RectangleColliderComponent;
 
@@ -35,15 +36,11 @@ namespace star
 		void SetAsTrigger(bool isTrigger);
 		bool IsTrigger() const;
 
+		//Static colliders are never tested against each other.
+		//Moving one afterwards needs CollisionManager::RebuildStaticColliders.
 		void SetAsStatic(bool isStatic);
 		bool IsStatic() const;
 
-		void SetEntered(bool hasEntered);
-		bool GetEntered() const;
-
-		void SetExited(bool hasLeft);
-		bool GetExited() const;
-
 		void SetDrawColor(const Color& color);
 		const Color& GetDrawColor() const;
 
@@ -57,6 +54,14 @@ namespace star
 			const vec2& point2
 			) const = 0;
 		virtual bool CollidesWith(const BaseColliderComponent* other) const = 0;
+		//Axis aligned bounds in the space CollidesWith tests in,
+		//used by the broadphase of the CollisionManager.
+		virtual void GetBounds(AABB & bounds) const = 0;
+
+		//Scene snapshot hooks. The callbacks aren't stored,
+		//they have to be set again on a restored collider.
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
 
 	protected:
 		virtual void InitializeColliderComponent() = 0;
@@ -79,9 +84,6 @@ namespace star
 		static const tstring DEFAULT_LAYER_NAME;
 
 	private:
-		bool m_bEntered;
-		bool m_bExited;
-
 		Callback m_OnEnter;
 		Callback m_OnStay;
 		Callback m_OnExit;
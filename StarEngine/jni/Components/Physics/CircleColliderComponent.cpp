@@ -7,6 +7,8 @@
 #include "../../Scenes/SceneManager.h"
 #include "../../Scenes/BaseScene.h"
 #include "../../Physics/Collision/CollisionManager.h"
+#include "../../Physics/Collision/AABB.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -228,6 +230,14 @@ The collierComponent to check is a nullptr"), STARENGINE_LOG_TAG);
 		return !(abs(Mag((object1Pos - object2Pos))) > (radius1 + radius2));
 	}
 
+	void CircleColliderComponent::GetBounds(AABB & bounds) const
+	{
+		vec2 position(GetPosition());
+		float32 radius(GetRealRadius());
+		bounds.Min = position - vec2(radius, radius);
+		bounds.Max = position + vec2(radius, radius);
+	}
+
 	float32 CircleColliderComponent::GetRadius() const
 	{
 		return m_Radius;
@@ -283,4 +293,35 @@ The collierComponent to check is a nullptr"), STARENGINE_LOG_TAG);
 				, GetRealRadius(), m_DrawColor, m_DrawSegments);
 		}		
 	}
+
+	void CircleColliderComponent::Serialize(SnapshotWriter & writer) const
+	{
+		BaseColliderComponent::Serialize(writer);
+		writer.Write<float32>(m_Radius);
+		writer.Write<vec2>(m_Offset);
+		writer.Write<bool>(m_bDefaultInitialized);
+		writer.Write<uint32>(m_DrawSegments);
+	}
+
+	void CircleColliderComponent::Deserialize(SnapshotReader & reader)
+	{
+		BaseColliderComponent::Deserialize(reader);
+		float32 radius = reader.Read<float32>();
+		vec2 offset = reader.Read<vec2>();
+		bool defaultInitialized = reader.Read<bool>();
+		uint32 drawSegments = reader.Read<uint32>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_Radius = radius;
+		m_Offset = offset;
+		m_bDefaultInitialized = defaultInitialized;
+		m_DrawSegments = drawSegments;
+	}
+
+	uint32 CircleColliderComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<CircleColliderComponent>();
+	}
 }
@@ -35,6 +35,7 @@ namespace star
 			const vec2& point2
 			) const;
 		bool CollidesWith(const BaseColliderComponent* other) const;
+		void GetBounds(AABB & bounds) const;
 
 		void SetRadius(float32 radius);
 		float32 GetRadius() const;
@@ -46,6 +47,11 @@ namespace star
 		void SetDrawSegments(uint32 segments);
 		uint32 GetDrawSegments() const;
 
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		void InitializeColliderComponent();
 		void Draw();
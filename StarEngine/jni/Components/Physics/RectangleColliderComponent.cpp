@@ -10,6 +10,8 @@
 #include "../../Scenes/SceneManager.h"
 #include "../../Scenes/BaseScene.h"
 #include "../../Physics/Collision/CollisionManager.h"
+#include "../../Physics/Collision/AABB.h"
+#include "../../Scenes/SceneSnapshot.h"
 
 namespace star
 {
@@ -532,6 +534,15 @@ The collierComponent to check is a nullptr"), STARENGINE_LOG_TAG);
 		CreateDimensions();
 	}
 
+	void RectangleColliderComponent::GetBounds(AABB & bounds) const
+	{
+		Rect rect(GetCollisionRect());
+		bounds.Min.x = rect.GetRealLeft();
+		bounds.Min.y = rect.GetRealBottom();
+		bounds.Max.x = rect.GetRealRight();
+		bounds.Max.y = rect.GetRealTop();
+	}
+
 	Rect RectangleColliderComponent::GetCollisionRect() const
 	{
 		Rect temp((m_CollisionRect * GetTransform()->GetWorldMatrix()) 
@@ -578,4 +589,30 @@ The collierComponent to check is a nullptr"), STARENGINE_LOG_TAG);
 			DebugDraw::GetInstance()->DrawSolidRect(GetCollisionRect(), m_DrawColor);
 		}
 	}
+
+	void RectangleColliderComponent::Serialize(SnapshotWriter & writer) const
+	{
+		BaseColliderComponent::Serialize(writer);
+		writer.Write<vec2>(m_CustomColliderSize);
+	}
+
+	void RectangleColliderComponent::Deserialize(SnapshotReader & reader)
+	{
+		BaseColliderComponent::Deserialize(reader);
+		vec2 size = reader.Read<vec2>();
+		if(!reader.IsValid())
+		{
+			return;
+		}
+		m_CustomColliderSize = size;
+		if(m_bInitialized)
+		{
+			CreateDimensions();
+		}
+	}
+
+	uint32 RectangleColliderComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<RectangleColliderComponent>();
+	}
 }
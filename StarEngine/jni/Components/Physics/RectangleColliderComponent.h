@@ -39,6 +39,7 @@ namespace star
 			const vec2& point2
 			) const;
 		bool CollidesWith(const BaseColliderComponent* other) const;
+		void GetBounds(AABB & bounds) const;
 
 		Rect GetCollisionRect() const;
 		vec2 GetCenterPoint() const;
@@ -54,6 +55,11 @@ namespace star
 			float32 height);
 		void SetCollisionRectSize(const vec2& size);
 
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		void InitializeColliderComponent();
 		void Draw();
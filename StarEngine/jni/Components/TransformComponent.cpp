@@ -1,34 +1,36 @@
 #include "TransformComponent.h"
+#include "TransformStore.h"
 #include "..\Objects\Object.h"
 #include "..\Logger.h"
 #include "..\Context.h"
 #include "..\Helpers\Math.h"
-#include "..\Graphics\GraphicsManager.h"
 
 namespace star
 {
+#ifdef STAR2D
+	TransformComponent::TransformComponent(star::Object* parent):
+		m_pStore(TransformStore::GetInstance()),
+		m_Handle(TransformStore::INVALID_HANDLE)
+	{
+		m_pParentObject = parent;
+		m_Handle = m_pStore->Create(parent);
+		SetTickEnabled(false);
+	}
+
+	TransformComponent::~TransformComponent(void)
+	{
+		m_pStore->Destroy(m_Handle);
+	}
+#else
 	TransformComponent::TransformComponent(star::Object* parent):
 		m_IsChanged(TransformChanged::ALL),
 		m_Invalidate(false),
-	#ifdef STAR2D
-		m_WorldPosition(0,0),
-		m_LocalPosition(0,0),
-	#else
 		m_WorldPosition(0,0,0),
 		m_LocalPosition(0,0,0),
-	#endif
 		m_WorldRotation(0),
 		m_LocalRotation(0),
-	#ifdef STAR2D
-		m_WorldScale(1,1),
-		m_LocalScale(1,1),
-		m_CenterPosition(0,0),
-		m_IsMirroredX(false),
-		m_IsMirroredY(false),
-	#else
 		m_WorldScale(1,1,1),
 		m_LocalScale(1,1,1),
-	#endif
 		m_World()
 	{
 		m_pParentObject = parent;
@@ -37,13 +39,15 @@ namespace star
 	TransformComponent::~TransformComponent(void)
 	{
 	}
+#endif
 
 #ifdef STAR2D
 	void TransformComponent::Translate(const vec2 & translation)
 	{
-		m_LocalPosition.x = translation.x;
-		m_LocalPosition.y = translation.y;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		pos position = m_pStore->GetLocalPosition(m_Handle);
+		position.x = translation.x;
+		position.y = translation.y;
+		m_pStore->SetLocalPosition(m_Handle, position);
 	}
 
 	void TransformComponent::Translate(float32 x, float32 y)
@@ -53,10 +57,10 @@ namespace star
 
 	void TransformComponent::Translate(const vec2 & translation, lay l)
 	{
-		m_LocalPosition.x = translation.x;
-		m_LocalPosition.y = translation.y;
-		m_LocalPosition.l = l;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		m_pStore->SetLocalPosition(
+			m_Handle,
+			pos(translation, l)
+			);
 	}
 
 	void TransformComponent::Translate(float32 x, float32 y, lay l)
@@ -66,71 +70,67 @@ namespace star
 
 	void TransformComponent::Translate(const pos & pos2D)
 	{
-		m_LocalPosition = pos2D;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		m_pStore->SetLocalPosition(m_Handle, pos2D);
 	}
 
 	void TransformComponent::TranslateX(float32 x)
 	{
-		m_LocalPosition.x = x;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		pos position = m_pStore->GetLocalPosition(m_Handle);
+		position.x = x;
+		m_pStore->SetLocalPosition(m_Handle, position);
 	}
 
 	void TransformComponent::TranslateY(float32 y)
 	{
-		m_LocalPosition.y = y;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		pos position = m_pStore->GetLocalPosition(m_Handle);
+		position.y = y;
+		m_pStore->SetLocalPosition(m_Handle, position);
 	}
 
 	void TransformComponent::TranslateL(lay l)
 	{
-		m_LocalPosition.l = l;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		pos position = m_pStore->GetLocalPosition(m_Handle);
+		position.l = l;
+		m_pStore->SetLocalPosition(m_Handle, position);
 	}
 
 	void TransformComponent::Move(const vec2& translation)
 	{
-		m_LocalPosition.x += translation.x;
-		m_LocalPosition.y += translation.y;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		Move(translation.x, translation.y);
 	}
 
 	void TransformComponent::Move(float32 x, float32 y)
 	{
-		m_LocalPosition.x += x;
-		m_LocalPosition.y += y;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		pos position = m_pStore->GetLocalPosition(m_Handle);
+		position.x += x;
+		position.y += y;
+		m_pStore->SetLocalPosition(m_Handle, position);
 	}
 
 	void TransformComponent::MoveX(float32 x)
 	{
-		m_LocalPosition.x += x;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		Move(x, 0);
 	}
 
 	void TransformComponent::MoveY(float32 y)
 	{
-		m_LocalPosition.y += y;
-		m_IsChanged |= TransformChanged::TRANSLATION;
+		Move(0, y);
 	}
 
 	void TransformComponent::Rotate(float32 rotation)
 	{
-		m_LocalRotation = rotation;
-		m_IsChanged |= TransformChanged::ROTATION;
+		m_pStore->SetLocalRotation(m_Handle, rotation);
 	}
 
 	void TransformComponent::Rotate(float32 rotation, const vec2& centerPoint)
 	{
-		m_LocalRotation = rotation;
+		m_pStore->SetLocalRotation(m_Handle, rotation);
 		SetCenterPoint(centerPoint);
-		m_IsChanged |= TransformChanged::ROTATION;
 	}
 
 	void TransformComponent::Scale(const vec2 & scale)
 	{
-		m_LocalScale = scale;
-		m_IsChanged |= TransformChanged::SCALE;
+		m_pStore->SetLocalScale(m_Handle, scale);
 	}
 
 	void TransformComponent::Scale(float32 x, float32 y)
@@ -145,102 +145,135 @@ namespace star
 
 	void TransformComponent::ScaleX(float32 x)
 	{
-		m_LocalScale.x = x;
-		m_IsChanged |= TransformChanged::SCALE;
+		vec2 scale = m_pStore->GetLocalScale(m_Handle);
+		scale.x = x;
+		m_pStore->SetLocalScale(m_Handle, scale);
 	}
 
 	void TransformComponent::ScaleY(float32 y)
 	{
-		m_LocalScale.y = y;
-		m_IsChanged |= TransformChanged::SCALE;
+		vec2 scale = m_pStore->GetLocalScale(m_Handle);
+		scale.y = y;
+		m_pStore->SetLocalScale(m_Handle, scale);
 	}
 
 	void TransformComponent::Mirror(bool x, bool y)
 	{
-		m_IsMirroredX = x;
-		m_IsMirroredY = y;
+		m_pStore->SetMirrored(m_Handle, x, y);
 	}
 
 	void TransformComponent::MirrorX(bool x)
 	{
-		m_IsMirroredX = x;
+		m_pStore->SetMirrored(m_Handle, x, m_pStore->IsMirroredY(m_Handle));
 	}
 
 	void TransformComponent::MirrorY(bool y)
 	{
-		m_IsMirroredY = y;
+		m_pStore->SetMirrored(m_Handle, m_pStore->IsMirroredX(m_Handle), y);
 	}
 
-	const pos & TransformComponent::GetWorldPosition()
+	bool TransformComponent::IsMirroredX() const
 	{
-		return m_WorldPosition;
+		return m_pStore->IsMirroredX(m_Handle);
 	}
 
-	const pos & TransformComponent::GetLocalPosition()
+	bool TransformComponent::IsMirroredY() const
 	{
-		return m_LocalPosition;
+		return m_pStore->IsMirroredY(m_Handle);
+	}
+
+	pos TransformComponent::GetWorldPosition()
+	{
+		return m_pStore->GetWorldPosition(m_Handle);
+	}
+
+	pos TransformComponent::GetLocalPosition()
+	{
+		return m_pStore->GetLocalPosition(m_Handle);
 	}
 
 	float32 TransformComponent::GetWorldRotation()
 	{
-		return m_WorldRotation;
+		return m_pStore->GetWorldRotation(m_Handle);
 	}
 
 	float32 TransformComponent::GetLocalRotation() const
 	{
-		return m_LocalRotation;
+		return m_pStore->GetLocalRotation(m_Handle);
 	}
 
-	const vec2 & TransformComponent::GetWorldScale()
+	pos TransformComponent::GetRenderPosition() const
 	{
-		return m_WorldScale;
+		return m_pStore->GetRenderPosition(m_Handle);
 	}
 
-	const vec2 & TransformComponent::GetLocalScale()
+	float32 TransformComponent::GetRenderRotation() const
 	{
-		return m_LocalScale;
+		return m_pStore->GetRenderRotation(m_Handle);
+	}
+
+	vec2 TransformComponent::GetWorldScale()
+	{
+		return m_pStore->GetWorldScale(m_Handle);
+	}
+
+	vec2 TransformComponent::GetLocalScale()
+	{
+		return m_pStore->GetLocalScale(m_Handle);
 	}
 
 	void TransformComponent::SetCenterPoint(const vec2 & centerPoint)
 	{
-		m_CenterPosition = centerPoint;
+		m_pStore->SetCenterPoint(m_Handle, centerPoint);
 	}
 
 	void TransformComponent::SetCenterPoint(float32 x, float32 y)
 	{
-		m_CenterPosition.x = x;
-		m_CenterPosition.y = y;
+		SetCenterPoint(vec2(x, y));
 	}
 
 	void TransformComponent::SetCenterX(float32 x)
 	{
-		m_CenterPosition.x = x;
+		vec2 center = m_pStore->GetCenterPoint(m_Handle);
+		center.x = x;
+		m_pStore->SetCenterPoint(m_Handle, center);
 	}
 
 	void TransformComponent::SetCenterY(float32 y)
 	{
-		m_CenterPosition.y = y;
+		vec2 center = m_pStore->GetCenterPoint(m_Handle);
+		center.y = y;
+		m_pStore->SetCenterPoint(m_Handle, center);
+	}
+
+	vec2 TransformComponent::GetCenterPoint() const
+	{
+		return m_pStore->GetCenterPoint(m_Handle);
 	}
 
 	void TransformComponent::SetDimensions(int32 x, int32 y)
 	{
 		m_Dimensions.x = x;
 		m_Dimensions.y = y;
+		m_pStore->SetDimensions(m_Handle, m_Dimensions);
 	}
 
 	void TransformComponent::SetDimensions(const ivec2 & dimensions)
 	{
 		m_Dimensions = dimensions;
+		m_pStore->SetDimensions(m_Handle, m_Dimensions);
 	}
 
 	void TransformComponent::SetDimensionsX(int32 x)
 	{
 		m_Dimensions.x = x;
+		m_pStore->SetDimensions(m_Handle, m_Dimensions);
 	}
 
 	void TransformComponent::SetDimensionsY(int32 y)
 	{
 		m_Dimensions.y = y;
+		m_pStore->SetDimensions(m_Handle, m_Dimensions);
 	}
 
 	void TransformComponent::SetDimensionsSafe(int32 x, int32 y)
@@ -258,7 +291,7 @@ namespace star
 	{
 		if(x > m_Dimensions.x)
 		{
-			m_Dimensions.x = x;
+			SetDimensionsX(x);
 		}
 		else if(x < m_Dimensions.x)
 		{
@@ -270,7 +303,7 @@ namespace star
 	{
 		if(y > m_Dimensions.y)
 		{
-			m_Dimensions.y = y;
+			SetDimensionsY(y);
 		}
 		else if(y < m_Dimensions.y)
 		{
@@ -278,6 +311,62 @@ namespace star
 		}
 	}
 
+	mat4 TransformComponent::GetWorldMatrix() const
+	{
+		return m_pStore->GetWorldMatrix(m_Handle);
+	}
+
+	mat4 TransformComponent::GetRenderMatrix() const
+	{
+		return m_pStore->GetRenderMatrix(m_Handle);
+	}
+
+	mat3x2 TransformComponent::GetWorldAffine() const
+	{
+		return m_pStore->GetWorldAffine(m_Handle);
+	}
+
+	void TransformComponent::Update(const Context& context)
+	{
+		//World data is resolved for all transforms at once by the TransformStore.
+	}
+
+	void TransformComponent::IsChanged(bool isChanged)
+	{
+		m_pStore->SetDirty(m_Handle, isChanged);
+	}
+
+	void TransformComponent::OnParentChanged()
+	{
+		Object * parent = m_pParentObject->GetParent();
+		uint32 parentHandle(TransformStore::INVALID_HANDLE);
+		if(parent != nullptr)
+		{
+			TransformComponent * parentTransform = parent->GetTransform();
+			ASSERT(parentTransform->m_pStore == m_pStore,
+				_T("TransformComponent::OnParentChanged: \
+The parent is part of another scene."));
+			parentHandle = parentTransform->m_Handle;
+		}
+		m_pStore->SetParent(m_Handle, parentHandle);
+	}
+
+	void TransformComponent::SetStore(TransformStore * pStore)
+	{
+		if(pStore == m_pStore)
+		{
+			return;
+		}
+		m_Handle = m_pStore->Transfer(m_Handle, *pStore);
+		m_pStore = pStore;
+		//The parent moves before its children, so it is found in the new store.
+		OnParentChanged();
+	}
+
+	void TransformComponent::InitializeComponent()
+	{
+		m_pStore->Resolve(m_Handle);
+	}
 #else
 	void TransformComponent::Translate(const vec3 & translation)
 	{
@@ -469,17 +558,19 @@ namespace star
 	{
 		return m_LocalScale;
 	}
-#endif
+	mat4 TransformComponent::GetWorldMatrix() const
+	{
+		return m_World;
+	}
 
-	const mat4 & TransformComponent::GetWorldMatrix() const
+	mat4 TransformComponent::GetRenderMatrix() const
 	{
 		return m_World;
 	}
 
 	void TransformComponent::CheckForUpdate(bool force)
 	{
-		if(m_IsChanged == TransformChanged::NONE && !force && !m_Invalidate
-			&& !GraphicsManager::GetInstance()->GetHasWindowChanged())
+		if(m_IsChanged == TransformChanged::NONE && !force && !m_Invalidate)
 		{
 			return;
 		}
@@ -490,12 +581,12 @@ namespace star
 
 		m_Invalidate = false;
 	}
-		
+
 	void TransformComponent::CommonUpdate()
 	{
 		for(auto child : GetParent()->GetChildren())
 		{
-			child->GetTransform()->IsChanged(true);
+			child->GetTransform()->m_Invalidate = true;
 		}
 
 		SingleUpdate(m_World);
@@ -507,18 +598,8 @@ namespace star
 		}
 
 		DecomposeMatrix(m_World, m_WorldPosition, m_WorldScale, m_WorldRotation);
-
-		if(m_IsMirroredX)
-		{
-			m_WorldPosition.x -= m_Dimensions.x;
-		}
-
-		if(m_IsMirroredY)
-		{
-			m_WorldPosition.y -= m_Dimensions.y;
-		}
 	}
-		
+
 	void TransformComponent::SingleUpdate(mat4 & world)
 	{
 		mat4 matRot, matTrans, matScale, matC, matCI;
@@ -563,25 +644,35 @@ namespace star
 				);
 		}
 	}
-
 	void TransformComponent::Update(const Context& context)
 	{
 		CheckForUpdate();
 	}
-		
-	void TransformComponent::Draw()
-	{
-
-	}
 
 	void TransformComponent::IsChanged(bool isChanged)
 	{
 		m_IsChanged = isChanged;
 	}
 
+	void TransformComponent::OnParentChanged()
+	{
+		m_Invalidate = true;
+	}
+
 	void TransformComponent::InitializeComponent()
 	{
 		CheckForUpdate(true);
 		m_Invalidate = true;
 	}
-}
\ No newline at end of file
+#endif
+
+	void TransformComponent::Draw()
+	{
+
+	}
+
+	uint32 TransformComponent::GetTypeID() const
+	{
+		return ComponentType::GetID<TransformComponent>();
+	}
+}
@@ -7,6 +7,7 @@ namespace star
 {
 	struct Context;
 	class Object;
+	class TransformStore;
 
 	class TransformComponent final: public BaseComponent
 	{
@@ -26,6 +27,7 @@ namespace star
 		void Update(const Context& context);
 		void Draw();
 		void IsChanged(bool isChanged);
+		void OnParentChanged();
 #ifdef STAR2D
 		void Translate(const vec2& translation);
 		void Translate(float32 x, float32 y);
@@ -53,18 +55,25 @@ namespace star
 		void Mirror(bool x, bool y);
 		void MirrorX(bool x);
 		void MirrorY(bool y);
+		bool IsMirroredX() const;
+		bool IsMirroredY() const;
 				
-		const pos& GetWorldPosition();
-		const pos& GetLocalPosition();
+		pos GetWorldPosition();
+		pos GetLocalPosition();
 		float32 GetWorldRotation();
 		float32 GetLocalRotation() const;
-		const vec2& GetWorldScale();
-		const vec2& GetLocalScale();
+		vec2 GetWorldScale();
+		vec2 GetLocalScale();
+
+		//Interpolated between the last two fixed steps while drawing.
+		pos GetRenderPosition() const;
+		float32 GetRenderRotation() const;
 
 		void SetCenterPoint(const vec2 & centerPoint);
 		void SetCenterPoint(float32 x, float32 y);
 		void SetCenterX(float32 x);
 		void SetCenterY(float32 y);
+		vec2 GetCenterPoint() const;
 
 		void SetDimensions(int32 x, int32 y);
 		void SetDimensions(const ivec2 & dimensions);
@@ -75,6 +84,10 @@ namespace star
 		void SetDimensionsSafe(const ivec2 & dimensions);
 		void SetDimensionsXSafe(int32 x);
 		void SetDimensionsYSafe(int32 y);
+
+		//Moves the transform into the store of the scene
+		//its object was added to, called by the object.
+		void SetStore(TransformStore * pStore);
 #else
 		void Translate(const vec3& translation);
 		void Translate(float32 x, float32 y, float32 z);
@@ -113,10 +126,22 @@ namespace star
 		const vec3& GetWorldScale();
 		const vec3& GetLocalScale();
 #endif
-		const mat4 & GetWorldMatrix() const;
+		mat4 GetWorldMatrix() const;
+		mat4 GetRenderMatrix() const;
+#ifdef STAR2D
+		mat3x2 GetWorldAffine() const;
+#endif
+
+		virtual uint32 GetTypeID() const;
 
 	private:
 		void InitializeComponent();
+
+#ifdef STAR2D
+		//The transform data itself lives in the TransformStore.
+		TransformStore * m_pStore;
+		uint32 m_Handle;
+#else
 		void CheckForUpdate(const bool force = false);
 		void CommonUpdate();
 		void SingleUpdate(mat4 & world);
@@ -124,22 +149,12 @@ namespace star
 		suchar m_IsChanged;
 		bool m_Invalidate;
 
-#ifdef STAR2D
-		pos m_WorldPosition, m_LocalPosition;
-		float32 m_WorldRotation, m_LocalRotation;
-		vec2 
-			m_WorldScale,
-			m_LocalScale,
-			m_CenterPosition;
-		bool m_IsMirroredX;
-		bool m_IsMirroredY;
-#else
 		vec3 m_WorldPosition, m_LocalPosition;
 		quat m_WorldRotation, m_LocalRotation;
 		vec3 m_WorldScale, m_LocalScale;
 		// [TODO] add 3D mirroring!
-#endif
 		mat4 m_World;
+#endif
 
 		TransformComponent(const TransformComponent& yRef);
 		TransformComponent(TransformComponent&& yRef);
@@ -0,0 +1,648 @@
+#include "TransformStore.h"
+#include "../Objects/Object.h"
+#include "../Helpers/Math.h"
+#include <cmath>
+
+#ifdef STAR2D
+
+namespace star
+{
+	TransformStore * TransformStore::m_pTransformStore = nullptr;
+
+	TransformStore::TransformStore()
+		: m_SlotOfHandle()
+		, m_FreeHandles()
+		, m_Handles()
+		, m_Flags()
+		, m_Parents()
+		, m_Owners()
+		, m_LocalPositions()
+		, m_LocalRotations()
+		, m_LocalScales()
+		, m_CenterPoints()
+		, m_Dimensions()
+		, m_Mirrors()
+		, m_WorldAffines()
+		, m_WorldMatrices()
+		, m_WorldPositions()
+		, m_WorldRotations()
+		, m_WorldScales()
+		, m_PreviousAffines()
+		, m_PreviousPositions()
+		, m_PreviousRotations()
+		, m_RenderMatrices()
+		, m_RenderPositions()
+		, m_RenderRotations()
+		, m_DeadCount(0)
+		, m_bNeedsRebuild(false)
+		, m_bHasRenderState(false)
+	{
+	}
+
+	TransformStore::~TransformStore()
+	{
+		if(m_pTransformStore == this)
+		{
+			m_pTransformStore = nullptr;
+		}
+	}
+
+	TransformStore * TransformStore::GetInstance()
+	{
+		if(m_pTransformStore == nullptr)
+		{
+			m_pTransformStore = new TransformStore();
+		}
+		return m_pTransformStore;
+	}
+
+	uint32 TransformStore::Create(Object * pOwner)
+	{
+		uint32 handle;
+		if(m_FreeHandles.empty())
+		{
+			handle = uint32(m_SlotOfHandle.size());
+			m_SlotOfHandle.push_back(INVALID_HANDLE);
+		}
+		else
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+
+		//New transforms have no parent yet, so appending keeps the order valid.
+		m_SlotOfHandle[handle] = uint32(m_Flags.size());
+
+		m_Handles.push_back(handle);
+		m_Flags.push_back(ALIVE | INVALID);
+		m_Parents.push_back(INVALID_HANDLE);
+		m_Owners.push_back(pOwner);
+		m_LocalPositions.push_back(pos());
+		m_LocalRotations.push_back(0);
+		m_LocalScales.push_back(vec2(1, 1));
+		m_CenterPoints.push_back(vec2(0, 0));
+		m_Dimensions.push_back(ivec2(0, 0));
+		m_Mirrors.push_back(0);
+		m_WorldAffines.push_back(mat3x2());
+		m_WorldMatrices.push_back(mat4());
+		m_WorldPositions.push_back(pos());
+		m_WorldRotations.push_back(0);
+		m_WorldScales.push_back(vec2(1, 1));
+		m_PreviousAffines.push_back(mat3x2());
+		m_PreviousPositions.push_back(pos());
+		m_PreviousRotations.push_back(0);
+		m_RenderMatrices.push_back(mat4());
+		m_RenderPositions.push_back(pos());
+		m_RenderRotations.push_back(0);
+		return handle;
+	}
+
+	void TransformStore::Destroy(uint32 handle)
+	{
+		if(handle >= m_SlotOfHandle.size()
+			|| m_SlotOfHandle[handle] == INVALID_HANDLE)
+		{
+			return;
+		}
+
+		//The slot is only reclaimed when the store gets rebuilt.
+		uint32 slot = m_SlotOfHandle[handle];
+		m_Flags[slot] = 0;
+		m_Handles[slot] = INVALID_HANDLE;
+		m_Owners[slot] = nullptr;
+		m_SlotOfHandle[handle] = INVALID_HANDLE;
+		m_FreeHandles.push_back(handle);
+
+		++m_DeadCount;
+		if(m_DeadCount >= MIN_DEAD_FOR_REBUILD
+			&& m_DeadCount * 4 >= m_Flags.size())
+		{
+			m_bNeedsRebuild = true;
+		}
+	}
+
+	void TransformStore::SetParent(uint32 handle, uint32 parentHandle)
+	{
+		uint32 slot = GetSlot(handle);
+		uint32 parentSlot = parentHandle == INVALID_HANDLE
+			? INVALID_HANDLE
+			: GetSlot(parentHandle);
+
+		m_Parents[slot] = parentSlot;
+		m_Flags[slot] |= INVALID;
+
+		//A parent created after its child breaks the parent-before-child order.
+		if(parentSlot != INVALID_HANDLE && parentSlot > slot)
+		{
+			m_bNeedsRebuild = true;
+		}
+	}
+
+	uint32 TransformStore::Transfer(uint32 handle, TransformStore & target)
+	{
+		uint32 slot = GetSlot(handle);
+		uint32 targetHandle = target.Create(m_Owners[slot]);
+		uint32 targetSlot = target.GetSlot(targetHandle);
+
+		target.m_LocalPositions[targetSlot] = m_LocalPositions[slot];
+		target.m_LocalRotations[targetSlot] = m_LocalRotations[slot];
+		target.m_LocalScales[targetSlot] = m_LocalScales[slot];
+		target.m_CenterPoints[targetSlot] = m_CenterPoints[slot];
+		target.m_Dimensions[targetSlot] = m_Dimensions[slot];
+		target.m_Mirrors[targetSlot] = m_Mirrors[slot];
+		target.m_Flags[targetSlot] |= m_Flags[slot] & DIRTY;
+		//Keeps the world data valid until the target resolves it.
+		target.ResolveSlot(targetSlot);
+
+		Destroy(handle);
+		return targetHandle;
+	}
+
+	void TransformStore::Update()
+	{
+		if(m_bNeedsRebuild)
+		{
+			Rebuild();
+		}
+
+		const uint32 count = uint32(m_Flags.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			uint8 flags = m_Flags[i];
+			if((flags & ALIVE) == 0)
+			{
+				continue;
+			}
+
+			//Slots are only reused after a rebuild, so a destroyed parent
+			//is still recognised here and its children become roots.
+			uint32 parent = m_Parents[i];
+			bool parentUpdated(false);
+			if(parent != INVALID_HANDLE)
+			{
+				if((m_Flags[parent] & ALIVE) == 0)
+				{
+					m_Parents[i] = INVALID_HANDLE;
+					parentUpdated = true;
+				}
+				else
+				{
+					parentUpdated = (m_Flags[parent] & UPDATED) != 0;
+				}
+			}
+
+			if((flags & (DIRTY | INVALID)) != 0 || parentUpdated)
+			{
+				//A cached layer redraws for its own members moving,
+				//not for the layer itself being moved.
+				if((flags & DIRTY) != 0)
+				{
+					m_Owners[i]->MarkCacheDirty();
+				}
+				ResolveSlot(i);
+				m_Flags[i] = (flags & ~(DIRTY | INVALID)) | UPDATED;
+			}
+			else
+			{
+				m_Flags[i] = flags & ~UPDATED;
+			}
+		}
+	}
+
+	void TransformStore::Resolve(uint32 handle)
+	{
+		//Resolves right away against the current world data of the parent.
+		//The transform stays invalid so the next pass picks up parent changes.
+		uint32 slot = GetSlot(handle);
+		ResolveSlot(slot);
+		m_Flags[slot] |= INVALID;
+	}
+
+	void TransformStore::SetDirty(uint32 handle, bool dirty)
+	{
+		uint32 slot = GetSlot(handle);
+		if(dirty)
+		{
+			m_Flags[slot] |= DIRTY;
+		}
+		else
+		{
+			m_Flags[slot] &= ~DIRTY;
+		}
+	}
+
+	void TransformStore::SetLocalPosition(uint32 handle, const pos & position)
+	{
+		uint32 slot = GetSlot(handle);
+		m_LocalPositions[slot] = position;
+		MarkDirty(slot);
+	}
+
+	void TransformStore::SetLocalRotation(uint32 handle, float32 rotation)
+	{
+		uint32 slot = GetSlot(handle);
+		m_LocalRotations[slot] = rotation;
+		MarkDirty(slot);
+	}
+
+	void TransformStore::SetLocalScale(uint32 handle, const vec2 & scale)
+	{
+		uint32 slot = GetSlot(handle);
+		m_LocalScales[slot] = scale;
+		MarkDirty(slot);
+	}
+
+	void TransformStore::SetCenterPoint(uint32 handle, const vec2 & centerPoint)
+	{
+		uint32 slot = GetSlot(handle);
+		if(m_CenterPoints[slot] != centerPoint)
+		{
+			m_CenterPoints[slot] = centerPoint;
+			MarkDirty(slot);
+		}
+	}
+
+	void TransformStore::SetDimensions(uint32 handle, const ivec2 & dimensions)
+	{
+		uint32 slot = GetSlot(handle);
+		if(m_Dimensions[slot] != dimensions)
+		{
+			m_Dimensions[slot] = dimensions;
+			//The dimensions are only part of the transform when mirrored.
+			if(m_Mirrors[slot] != 0)
+			{
+				MarkDirty(slot);
+			}
+		}
+	}
+
+	void TransformStore::SetMirrored(uint32 handle, bool x, bool y)
+	{
+		uint32 slot = GetSlot(handle);
+		uint8 mirrors = (x ? 1 : 0) | (y ? 2 : 0);
+		if(m_Mirrors[slot] != mirrors)
+		{
+			m_Mirrors[slot] = mirrors;
+			MarkDirty(slot);
+		}
+	}
+
+	pos TransformStore::GetLocalPosition(uint32 handle) const
+	{
+		return m_LocalPositions[GetSlot(handle)];
+	}
+
+	float32 TransformStore::GetLocalRotation(uint32 handle) const
+	{
+		return m_LocalRotations[GetSlot(handle)];
+	}
+
+	vec2 TransformStore::GetLocalScale(uint32 handle) const
+	{
+		return m_LocalScales[GetSlot(handle)];
+	}
+
+	vec2 TransformStore::GetCenterPoint(uint32 handle) const
+	{
+		return m_CenterPoints[GetSlot(handle)];
+	}
+
+	bool TransformStore::IsMirroredX(uint32 handle) const
+	{
+		return (m_Mirrors[GetSlot(handle)] & 1) != 0;
+	}
+
+	bool TransformStore::IsMirroredY(uint32 handle) const
+	{
+		return (m_Mirrors[GetSlot(handle)] & 2) != 0;
+	}
+
+	pos TransformStore::GetWorldPosition(uint32 handle) const
+	{
+		return m_WorldPositions[GetSlot(handle)];
+	}
+
+	float32 TransformStore::GetWorldRotation(uint32 handle) const
+	{
+		return m_WorldRotations[GetSlot(handle)];
+	}
+
+	vec2 TransformStore::GetWorldScale(uint32 handle) const
+	{
+		return m_WorldScales[GetSlot(handle)];
+	}
+
+	mat3x2 TransformStore::GetWorldAffine(uint32 handle) const
+	{
+		return m_WorldAffines[GetSlot(handle)];
+	}
+
+	mat4 TransformStore::GetWorldMatrix(uint32 handle) const
+	{
+		return m_WorldMatrices[GetSlot(handle)];
+	}
+
+	void TransformStore::StorePreviousState()
+	{
+		if(m_bNeedsRebuild)
+		{
+			Rebuild();
+		}
+
+		const uint32 count = uint32(m_Flags.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			if((m_Flags[i] & ALIVE) != 0)
+			{
+				m_PreviousAffines[i] = m_WorldAffines[i];
+				m_PreviousPositions[i] = m_WorldPositions[i];
+				m_PreviousRotations[i] = m_WorldRotations[i];
+				m_Flags[i] |= HAS_PREVIOUS;
+			}
+		}
+		m_bHasRenderState = false;
+	}
+
+	void TransformStore::Interpolate(float32 alpha)
+	{
+		//The affine columns are blended linearly, which is close enough
+		//to a real rotation for the small changes of a single step.
+		const uint32 count = uint32(m_Flags.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			uint8 flags = m_Flags[i];
+			if((flags & ALIVE) == 0)
+			{
+				continue;
+			}
+
+			//Transforms created since the last step have nothing to blend with.
+			if((flags & HAS_PREVIOUS) == 0)
+			{
+				m_RenderMatrices[i] = m_WorldMatrices[i];
+				m_RenderPositions[i] = m_WorldPositions[i];
+				m_RenderRotations[i] = m_WorldRotations[i];
+				continue;
+			}
+
+			const mat3x2 & previous = m_PreviousAffines[i];
+			const mat3x2 & current = m_WorldAffines[i];
+			mat4 & renderMatrix = m_RenderMatrices[i];
+			renderMatrix = m_WorldMatrices[i];
+			renderMatrix[0] = vec4(Lerp(previous[0], current[0], alpha), 0, 0);
+			renderMatrix[1] = vec4(Lerp(previous[1], current[1], alpha), 0, 0);
+			renderMatrix[3].x = Lerp(previous[2].x, current[2].x, alpha);
+			renderMatrix[3].y = Lerp(previous[2].y, current[2].y, alpha);
+
+			pos & renderPosition = m_RenderPositions[i];
+			renderPosition = m_WorldPositions[i];
+			renderPosition.x = Lerp(m_PreviousPositions[i].x, renderPosition.x, alpha);
+			renderPosition.y = Lerp(m_PreviousPositions[i].y, renderPosition.y, alpha);
+			m_RenderRotations[i] = Lerp(
+				m_PreviousRotations[i], m_WorldRotations[i], alpha);
+		}
+		m_bHasRenderState = true;
+	}
+
+	bool TransformStore::HasRenderState() const
+	{
+		return m_bHasRenderState;
+	}
+
+	mat4 TransformStore::GetRenderMatrix(uint32 handle) const
+	{
+		return m_bHasRenderState
+			? m_RenderMatrices[GetSlot(handle)]
+			: m_WorldMatrices[GetSlot(handle)];
+	}
+
+	pos TransformStore::GetRenderPosition(uint32 handle) const
+	{
+		return m_bHasRenderState
+			? m_RenderPositions[GetSlot(handle)]
+			: m_WorldPositions[GetSlot(handle)];
+	}
+
+	float32 TransformStore::GetRenderRotation(uint32 handle) const
+	{
+		return m_bHasRenderState
+			? m_RenderRotations[GetSlot(handle)]
+			: m_WorldRotations[GetSlot(handle)];
+	}
+
+	uint32 TransformStore::GetTransformCount() const
+	{
+		return uint32(m_Flags.size()) - m_DeadCount;
+	}
+
+	uint32 TransformStore::GetSlot(uint32 handle) const
+	{
+		ASSERT(handle < m_SlotOfHandle.size()
+			&& m_SlotOfHandle[handle] != INVALID_HANDLE,
+			_T("TransformStore::GetSlot: Invalid transform handle."));
+		return m_SlotOfHandle[handle];
+	}
+
+	void TransformStore::MarkDirty(uint32 slot)
+	{
+		m_Flags[slot] |= DIRTY;
+	}
+
+	void TransformStore::ResolveSlot(uint32 slot)
+	{
+		//local = Translate(position) * Rotate * Scale * Translate(-center)
+		const pos & localPosition = m_LocalPositions[slot];
+		const vec2 & localScale = m_LocalScales[slot];
+		const vec2 & center = m_CenterPoints[slot];
+		const ivec2 & dimensions = m_Dimensions[slot];
+		float32 localRotation = m_LocalRotations[slot];
+		uint8 mirrors = m_Mirrors[slot];
+
+		float32 cosRot = cos(localRotation);
+		float32 sinRot = sin(localRotation);
+
+		mat3x2 local;
+		local[0] = vec2(cosRot, sinRot) * localScale.x;
+		local[1] = vec2(-sinRot, cosRot) * localScale.y;
+		local[2] = vec2(localPosition.x, localPosition.y)
+			- local[0] * center.x
+			- local[1] * center.y;
+
+		//Mirroring flips around the center of the dimensions:
+		//local *= Translate(dim / 2) * Scale(-1) * Translate(-dim / 2)
+		if((mirrors & 1) != 0)
+		{
+			local[2] += local[0] * float32(dimensions.x);
+			local[0] = -local[0];
+		}
+		if((mirrors & 2) != 0)
+		{
+			local[2] += local[1] * float32(dimensions.y);
+			local[1] = -local[1];
+		}
+
+		mat3x2 & world = m_WorldAffines[slot];
+		pos & worldPosition = m_WorldPositions[slot];
+
+		uint32 parent = m_Parents[slot];
+		if(parent != INVALID_HANDLE && (m_Flags[parent] & ALIVE) == 0)
+		{
+			m_Parents[slot] = INVALID_HANDLE;
+			parent = INVALID_HANDLE;
+		}
+		if(parent != INVALID_HANDLE)
+		{
+			const mat3x2 & parentWorld = m_WorldAffines[parent];
+
+			world[0] = parentWorld[0] * local[0].x + parentWorld[1] * local[0].y;
+			world[1] = parentWorld[0] * local[1].x + parentWorld[1] * local[1].y;
+			world[2] = parentWorld[0] * local[2].x + parentWorld[1] * local[2].y
+				+ parentWorld[2];
+
+			worldPosition.l = m_WorldPositions[parent].l + localPosition.l;
+			m_WorldRotations[slot] = m_WorldRotations[parent] + localRotation;
+			m_WorldScales[slot] = m_WorldScales[parent] * localScale;
+		}
+		else
+		{
+			world = local;
+
+			worldPosition.l = localPosition.l;
+			m_WorldRotations[slot] = localRotation;
+			m_WorldScales[slot] = localScale;
+		}
+
+		worldPosition.x = world[2].x;
+		worldPosition.y = world[2].y;
+
+		//Expand into the mat4 the renderer and colliders consume.
+		mat4 & worldMatrix = m_WorldMatrices[slot];
+		worldMatrix = mat4();
+		worldMatrix[0] = vec4(world[0], 0, 0);
+		worldMatrix[1] = vec4(world[1], 0, 0);
+		worldMatrix[3] = vec4(world[2], worldPosition.l * LAYER_HEIGHT, 1);
+
+		if((mirrors & 1) != 0)
+		{
+			worldPosition.x -= dimensions.x;
+		}
+		if((mirrors & 2) != 0)
+		{
+			worldPosition.y -= dimensions.y;
+		}
+
+		//Resolved after the interpolation, so there is no older state to show.
+		if(m_bHasRenderState)
+		{
+			m_RenderMatrices[slot] = worldMatrix;
+			m_RenderPositions[slot] = worldPosition;
+			m_RenderRotations[slot] = m_WorldRotations[slot];
+		}
+	}
+
+	void TransformStore::Rebuild()
+	{
+		//Drops the dead slots and sorts the rest by depth, which puts every
+		//parent before its children while keeping siblings in creation order.
+		const uint32 count = uint32(m_Flags.size());
+		std::vector<uint32> depths(count, 0);
+		uint32 maxDepth = 0;
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			if((m_Flags[i] & ALIVE) == 0)
+			{
+				continue;
+			}
+			uint32 depth = 0;
+			for(uint32 parent = m_Parents[i] ;
+				parent != INVALID_HANDLE && (m_Flags[parent] & ALIVE) != 0 ;
+				parent = m_Parents[parent])
+			{
+				++depth;
+			}
+			depths[i] = depth;
+			maxDepth = std::max(maxDepth, depth);
+		}
+
+		std::vector<uint32> offsets(maxDepth + 2, 0);
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			if((m_Flags[i] & ALIVE) != 0)
+			{
+				++offsets[depths[i] + 1];
+			}
+		}
+		for(uint32 d = 1 ; d < offsets.size() ; ++d)
+		{
+			offsets[d] += offsets[d - 1];
+		}
+
+		const uint32 liveCount = offsets.back();
+		std::vector<uint32> order(liveCount);
+		std::vector<uint32> newSlots(count, INVALID_HANDLE);
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			if((m_Flags[i] & ALIVE) != 0)
+			{
+				uint32 slot = offsets[depths[i]]++;
+				order[slot] = i;
+				newSlots[i] = slot;
+			}
+		}
+
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			uint32 parent = m_Parents[i];
+			m_Parents[i] = parent == INVALID_HANDLE
+				? INVALID_HANDLE
+				: newSlots[parent];
+		}
+
+		Reorder(m_Handles, order);
+		Reorder(m_Flags, order);
+		Reorder(m_Parents, order);
+		Reorder(m_Owners, order);
+		Reorder(m_LocalPositions, order);
+		Reorder(m_LocalRotations, order);
+		Reorder(m_LocalScales, order);
+		Reorder(m_CenterPoints, order);
+		Reorder(m_Dimensions, order);
+		Reorder(m_Mirrors, order);
+		Reorder(m_WorldAffines, order);
+		Reorder(m_WorldMatrices, order);
+		Reorder(m_WorldPositions, order);
+		Reorder(m_WorldRotations, order);
+		Reorder(m_WorldScales, order);
+		Reorder(m_PreviousAffines, order);
+		Reorder(m_PreviousPositions, order);
+		Reorder(m_PreviousRotations, order);
+		Reorder(m_RenderMatrices, order);
+		Reorder(m_RenderPositions, order);
+		Reorder(m_RenderRotations, order);
+
+		for(uint32 i = 0 ; i < liveCount ; ++i)
+		{
+			m_SlotOfHandle[m_Handles[i]] = i;
+		}
+
+		m_DeadCount = 0;
+		m_bNeedsRebuild = false;
+	}
+
+	template <typename T>
+	void TransformStore::Reorder(
+		std::vector<T> & data,
+		const std::vector<uint32> & order
+		)
+	{
+		std::vector<T> reordered;
+		reordered.reserve(std::max<size_t>(data.capacity(), order.size()));
+		for(auto index : order)
+		{
+			reordered.push_back(data[index]);
+		}
+		data.swap(reordered);
+	}
+}
+
+#endif
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+
+#ifdef STAR2D
+
+namespace star
+{
+	class Object;
+
+	//Storage of the 2D transforms of a scene. Local and world data live in
+	//parallel arrays, ordered so that a parent always comes before its
+	//children. One linear pass per frame resolves every dirty transform and
+	//the subtrees below it, reading the parent that was resolved just before.
+	//TransformComponents only hold a handle into the store of their scene.
+	//The arrays grow and get reordered, so all data is returned by value.
+	class TransformStore final
+	{
+	public:
+		static const uint32 INVALID_HANDLE = 0xFFFFFFFF;
+
+		TransformStore();
+		~TransformStore();
+
+		//Holds the transforms of objects that aren't part of a scene.
+		//Nothing updates it, they are resolved when initialized.
+		static TransformStore * GetInstance();
+
+		uint32 Create(Object * pOwner);
+		void Destroy(uint32 handle);
+		void SetParent(uint32 handle, uint32 parentHandle);
+		//Moves the local data of a transform into another store and returns
+		//its handle there. The transform has no parent in the new store.
+		uint32 Transfer(uint32 handle, TransformStore & target);
+
+		void Update();
+		void Resolve(uint32 handle);
+		void SetDirty(uint32 handle, bool dirty);
+
+		void SetLocalPosition(uint32 handle, const pos & position);
+		void SetLocalRotation(uint32 handle, float32 rotation);
+		void SetLocalScale(uint32 handle, const vec2 & scale);
+		void SetCenterPoint(uint32 handle, const vec2 & centerPoint);
+		void SetDimensions(uint32 handle, const ivec2 & dimensions);
+		void SetMirrored(uint32 handle, bool x, bool y);
+
+		pos GetLocalPosition(uint32 handle) const;
+		float32 GetLocalRotation(uint32 handle) const;
+		vec2 GetLocalScale(uint32 handle) const;
+		vec2 GetCenterPoint(uint32 handle) const;
+		bool IsMirroredX(uint32 handle) const;
+		bool IsMirroredY(uint32 handle) const;
+
+		pos GetWorldPosition(uint32 handle) const;
+		float32 GetWorldRotation(uint32 handle) const;
+		vec2 GetWorldScale(uint32 handle) const;
+		mat3x2 GetWorldAffine(uint32 handle) const;
+		mat4 GetWorldMatrix(uint32 handle) const;
+
+		//Render interpolation for the fixed timestep. The world state is saved
+		//before every simulation step and Interpolate blends the saved state
+		//with the current one. The render getters return the world data
+		//again as soon as the next step starts.
+		void StorePreviousState();
+		void Interpolate(float32 alpha);
+		bool HasRenderState() const;
+
+		mat4 GetRenderMatrix(uint32 handle) const;
+		pos GetRenderPosition(uint32 handle) const;
+		float32 GetRenderRotation(uint32 handle) const;
+
+		uint32 GetTransformCount() const;
+
+	private:
+		enum Flags : uint8
+		{
+			ALIVE = 1,
+			DIRTY = 2,
+			INVALID = 4,
+			UPDATED = 8,
+			HAS_PREVIOUS = 16
+		};
+
+		static const uint32 MIN_DEAD_FOR_REBUILD = 64;
+
+		uint32 GetSlot(uint32 handle) const;
+		void MarkDirty(uint32 slot);
+		void ResolveSlot(uint32 slot);
+		void Rebuild();
+
+		template <typename T>
+		static void Reorder(std::vector<T> & data, const std::vector<uint32> & order);
+
+		static TransformStore * m_pTransformStore;
+
+		//Indirection from handle to slot and back,
+		//slots move around when the store is rebuilt.
+		std::vector<uint32> m_SlotOfHandle;
+		std::vector<uint32> m_FreeHandles;
+		std::vector<uint32> m_Handles;
+
+		std::vector<uint8> m_Flags;
+		std::vector<uint32> m_Parents;
+		std::vector<Object*> m_Owners;
+
+		std::vector<pos> m_LocalPositions;
+		std::vector<float32> m_LocalRotations;
+		std::vector<vec2> m_LocalScales;
+		std::vector<vec2> m_CenterPoints;
+		std::vector<ivec2> m_Dimensions;
+		std::vector<uint8> m_Mirrors;
+
+		std::vector<mat3x2> m_WorldAffines;
+		std::vector<mat4> m_WorldMatrices;
+		std::vector<pos> m_WorldPositions;
+		std::vector<float32> m_WorldRotations;
+		std::vector<vec2> m_WorldScales;
+
+		std::vector<mat3x2> m_PreviousAffines;
+		std::vector<pos> m_PreviousPositions;
+		std::vector<float32> m_PreviousRotations;
+
+		std::vector<mat4> m_RenderMatrices;
+		std::vector<pos> m_RenderPositions;
+		std::vector<float32> m_RenderRotations;
+
+		uint32 m_DeadCount;
+		bool m_bNeedsRebuild;
+		bool m_bHasRenderState;
+
+		TransformStore(const TransformStore &);
+		TransformStore(TransformStore &&);
+		TransformStore & operator=(const TransformStore &);
+		TransformStore & operator=(TransformStore &&);
+	};
+}
+
+#endif
@@ -0,0 +1,251 @@
+#include "UpdateScheduler.h"
+#include "../Objects/Object.h"
+#include "../Context.h"
+#include "../Logger.h"
+#include "../Helpers/JobSystem.h"
+
+namespace star
+{
+	std::vector<UpdateScheduler::TypeDescriptor> UpdateScheduler::m_Types;
+	std::vector<uint32> UpdateScheduler::m_RegistrationOrder;
+	uint32 UpdateScheduler::m_TypesVersion = 0;
+
+	UpdateScheduler::TypeDescriptor::TypeDescriptor()
+		: bIsRegistered(false)
+		, Phase(UpdatePhase::Animation)
+		, Reads(ACCESS_NONE)
+		, Writes(ACCESS_NONE)
+		, Function()
+	{
+	}
+
+	UpdateScheduler::Stage::Stage()
+		: TypeIDs()
+		, Reads(ACCESS_NONE)
+		, Writes(ACCESS_NONE)
+		, bIsParallel(true)
+	{
+	}
+
+	UpdateScheduler::UpdateScheduler()
+		: m_Instances()
+		, m_NoInstances()
+		, m_StagesVersion(0)
+		, m_Batch()
+	{
+	}
+
+	UpdateScheduler::~UpdateScheduler()
+	{
+		//Components get deleted by their objects, only drop the references.
+		for(auto & instances : m_Instances)
+		{
+			for(auto component : instances)
+			{
+				component->m_pScheduler = nullptr;
+				component->m_SchedulerSlot = INVALID_SLOT;
+			}
+		}
+		m_Instances.clear();
+	}
+
+	void UpdateScheduler::RegisterType(
+		uint32 typeID,
+		UpdatePhase phase,
+		uint32 reads,
+		uint32 writes,
+		const UpdateFunction & function
+		)
+	{
+		if(typeID >= m_Types.size())
+		{
+			m_Types.resize(typeID + 1);
+		}
+
+		TypeDescriptor & descriptor = m_Types[typeID];
+		if(!descriptor.bIsRegistered)
+		{
+			m_RegistrationOrder.push_back(typeID);
+		}
+		descriptor.bIsRegistered = true;
+		descriptor.Phase = phase;
+		descriptor.Reads = reads;
+		descriptor.Writes = writes;
+		descriptor.Function = function;
+		++m_TypesVersion;
+	}
+
+	bool UpdateScheduler::IsScheduledType(uint32 typeID)
+	{
+		return typeID < m_Types.size() && m_Types[typeID].bIsRegistered;
+	}
+
+	void UpdateScheduler::AddComponent(BaseComponent * component)
+	{
+		uint32 typeID = component->m_TypeID;
+		if(component->m_pScheduler != nullptr)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("UpdateScheduler::AddComponent: The component is already scheduled."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		if(typeID >= m_Instances.size())
+		{
+			m_Instances.resize(typeID + 1);
+		}
+		component->m_pScheduler = this;
+		component->m_SchedulerSlot = uint32(m_Instances[typeID].size());
+		m_Instances[typeID].push_back(component);
+	}
+
+	void UpdateScheduler::RemoveComponent(BaseComponent * component)
+	{
+		if(component->m_pScheduler != this)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("UpdateScheduler::RemoveComponent: The component is not in this scheduler."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		//Swap-and-pop, the update order within a type is not preserved.
+		auto & instances = m_Instances[component->m_TypeID];
+		uint32 slot = component->m_SchedulerSlot;
+		BaseComponent * pLast = instances.back();
+		instances[slot] = pLast;
+		pLast->m_SchedulerSlot = slot;
+		instances.pop_back();
+
+		component->m_pScheduler = nullptr;
+		component->m_SchedulerSlot = INVALID_SLOT;
+	}
+
+	void UpdateScheduler::RemoveUnscheduledComponents()
+	{
+		for(uint32 typeID = 0 ; typeID < m_Instances.size() ; ++typeID)
+		{
+			if(IsScheduledType(typeID))
+			{
+				continue;
+			}
+			for(auto component : m_Instances[typeID])
+			{
+				component->m_pScheduler = nullptr;
+				component->m_SchedulerSlot = INVALID_SLOT;
+			}
+			m_Instances[typeID].clear();
+		}
+	}
+
+	const std::vector<BaseComponent*> & UpdateScheduler::GetComponents(uint32 typeID) const
+	{
+		return typeID < m_Instances.size() ? m_Instances[typeID] : m_NoInstances;
+	}
+
+	void UpdateScheduler::Update(UpdatePhase phase, const Context & context)
+	{
+		if(m_StagesVersion != m_TypesVersion)
+		{
+			BuildStages();
+		}
+
+		for(const Stage & stage : m_Stages[uint32(phase)])
+		{
+			RunStage(stage, context);
+		}
+	}
+
+	bool UpdateScheduler::IsUpdating(const BaseComponent * component)
+	{
+		//Same rules as the recursive update: a frozen ancestor stops it,
+		//as does an ancestor skipped by the update LOD of the scene.
+		if(!component->IsEnabled())
+		{
+			return false;
+		}
+		for(const Object * object = component->GetParent() ;
+			object != nullptr ; object = object->GetParent())
+		{
+			if(object->IsFrozen() || object->IsUpdateSkipped())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void UpdateScheduler::BuildStages()
+	{
+		for(uint32 phase = 0 ; phase < PHASE_COUNT ; ++phase)
+		{
+			m_Stages[phase].clear();
+		}
+
+		//Types are added to the last stage of their phase as long as their
+		//access doesn't overlap with it, so conflicting types keep running
+		//in registration order.
+		for(uint32 typeID : m_RegistrationOrder)
+		{
+			const TypeDescriptor & descriptor = m_Types[typeID];
+			auto & stages = m_Stages[uint32(descriptor.Phase)];
+			bool isShared = ((descriptor.Reads | descriptor.Writes) & ACCESS_SHARED) != 0;
+
+			bool conflicts = true;
+			if(!stages.empty() && !isShared && stages.back().bIsParallel)
+			{
+				const Stage & last = stages.back();
+				conflicts = (descriptor.Writes & (last.Reads | last.Writes)) != 0
+					|| (descriptor.Reads & last.Writes) != 0;
+			}
+
+			if(conflicts)
+			{
+				stages.push_back(Stage());
+				stages.back().bIsParallel = !isShared;
+			}
+
+			Stage & stage = stages.back();
+			stage.TypeIDs.push_back(typeID);
+			stage.Reads |= descriptor.Reads;
+			stage.Writes |= descriptor.Writes;
+		}
+		m_StagesVersion = m_TypesVersion;
+	}
+
+	void UpdateScheduler::RunStage(const Stage & stage, const Context & context)
+	{
+		m_Batch.clear();
+		for(uint32 typeID : stage.TypeIDs)
+		{
+			if(typeID < m_Instances.size())
+			{
+				m_Batch.insert(m_Batch.end(),
+					m_Instances[typeID].begin(), m_Instances[typeID].end());
+			}
+		}
+
+		auto updateRange = [&](uint32 first, uint32 last)
+		{
+			for(uint32 i = first ; i < last ; ++i)
+			{
+				BaseComponent * component = m_Batch[i];
+				if(IsUpdating(component))
+				{
+					m_Types[component->m_TypeID].Function(component, context);
+				}
+			}
+		};
+
+		if(stage.bIsParallel)
+		{
+			JobSystem::GetInstance()->ParallelFor(
+				0, uint32(m_Batch.size()), GRAIN_SIZE, updateRange);
+		}
+		else
+		{
+			updateRange(0, uint32(m_Batch.size()));
+		}
+	}
+}
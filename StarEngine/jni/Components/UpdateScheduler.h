@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+#include <functional>
+
+namespace star
+{
+	struct Context;
+	class BaseComponent;
+
+	enum class UpdatePhase : byte
+	{
+		Animation = 0,
+		AI = 1,
+		Movement = 2,
+		Transform = 3,
+		Physics = 4
+	};
+
+	//Keeps the initialized components of registered types in an array
+	//per component type, and runs their update phase by phase over
+	//those arrays. With dense component storage on the scene, the
+	//components of other types get arrays as well. Types of a phase whose declared access
+	//doesn't overlap share a stage, and a stage is spread over the
+	//JobSystem. Types that were not registered keep being updated
+	//through the virtual Update by their object.
+	class UpdateScheduler final
+	{
+	public:
+		//What an update touches next to its own component.
+		//Categories always refer to the owner object of the component.
+		enum Access : uint32
+		{
+			ACCESS_NONE = 0,
+			ACCESS_TRANSFORM = 1,
+			ACCESS_GRAPHICS = 2,
+			ACCESS_PHYSICS = 4,
+			ACCESS_AUDIO = 8,
+			ACCESS_USER = 16,
+			//Other objects, the scene, managers, callbacks or anything that
+			//allocates objects. Such types always run on the main thread.
+			ACCESS_SHARED = 0x80000000
+		};
+
+		static const uint32 PHASE_COUNT = 5;
+
+		UpdateScheduler();
+		~UpdateScheduler();
+
+		//Register before the first component of the type gets initialized.
+		template <typename T>
+		static void RegisterType(
+			UpdatePhase phase,
+			uint32 reads,
+			uint32 writes,
+			void (T::*update)(const Context&)
+			);
+		static bool IsScheduledType(uint32 typeID);
+
+		void AddComponent(BaseComponent * component);
+		void RemoveComponent(BaseComponent * component);
+		//Drops the components of types without a registered update.
+		void RemoveUnscheduledComponents();
+
+		//Holds exactly the components with this type ID.
+		//Components of derived types have IDs of their own.
+		const std::vector<BaseComponent*> & GetComponents(uint32 typeID) const;
+
+		void Update(UpdatePhase phase, const Context & context);
+
+	private:
+		static const uint32 GRAIN_SIZE = 64;
+		static const uint32 INVALID_SLOT = 0xFFFFFFFF;
+
+		typedef std::function<void(BaseComponent*, const Context&)> UpdateFunction;
+
+		struct TypeDescriptor
+		{
+			TypeDescriptor();
+
+			bool bIsRegistered;
+			UpdatePhase Phase;
+			uint32 Reads,
+				Writes;
+			UpdateFunction Function;
+		};
+
+		struct Stage
+		{
+			Stage();
+
+			std::vector<uint32> TypeIDs;
+			uint32 Reads,
+				Writes;
+			bool bIsParallel;
+		};
+
+		static void RegisterType(
+			uint32 typeID,
+			UpdatePhase phase,
+			uint32 reads,
+			uint32 writes,
+			const UpdateFunction & function
+			);
+		static bool IsUpdating(const BaseComponent * component);
+		void BuildStages();
+		void RunStage(const Stage & stage, const Context & context);
+
+		static std::vector<TypeDescriptor> m_Types;
+		static std::vector<uint32> m_RegistrationOrder;
+		static uint32 m_TypesVersion;
+
+		std::vector<std::vector<BaseComponent*>> m_Instances;
+		std::vector<BaseComponent*> m_NoInstances;
+		std::vector<Stage> m_Stages[PHASE_COUNT];
+		uint32 m_StagesVersion;
+		std::vector<BaseComponent*> m_Batch;
+
+		UpdateScheduler(const UpdateScheduler &);
+		UpdateScheduler(UpdateScheduler &&);
+		UpdateScheduler & operator=(const UpdateScheduler &);
+		UpdateScheduler & operator=(UpdateScheduler &&);
+	};
+}
+
+#include "UpdateScheduler.inl"
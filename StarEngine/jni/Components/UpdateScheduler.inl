@@ -0,0 +1,23 @@
+#include "BaseComponent.h"
+
+namespace star
+{
+	template <typename T>
+	void UpdateScheduler::RegisterType(
+		UpdatePhase phase,
+		uint32 reads,
+		uint32 writes,
+		void (T::*update)(const Context&)
+		)
+	{
+		RegisterType(
+			ComponentType::GetID<T>(),
+			phase,
+			reads,
+			writes,
+			[update](BaseComponent * component, const Context & context)
+			{
+				(static_cast<T*>(component)->*update)(context);
+			});
+	}
+}
@@ -26,11 +26,27 @@ namespace star
 	
 	void Entity::SetName(const tstring & name)
 	{
+		uint32 previousHash = m_Name.GetHash();
 		m_Name.SetTag(name);
+		OnNameChanged(previousHash);
 	}
 
-	bool Entity::CompareName(const tstring & name)
+	bool Entity::CompareName(const tstring & name) const
 	{
 		return m_Name == name;
 	}
+
+	bool Entity::CompareName(uint32 hash) const
+	{
+		return m_Name == hash;
+	}
+
+	uint32 Entity::GetNameHash() const
+	{
+		return m_Name.GetHash();
+	}
+
+	void Entity::OnNameChanged(uint32 previousHash)
+	{
+	}
 }
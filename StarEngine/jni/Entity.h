@@ -14,11 +14,19 @@ namespace star
 
 		const tstring & GetName() const;
 		void SetName(const tstring & name);
-		bool CompareName(const tstring & name);
+		bool CompareName(const tstring & name) const;
+		//A literal is hashed by HashLiteral, which the compiler can fold,
+		//so comparing against one costs a single integer compare.
+		template <uint32 N>
+		bool CompareName(const tchar (&name)[N]) const;
+		bool CompareName(uint32 hash) const;
+		uint32 GetNameHash() const;
 
 		virtual void Destroy() = 0;
 
 	protected:
+		virtual void OnNameChanged(uint32 previousHash);
+
 		HashTag m_Name;
 
 	private:
@@ -28,3 +36,5 @@ namespace star
 		Entity & operator=(Entity&&);
 	};
 }
+
+#include "Entity.inl"
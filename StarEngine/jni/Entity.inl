@@ -0,0 +1,10 @@
+#include "Helpers/Helpers.h"
+
+namespace star
+{
+	template <uint32 N>
+	bool Entity::CompareName(const tchar (&name)[N]) const
+	{
+		return CompareName(HashLiteral(name));
+	}
+}
@@ -4,7 +4,7 @@
 #include "Logger.h"
 #include "Scenes/SceneManager.h"
 #include "Graphics/GraphicsManager.h"
-#include <unistd.h>
+#include "Graphics/SpriteBatch.h"
 #include "Input/InputManager.h"
 #include "StarEngine.h"
 #include "Sound/AudioManager.h"
@@ -60,10 +60,14 @@ namespace star {
 		Logger::GetInstance()->Log(LogLevel::Info,
 			_T("Starting EventLoop"), STARENGINE_LOG_TAG);
 
+		FramePacer & framePacer = StarEngine::GetInstance()->GetFramePacer();
 		while (true)
 		{
 			mTimeManager->StartMonitoring();
-			while ((lResult = ALooper_pollAll(mEnabled ? 0 : -1, NULL, &lEvents,
+			//Block on the looper while there is nothing to update or draw.
+			bool waited = !mEnabled || framePacer.IsIdle();
+			while ((lResult = ALooper_pollAll(
+					mEnabled && !framePacer.IsIdle() ? 0 : -1, NULL, &lEvents,
 					(void**) &lSource)) >= 0)
 			{
 				if (lSource != NULL)
@@ -82,13 +86,19 @@ namespace star {
 				}
 			}
 
-			if (mEnabled && !mQuit)
+			if (waited)
+			{
+				mTimeManager->StartMonitoring();
+				framePacer.Restart();
+			}
+
+			if (mEnabled && !mQuit && !framePacer.IsIdle())
 			{
 				GraphicsManager::GetInstance()->SetHasWindowChanged(false);
 				mMainGame->Update(mContext);
 				mMainGame->Draw();
+				framePacer.EndFrame();
 			}
-			usleep(100);
 			mTimeManager->StopMonitoring();
 		}
 	}
@@ -142,6 +152,7 @@ namespace star {
 			//TextureManager::GetInstance()->ReloadAllTextures();
 			SceneManager::GetInstance()->processActivityEvent(pCommand,
 					pApplication);
+			StarEngine::GetInstance()->GetFramePacer().WakeUp();
 		}
 			break;
 
@@ -184,6 +195,8 @@ namespace star {
 		case APP_CMD_TERM_WINDOW:
 			Logger::GetInstance()->Log(LogLevel::Info,
 					_T("Eventloop : APP_CMD_TERM_WINDOW"), STARENGINE_LOG_TAG);
+			//A recorded frame might still draw the erased textures.
+			SpriteBatch::GetInstance()->DiscardPackets();
 			TextureManager::GetInstance()->EraseAllTextures();
 			break;
 
@@ -214,6 +227,7 @@ namespace star {
 
 	int32 EventLoop::inputCallback(android_app* pApplication, AInputEvent* pEvent)
 	{
+		StarEngine::GetInstance()->GetFramePacer().WakeUp();
 		return SceneManager::GetInstance()->processInputEvent(pEvent);
 	}
 }
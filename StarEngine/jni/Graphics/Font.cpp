@@ -1,5 +1,6 @@
 #include "Font.h"
 #include "../Logger.h"
+#include "SpriteBatch.h"
 
 #ifndef DESKTOP
 #include "Resource.h"
@@ -96,7 +97,7 @@ namespace star
 
 	void Font::DeleteFont()
 	{
-		glDeleteTextures(FONT_TEXTURES,mTextures);
+		SpriteBatch::DeleteTextures(FONT_TEXTURES, mTextures);
 		delete[] mTextures;
 #ifdef ANDROID
 		delete [] mFontBuffer;
@@ -36,6 +36,7 @@ namespace star
 		, mViewportResolution(0,0)
 		, mbHasWindowChanged(false)
 		, mIsInitialized(false)
+		, mContextID(0)
 #ifdef DESKTOP
 		, mWglSwapIntervalEXT(NULL)
 		, mWglGetSwapIntervalEXT(NULL)
@@ -126,6 +127,11 @@ namespace star
 #endif
 	}
 
+	uint32 GraphicsManager::GetContextID() const
+	{
+		return mContextID;
+	}
+
 #ifdef DESKTOP
 	void GraphicsManager::Initialize(int32 screenWidth, int32 screenHeight)
 	{
@@ -150,6 +156,7 @@ namespace star
 			//Initializes base GL state.
 			//DEPTH_TEST is default disabled
 			InitializeOpenGLStates();
+			++mContextID;
 			mIsInitialized = true;
 		}
 	}
@@ -234,6 +241,7 @@ namespace star
 			star::Logger::GetInstance()->Log(star::LogLevel::Info,
 				_T("Graphics Manager : Initialized"), STARENGINE_LOG_TAG);
 
+			++mContextID;
 			mIsInitialized = true;
 		}
 	}
@@ -245,6 +253,8 @@ namespace star
 		// Destroys OpenGL context.
 		if (mDisplay != EGL_NO_DISPLAY)
 		{
+			//Recorded frames point at textures of this context.
+			SpriteBatch::GetInstance()->DiscardPackets();
 			eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE,EGL_NO_CONTEXT);
 			if (mContext != EGL_NO_CONTEXT)
 			{
@@ -66,6 +66,10 @@ namespace star
 		void SetVSync(bool VSync);
 		bool GetVSync() const;
 
+		//Changes every time an OpenGL context gets created. Names of
+		//textures and framebuffers from an older context are gone.
+		uint32 GetContextID() const;
+
 	private:
 		GraphicsManager();
 		void InitializeOpenGLStates();
@@ -89,6 +93,7 @@ namespace star
 		vec2 mScreenResolution, mViewportResolution;
 		bool mbHasWindowChanged;
 		bool mIsInitialized;
+		uint32 mContextID;
 
 #ifdef ANDROID
 		EGLDisplay mDisplay;
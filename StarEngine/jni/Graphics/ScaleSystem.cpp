@@ -1,15 +1,32 @@
 #include "ScaleSystem.h"
 #include "GraphicsManager.h"
 #include "../Logger.h"
+#include "../Context.h"
+#include "../Helpers/Math.h"
+#include <algorithm>
 
 namespace star
 {
 	ScaleSystem * ScaleSystem::m_ScaleSystemPtr = nullptr;
 
+	const float32 ScaleSystem::DYNAMIC_STEP = 0.1f;
+	const float32 ScaleSystem::DYNAMIC_LOWER_THRESHOLD = 1.05f;
+	const float32 ScaleSystem::DYNAMIC_UPPER_THRESHOLD = 1.15f;
+
 	ScaleSystem::ScaleSystem()
 		:m_WorkingRes(0,0)
 		,m_Scale(0)
 		,m_bIninitialized(false)
+		,m_bDynamicResolution(false)
+		,m_DynamicFactor(1.0f)
+		,m_MinDynamicFactor(0.5f)
+		,m_MaxDynamicFactor(1.0f)
+		,m_TargetFrameTime(1000.0f / 60.0f)
+		,m_AccumulatedFrameTime(0)
+		,m_SampledFrames(0)
+		,m_StableWindows(0)
+		,m_RaiseDelay(DYNAMIC_MIN_RAISE_DELAY)
+		,m_bJustRaised(false)
 	{
 	}
 
@@ -64,5 +81,98 @@ namespace star
 			m_Scale = GraphicsManager::GetInstance()->GetViewportResolution().x / m_WorkingRes.x;
 		}
 	}
+
+	void ScaleSystem::SetDynamicResolutionEnabled(bool enabled)
+	{
+		m_bDynamicResolution = enabled;
+		m_DynamicFactor = m_MaxDynamicFactor;
+		m_AccumulatedFrameTime = 0;
+		m_SampledFrames = 0;
+		m_StableWindows = 0;
+		m_RaiseDelay = DYNAMIC_MIN_RAISE_DELAY;
+		m_bJustRaised = false;
+	}
+
+	bool ScaleSystem::IsDynamicResolutionEnabled() const
+	{
+		return m_bDynamicResolution;
+	}
+
+	void ScaleSystem::SetDynamicResolutionTarget(float32 targetFrameTimeMs)
+	{
+		Logger::GetInstance()->Log(targetFrameTimeMs > 0,
+			_T("ScaleSystem::SetDynamicResolutionTarget: Target frame time has to be > 0"),
+			STARENGINE_LOG_TAG);
+		m_TargetFrameTime = targetFrameTimeMs;
+	}
+
+	void ScaleSystem::SetDynamicResolutionRange(float32 minFactor, float32 maxFactor)
+	{
+		Logger::GetInstance()->Log(minFactor > 0 && minFactor <= maxFactor && maxFactor <= 1.0f,
+			_T("ScaleSystem::SetDynamicResolutionRange: Expected 0 < min <= max <= 1"),
+			STARENGINE_LOG_TAG);
+		m_MinDynamicFactor = minFactor;
+		m_MaxDynamicFactor = maxFactor;
+		m_DynamicFactor = Clamp(m_DynamicFactor, m_MinDynamicFactor, m_MaxDynamicFactor);
+	}
+
+	float32 ScaleSystem::GetDynamicResolutionFactor() const
+	{
+		return m_bDynamicResolution ? m_DynamicFactor : 1.0f;
+	}
+
+	void ScaleSystem::UpdateDynamicResolution(const Context & context)
+	{
+		if(!m_bDynamicResolution)
+		{
+			return;
+		}
+
+		m_AccumulatedFrameTime += context.mTimeManager->GetMilliSeconds();
+		if(++m_SampledFrames < DYNAMIC_SAMPLE_FRAMES)
+		{
+			return;
+		}
+
+		float32 averageFrameTime = float32(m_AccumulatedFrameTime / m_SampledFrames);
+		m_AccumulatedFrameTime = 0;
+		m_SampledFrames = 0;
+
+		//Drop as soon as a window misses the target, but only raise after
+		//several windows in a row held it. With VSync the frame time never
+		//drops below the target, so raising is a probe: when it fails right
+		//away, the next probe waits twice as long.
+		if(averageFrameTime > m_TargetFrameTime * DYNAMIC_UPPER_THRESHOLD)
+		{
+			if(m_bJustRaised)
+			{
+				m_RaiseDelay = std::min(m_RaiseDelay * 2, DYNAMIC_MAX_RAISE_DELAY);
+			}
+			m_DynamicFactor = std::max(m_DynamicFactor - DYNAMIC_STEP, m_MinDynamicFactor);
+			m_StableWindows = 0;
+			m_bJustRaised = false;
+		}
+		else if(averageFrameTime <= m_TargetFrameTime * DYNAMIC_LOWER_THRESHOLD)
+		{
+			m_bJustRaised = false;
+			if(++m_StableWindows >= m_RaiseDelay
+				&& m_DynamicFactor < m_MaxDynamicFactor)
+			{
+				m_DynamicFactor = std::min(m_DynamicFactor + DYNAMIC_STEP, m_MaxDynamicFactor);
+				m_StableWindows = 0;
+				m_bJustRaised = true;
+			}
+			else if(m_StableWindows >= DYNAMIC_MAX_RAISE_DELAY)
+			{
+				m_RaiseDelay = DYNAMIC_MIN_RAISE_DELAY;
+			}
+		}
+		else
+		{
+			//Inside the hysteresis band: keep the current factor.
+			m_StableWindows = 0;
+			m_bJustRaised = false;
+		}
+	}
 }
 
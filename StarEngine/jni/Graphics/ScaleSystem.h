@@ -5,6 +5,8 @@
 
 namespace star
 {
+	struct Context;
+
 	class ScaleSystem final
 	{
 	public:
@@ -18,13 +20,38 @@ namespace star
 		float32 GetScale() const;
 		void CalculateScale();
 
+		void SetDynamicResolutionEnabled(bool enabled);
+		bool IsDynamicResolutionEnabled() const;
+		void SetDynamicResolutionTarget(float32 targetFrameTimeMs);
+		void SetDynamicResolutionRange(float32 minFactor, float32 maxFactor = 1.0f);
+		float32 GetDynamicResolutionFactor() const;
+		void UpdateDynamicResolution(const Context & context);
+
 	private:
 		ScaleSystem();
 
+		static const uint32 DYNAMIC_SAMPLE_FRAMES = 30;
+		static const uint32 DYNAMIC_MIN_RAISE_DELAY = 2;
+		static const uint32 DYNAMIC_MAX_RAISE_DELAY = 32;
+		static const float32 DYNAMIC_STEP;
+		static const float32 DYNAMIC_LOWER_THRESHOLD;
+		static const float32 DYNAMIC_UPPER_THRESHOLD;
+
 		vec2 m_WorkingRes;
 		float32 m_Scale;
 		bool m_bIninitialized;
 
+		bool m_bDynamicResolution;
+		float32 m_DynamicFactor,
+				m_MinDynamicFactor,
+				m_MaxDynamicFactor,
+				m_TargetFrameTime;
+		float64 m_AccumulatedFrameTime;
+		uint32	m_SampledFrames,
+				m_StableWindows,
+				m_RaiseDelay;
+		bool m_bJustRaised;
+
 		static ScaleSystem * m_ScaleSystemPtr;
 	};
 }
@@ -15,13 +15,47 @@ namespace star
 {
 	SpriteBatch * SpriteBatch::m_pSpriteBatch = nullptr;
 
+	SpriteBatch::RenderPass::RenderPass()
+		: scaleMatrix()
+		, viewInverseMatrix()
+		, projectionMatrix()
+		, frameBufferID(0)
+		, targetDimensions(0, 0)
+		, firstSprite(0)
+		, spriteCount(0)
+		, firstHUDSprite(0)
+		, firstRun(0)
+		, runCount(0)
+		, resolutionFactor(1.0f)
+		, bIsScaled(false)
+	{
+	}
+
+	SpriteBatch::RenderPacket::RenderPacket()
+		: Sprites()
+		, Glyphs()
+		, Texts()
+		, Passes()
+		, DebugPrimitives()
+		, DebugMatrix()
+		, SortingMode(SpriteSortingMode::BackToFront)
+		, SpriteOrder()
+		, VertexBuffer()
+		, UvCoordBuffer()
+		, IsHUDBuffer()
+		, ColorBuffer()
+		, ReleasedTextures()
+		, ReleasedFrameBuffers()
+		, Build()
+		, bIsReady(false)
+	{
+	}
+
 	SpriteBatch::SpriteBatch(void)
 		: m_SpriteQueue()
 		, m_TextQueue()
-		, m_VertexBuffer()
-		, m_UvCoordBuffer()
-		, m_IsHUDBuffer()
-		, m_ColorBuffer()
+		, m_RecordPacket(0)
+		, m_bIsPipelined(false)
 		, m_TextureSamplerID(0)
 		, m_ColorID(0)
 		, m_ScalingID(0)
@@ -29,13 +63,26 @@ namespace star
 		, m_ProjectionID(0)
 		, m_ShaderPtr(nullptr)
 		, m_SpriteSortingMode(SpriteSortingMode::BackToFront)
+		, m_StashedSpriteQueue()
+		, m_StashedTextQueue()
+		, m_bIsRenderingCachedLayer(false)
+		, m_CachedLayerFrameBufferID(0)
+		, m_CachedLayerTextureDimensions(0, 0)
+		, m_CachedLayerDimensions(0, 0)
+		, m_CachedLayerInverseWorld()
+		, m_SceneFrameBufferID(0)
+		, m_SceneTextureID(0)
+		, m_SceneTextureDimensions(0, 0)
 	{
 
 	}
-	
+
 	SpriteBatch::~SpriteBatch(void)
 	{
+		DiscardPackets();
+		DestroySceneTarget();
 		delete m_ShaderPtr;
+		m_pSpriteBatch = nullptr;
 	}
 
 	SpriteBatch * SpriteBatch::GetInstance()
@@ -58,8 +105,8 @@ namespace star
 		if(!m_ShaderPtr->Init(vShader, fShader))
 		{
 			Logger::GetInstance()->
-				Log(star::LogLevel::Info, 
-				_T("Initialization of Spritebatch Shader has Failed!"), 
+				Log(star::LogLevel::Info,
+				_T("Initialization of Spritebatch Shader has Failed!"),
 				STARENGINE_LOG_TAG);
 		}
 
@@ -76,381 +123,943 @@ namespace star
 
 	void SpriteBatch::Flush()
 	{
-		Begin();
-		DrawSprites();
+		if(m_bIsRenderingCachedLayer)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SpriteBatch::Flush: A cached layer is still being rendered, ending it."),
+				STARENGINE_LOG_TAG);
+			EndCachedLayer();
+		}
 
-		//Clear vertex, uv, color and isHud buffer
-		m_VertexBuffer.clear();
-		m_UvCoordBuffer.clear();
-		m_IsHUDBuffer.clear();
-		m_ColorBuffer.clear();
+		RenderPacket & packet = GetRecordPacket();
 
-		DrawTextSprites();
+		RenderPass scene;
+		float32 scaleValue = ScaleSystem::GetInstance()->GetScale();
+		scene.scaleMatrix = Scale(scaleValue, scaleValue, 0);
+		scene.viewInverseMatrix = GraphicsManager::GetInstance()->GetViewInverseMatrix();
+		scene.projectionMatrix = GraphicsManager::GetInstance()->GetProjectionMatrix();
+		scene.resolutionFactor = ScaleSystem::GetInstance()->GetDynamicResolutionFactor();
+		if(scene.resolutionFactor < 1.0f)
+		{
+			scene.bIsScaled = UpdateSceneTarget();
+		}
+		else if(!ScaleSystem::GetInstance()->IsDynamicResolutionEnabled())
+		{
+			DestroySceneTarget();
+		}
+		RecordPass(packet, scene, nullptr);
 
-		End();
+		DebugDraw::GetInstance()->TakePrimitives(
+			packet.DebugPrimitives,
+			packet.DebugMatrix
+			);
+		packet.SortingMode = m_SpriteSortingMode;
+		packet.bIsReady = true;
+
+		if(m_bIsPipelined)
+		{
+			RenderPacket * pPacket = &packet;
+			packet.Build.Run([pPacket]()
+			{
+				BuildPacket(*pPacket);
+			});
+			m_RecordPacket = 1 - m_RecordPacket;
+		}
+		else
+		{
+			BuildPacket(packet);
+			DrawPacket(packet);
+			ReleasePacket(packet);
+		}
 	}
-	
-	void SpriteBatch::Begin()
-	{
-		m_ShaderPtr->Bind();
-		
-		//[TODO] Test android!
-		glEnableVertexAttribArray(m_VertexID);
-		glEnableVertexAttribArray(m_UVID);
-		glEnableVertexAttribArray(m_IsHUDID);
-		glEnableVertexAttribArray(m_ColorID);
 
-		//Create Vertexbuffer
-		SortSprites(m_SpriteSortingMode);
-		CreateSpriteQuads();
-		
-		//Set uniforms
-		glUniform1i(m_TextureSamplerID, 0);
-		float scaleValue = ScaleSystem::GetInstance()->GetScale();
-		mat4 scaleMat = Scale(scaleValue, scaleValue, 0);
-		glUniformMatrix4fv(m_ScalingID, 1, GL_FALSE, ToPointerValue(scaleMat));
+	SpriteBatch::RenderPacket & SpriteBatch::GetRecordPacket()
+	{
+		//A packet that is still waiting here was never drawn,
+		//Draw didn't run since it was recorded.
+		RenderPacket & packet = m_Packets[m_RecordPacket];
+		if(packet.bIsReady)
+		{
+			ReleasePacket(packet);
+		}
+		return packet;
+	}
 
-		const mat4& viewInverseMat = GraphicsManager::GetInstance()->GetViewInverseMatrix();
-		glUniformMatrix4fv(m_ViewInverseID, 1, GL_FALSE, ToPointerValue(viewInverseMat));
+	void SpriteBatch::RecordPass(
+		RenderPacket & packet,
+		RenderPass & pass,
+		const mat4 * pLayerInverseWorld
+		)
+	{
+		//Only values are copied, the packet can be built and drawn after
+		//the sprites, texts and fonts it was recorded from are gone.
+		pass.firstSprite = uint32(packet.Sprites.size());
+		pass.spriteCount = uint32(m_SpriteQueue.size());
+		pass.firstHUDSprite = pass.firstSprite + pass.spriteCount;
+		for(const SpriteInfo* sprite : m_SpriteQueue)
+		{
+			SpriteEntry entry;
+			entry.worldMatrix = sprite->transformPtr->GetRenderMatrix();
+			if(pLayerInverseWorld != nullptr)
+			{
+				entry.worldMatrix = *pLayerInverseWorld * entry.worldMatrix;
+			}
+			entry.uvCoords = sprite->uvCoords;
+			entry.vertices = sprite->vertices;
+			entry.colorMultiplier = sprite->colorMultiplier;
+			entry.depth = float32(sprite->transformPtr->GetWorldPosition().l);
+			entry.textureID = sprite->textureID;
+			entry.bIsHud = sprite->bIsHud;
+			packet.Sprites.push_back(entry);
+		}
 
-		const mat4& projectionMat = GraphicsManager::GetInstance()->GetProjectionMatrix();
-		glUniformMatrix4fv(m_ProjectionID, 1, GL_FALSE, ToPointerValue(projectionMat));
-	}
-	
-	void SpriteBatch::DrawSprites()
-	{			
-		uint32 batchStart(0);
-		uint32 batchSize(0);
-		GLuint texture(0);
-		for(const SpriteInfo* currentSprite : m_SpriteQueue)
-		{	
-			//If != -> Flush
-			if(texture != currentSprite->textureID)
+		pass.firstRun = uint32(packet.Texts.size());
+		pass.runCount = uint32(m_TextQueue.size());
+		for(const TextInfo* text : m_TextQueue)
+		{
+			TextRun run;
+			run.worldMatrix = text->transformPtr->GetRenderMatrix();
+			if(pLayerInverseWorld != nullptr)
 			{
-				FlushSprites(batchStart, batchSize, texture);
+				run.worldMatrix = *pLayerInverseWorld * run.worldMatrix;
+			}
+			run.colorMultiplier = text->colorMultiplier;
+			run.bIsHud = text->bIsHud;
+			run.firstGlyph = uint32(packet.Glyphs.size());
 
-				batchStart += batchSize;
-				batchSize = 0;
+			GLuint* textures = text->font->GetTextures();
+			int32 line_counter(0);
+			int32 offsetX(text->horizontalTextOffset.at(line_counter));
+			int32 offsetY(0);
+			int32 fontHeight(text->font->GetMaxLetterHeight() + text->font->GetMinLetterHeight());
+			for(auto it : text->text)
+			{
+				const CharacterInfo& charInfo = text->font->GetCharacterInfo(static_cast<suchar>(it));
+				GlyphEntry glyph;
+				glyph.offset = vec2(
+					float32(offsetX),
+					float32(offsetY + charInfo.letterDimensions.y + text->textHeight - fontHeight)
+					);
+				glyph.vertexDimensions = charInfo.vertexDimensions;
+				glyph.uvDimensions = charInfo.uvDimensions;
+				glyph.textureID = it > FIRST_REAL_ASCII_CHAR ? textures[it] : 0;
+				packet.Glyphs.push_back(glyph);
 
-				texture = currentSprite->textureID;
+				offsetX += charInfo.letterDimensions.x;
+				if(it == _T('\n'))
+				{
+					offsetY -= text->font->GetMaxLetterHeight() + text->verticalSpacing;
+					++line_counter;
+					offsetX = text->horizontalTextOffset.at(line_counter);
+				}
 			}
-			++batchSize;
-		}	
-		FlushSprites(batchStart, batchSize, texture);
+			run.glyphCount = uint32(packet.Glyphs.size()) - run.firstGlyph;
+			packet.Texts.push_back(run);
+		}
+
+		packet.Passes.push_back(pass);
+		m_SpriteQueue.clear();
+		m_TextQueue.clear();
 	}
 
-	void SpriteBatch::FlushSprites(uint32 start, uint32 size, uint32 texture)
+	void SpriteBatch::BuildPacket(RenderPacket & packet)
 	{
-		if(size > 0)
-		{	
-			//[TODO] Check if this can be optimized
-			glBindTexture(GL_TEXTURE_2D, texture);
-		
-			//Set attributes and buffers
-			glVertexAttribPointer(m_VertexID, 4, GL_FLOAT, 0, 0, 
-				reinterpret_cast<GLvoid*>(&m_VertexBuffer.at(0)));
-			glVertexAttribPointer(m_UVID, 2, GL_FLOAT, 0, 0, 
-				reinterpret_cast<GLvoid*>(&m_UvCoordBuffer.at(0)));
-			glVertexAttribPointer(m_IsHUDID, 1, GL_FLOAT, 0, 0,
-				reinterpret_cast<GLvoid*>(&m_IsHUDBuffer.at(0)));
-			glVertexAttribPointer(m_ColorID, 4, GL_FLOAT, 0, 0,
-				reinterpret_cast<GLvoid*>(&m_ColorBuffer.at(0)));
-
-			glDrawArrays(GL_TRIANGLES, start * 6, size * 6);	
+		//Runs on the JobSystem while pipelining, so it only
+		//touches the packet, never the scene or the batch.
+		uint32 spriteCount = uint32(packet.Sprites.size());
+		uint32 quadCount = spriteCount + uint32(packet.Glyphs.size());
+		packet.SpriteOrder.resize(spriteCount);
+		for(uint32 s = 0 ; s < spriteCount ; ++s)
+		{
+			packet.SpriteOrder[s] = s;
 		}
-	}
-	
-	void SpriteBatch::End()
-	{
-		//Unbind attributes and buffers
-		glDisableVertexAttribArray(m_VertexID);
-		glDisableVertexAttribArray(m_UVID);
-		glDisableVertexAttribArray(m_IsHUDID);
-		glDisableVertexAttribArray(m_ColorID);
+		packet.VertexBuffer.resize(quadCount * 6);
+		packet.UvCoordBuffer.resize(quadCount * UV_AMOUNT);
+		packet.IsHUDBuffer.resize(quadCount * 6);
+		packet.ColorBuffer.resize(quadCount * 6);
 
-		m_ShaderPtr->Unbind();
+		for(auto & pass : packet.Passes)
+		{
+			uint32 first = pass.firstSprite;
+			uint32 last = pass.firstSprite + pass.spriteCount;
+			if(pass.bIsScaled)
+			{
+				//World sprites go to the scaled scene target,
+				//HUD sprites are drawn over it at native resolution.
+				auto hudStart = std::stable_partition(
+					packet.SpriteOrder.begin() + first,
+					packet.SpriteOrder.begin() + last,
+					[&packet](uint32 sprite) -> bool
+					{
+						return !packet.Sprites[sprite].bIsHud;
+					});
+				pass.firstHUDSprite = uint32(hudStart - packet.SpriteOrder.begin());
+				SortSprites(packet, first, pass.firstHUDSprite);
+				SortSprites(packet, pass.firstHUDSprite, last);
+			}
+			else
+			{
+				SortSprites(packet, first, last);
+			}
+		}
 
-		m_SpriteQueue.clear();
-		m_TextQueue.clear();
+		//for every sprite that has to be drawn, write all vertices
+		//(6 per sprite) into the vertexbuffer and all uvcoords
+		//(UV_AMOUNT per sprite) into the uvbuffer and the isHUD bool.
+		//Every sprite writes its own range of the buffers,
+		//so the quads are generated in parallel chunks.
+		JobSystem::GetInstance()->ParallelFor(0, spriteCount, QUAD_GRAIN_SIZE,
+			[&packet](uint32 first, uint32 last)
+		{
+			WriteSpriteQuads(packet, first, last);
+		});
 
-		m_VertexBuffer.clear();
-		m_UvCoordBuffer.clear();
-		m_IsHUDBuffer.clear();
-		m_ColorBuffer.clear();
+		//The glyph quads follow the sprite quads, one per character.
+		for(const TextRun & run : packet.Texts)
+		{
+			for(uint32 g = run.firstGlyph ; g < run.firstGlyph + run.glyphCount ; ++g)
+			{
+				const GlyphEntry & glyph = packet.Glyphs[g];
+				mat4 offsetMatrix = Translate(vec3(glyph.offset.x, glyph.offset.y, 0));
+				uint32 quad = spriteCount + g;
+				WriteQuad(
+					run.worldMatrix * offsetMatrix,
+					glyph.vertexDimensions,
+					vec4(0, glyph.uvDimensions.x, glyph.uvDimensions.y, 0),
+					run.colorMultiplier,
+					run.bIsHud,
+					&packet.VertexBuffer[quad * 6],
+					&packet.UvCoordBuffer[quad * UV_AMOUNT],
+					&packet.IsHUDBuffer[quad * 6],
+					&packet.ColorBuffer[quad * 6]
+					);
+			}
+		}
 	}
 
-	void SpriteBatch::DrawTextSprites()
-	{	
-		CreateTextQuads();
-
-		//FlushText once per TextComponent (same font)
-		//Check per text how many characters -> Forloop drawing
-		int32 startIndex(0);
-		for(const TextInfo* text : m_TextQueue)
+	void SpriteBatch::WriteSpriteQuads(RenderPacket & packet, uint32 first, uint32 last)
+	{
+		for(uint32 s = first ; s < last ; ++s)
 		{
-			GLuint* textures = text->font->GetTextures();
+			const SpriteEntry & sprite = packet.Sprites[packet.SpriteOrder[s]];
+			WriteQuad(
+				sprite.worldMatrix,
+				sprite.vertices,
+				vec4(
+					sprite.uvCoords.x,
+					sprite.uvCoords.x + sprite.uvCoords.z,
+					sprite.uvCoords.y,
+					sprite.uvCoords.y + sprite.uvCoords.w
+					),
+				sprite.colorMultiplier,
+				sprite.bIsHud,
+				&packet.VertexBuffer[s * 6],
+				&packet.UvCoordBuffer[s * UV_AMOUNT],
+				&packet.IsHUDBuffer[s * 6],
+				&packet.ColorBuffer[s * 6]
+				);
+		}
+	}
 
-			const tchar *start_line = text->text.c_str();
-			for(int32 i = 0 ; start_line[i] != 0 ; ++i) 
+	void SpriteBatch::SortSprites(RenderPacket & packet, uint32 first, uint32 last)
+	{
+		auto begin = packet.SpriteOrder.begin() + first;
+		auto end = packet.SpriteOrder.begin() + last;
+		const std::vector<SpriteEntry> & sprites = packet.Sprites;
+		switch(packet.SortingMode)
+		{
+		case SpriteSortingMode::BackToFront:
+			std::sort(begin, end, [&sprites](uint32 a, uint32 b) -> bool
 			{
-				if(start_line[i] > FIRST_REAL_ASCII_CHAR)
-				{
-					glBindTexture(GL_TEXTURE_2D, textures[start_line[i]]);
-
-					//Set attributes and buffers
-					glVertexAttribPointer(m_VertexID, 4, GL_FLOAT, 0, 0,
-						reinterpret_cast<GLvoid*>(&m_VertexBuffer.at(0)));
-					glVertexAttribPointer(m_UVID, 2, GL_FLOAT, 0, 0, 
-						reinterpret_cast<GLvoid*>(&m_UvCoordBuffer.at(0)));
-					glVertexAttribPointer(m_IsHUDID, 1, GL_FLOAT, 0, 0,
-						reinterpret_cast<GLvoid*>(&m_IsHUDBuffer.at(0)));
-					glVertexAttribPointer(m_ColorID, 4, GL_FLOAT, 0, 0,
-						reinterpret_cast<GLvoid*>(&m_ColorBuffer.at(0)));
-					glDrawArrays(GL_TRIANGLES, startIndex * 6, 6);
-				}
-				++startIndex;
-			}
+				return sprites[a].depth < sprites[b].depth;
+			});
+			break;
+		case SpriteSortingMode::FrontToBack:
+			std::sort(begin, end, [&sprites](uint32 a, uint32 b) -> bool
+			{
+				return sprites[a].depth > sprites[b].depth;
+			});
+			break;
+		case SpriteSortingMode::TextureID:
+			std::sort(begin, end, [&sprites](uint32 a, uint32 b) -> bool
+			{
+				return sprites[a].textureID < sprites[b].textureID;
+			});
+			break;
+		default:
+			//Checked by SetSpriteSortingMode, jobs can't log.
+			break;
 		}
 	}
 
-	void SpriteBatch::CreateSpriteQuads()
-	{	
-		//for every sprite that has to be drawn, push back all vertices 
-		//(VERTEX_AMOUNT per sprite) into the vertexbuffer and all uvcoords 
-		//(UV_AMOUNT per sprite) into the uvbuffer and the isHUD bool
+	void SpriteBatch::WriteQuad(
+		const mat4 & worldMat,
+		const vec2 & dimensions,
+		const vec4 & uvRect,
+		const Color & color,
+		bool bIsHud,
+		vec4 * vertices,
+		float32 * uvs,
+		float32 * isHUD,
+		Color * colors
+		)
+	{
+		//uvRect holds left, right, bottom and top.
 		/*
 		*  TL    TR
-		*   0----1 
-		*   |   /| 
+		*   0----1
+		*   |   /|
 		*   |  / |
 		*   | /  |
 		*   |/   |
 		*   2----3
 		*  BL    BR
 		*/
+		mat4 transformMat = Transpose(worldMat);
 
-		for(const SpriteInfo* sprite : m_SpriteQueue)
-		{
-			//Push back all vertices
-			
-			mat4 transformMat = Transpose(sprite->transformPtr->GetWorldMatrix());
+		vec4 TL = vec4(0, dimensions.y, 0, 1);
+		Mul(TL, transformMat, TL);
+
+		vec4 TR = vec4(dimensions.x, dimensions.y, 0, 1);
+		Mul(TR, transformMat, TR);
 
-			vec4 TL = vec4(0, sprite->vertices.y, 0, 1);
-			Mul(TL, transformMat, TL);
+		vec4 BL = vec4(0, 0, 0, 1);
+		Mul(BL, transformMat, BL);
 
-			vec4 TR = vec4(sprite->vertices.x, sprite->vertices.y, 0, 1);
-			Mul(TR, transformMat, TR);
+		vec4 BR = vec4(dimensions.x, 0, 0, 1);
+		Mul(BR, transformMat, BR);
 
-			vec4 BL = vec4(0, 0, 0, 1);
-			Mul(BL, transformMat, BL);
+		//0, 1, 2
+		vertices[0] = TL;
+		vertices[1] = TR;
+		vertices[2] = BL;
 
-			vec4 BR = vec4(sprite->vertices.x, 0, 0, 1);
-			Mul(BR, transformMat, BR);
+		//1, 3, 2
+		vertices[3] = TR;
+		vertices[4] = BR;
+		vertices[5] = BL;
 
-			//0
-			m_VertexBuffer.push_back(TL);
+		float32 left = uvRect.x;
+		float32 right = uvRect.y;
+		float32 bottom = uvRect.z;
+		float32 top = uvRect.w;
 
-			//1
-			m_VertexBuffer.push_back(TR);
+		//0
+		uvs[0] = left;
+		uvs[1] = top;
 
-			//2
-			m_VertexBuffer.push_back(BL);
+		//1
+		uvs[2] = right;
+		uvs[3] = top;
 
-			//1
-			m_VertexBuffer.push_back(TR);
+		//2
+		uvs[4] = left;
+		uvs[5] = bottom;
 
-			//3
-			m_VertexBuffer.push_back(BR);
+		//1
+		uvs[6] = right;
+		uvs[7] = top;
 
-			//2
-			m_VertexBuffer.push_back(BL);
+		//3
+		uvs[8] = right;
+		uvs[9] = bottom;
+
+		//2
+		uvs[10] = left;
+		uvs[11] = bottom;
+
+		//bool & color buffer
+		for(uint32 i = 0; i < 6; ++i)
+		{
+			isHUD[i] = float32(bIsHud);
+			//rgba
+			colors[i] = color;
+		}
+	}
 
-			//Push back all uv's
+	void SpriteBatch::SubmitPacket()
+	{
+		//Draws the packet of the previous frame. Right after pipelining
+		//was turned on there is none yet, then the newest packet is drawn
+		//now and once more next frame, so no frame is left empty.
+		RenderPacket & previous = m_Packets[m_RecordPacket];
+		if(previous.bIsReady)
+		{
+			previous.Build.Wait();
+			DrawPacket(previous);
+			ReleasePacket(previous);
+			return;
+		}
 
-			//0
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y + sprite->uvCoords.w);
+		RenderPacket & newest = m_Packets[1 - m_RecordPacket];
+		if(newest.bIsReady)
+		{
+			newest.Build.Wait();
+			DrawPacket(newest);
+		}
+	}
 
-			//1
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x + sprite->uvCoords.z);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y + sprite->uvCoords.w);
+	void SpriteBatch::ReleasePacket(RenderPacket & packet)
+	{
+		packet.Build.Wait();
 
-			//2
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y);
+		if(!packet.ReleasedTextures.empty())
+		{
+			glDeleteTextures(
+				GLsizei(packet.ReleasedTextures.size()),
+				&packet.ReleasedTextures[0]
+				);
+		}
+		if(!packet.ReleasedFrameBuffers.empty())
+		{
+			glDeleteFramebuffers(
+				GLsizei(packet.ReleasedFrameBuffers.size()),
+				&packet.ReleasedFrameBuffers[0]
+				);
+		}
+
+		//Cleared, not freed, the next frame records into the same memory.
+		packet.Sprites.clear();
+		packet.Glyphs.clear();
+		packet.Texts.clear();
+		packet.Passes.clear();
+		packet.DebugPrimitives.clear();
+		packet.SpriteOrder.clear();
+		packet.VertexBuffer.clear();
+		packet.UvCoordBuffer.clear();
+		packet.IsHUDBuffer.clear();
+		packet.ColorBuffer.clear();
+		packet.ReleasedTextures.clear();
+		packet.ReleasedFrameBuffers.clear();
+		packet.bIsReady = false;
+	}
+
+	void SpriteBatch::DiscardPackets()
+	{
+		ReleasePacket(m_Packets[m_RecordPacket]);
+		ReleasePacket(m_Packets[1 - m_RecordPacket]);
+	}
+
+	void SpriteBatch::BenchmarkQuadGeneration(uint32 spriteCount)
+	{
+		//A grid of sprites, each with its own world matrix.
+		RenderPacket & packet = GetRecordPacket();
+		SpriteEntry sprite;
+		sprite.uvCoords = vec4(0, 0, 1, 1);
+		sprite.vertices = vec2(32, 32);
+		sprite.colorMultiplier = Color::White;
+		sprite.textureID = 0;
+		sprite.bIsHud = false;
+		for(uint32 s = 0 ; s < spriteCount ; ++s)
+		{
+			sprite.worldMatrix = Translate(vec3(
+				float32(s % 64) * sprite.vertices.x,
+				float32(s / 64) * sprite.vertices.y,
+				0
+				));
+			sprite.depth = float32(s);
+			packet.Sprites.push_back(sprite);
+		}
+		BuildPacket(packet);
+
+		JobSystem::GetInstance()->Benchmark(
+			_T("SpriteBatch quads"),
+			0, spriteCount, QUAD_GRAIN_SIZE,
+			[&packet](uint32 first, uint32 last)
+		{
+			WriteSpriteQuads(packet, first, last);
+		});
+
+		ReleasePacket(packet);
+	}
+
+	SpriteBatch::RenderPacket * SpriteBatch::GetNewestPacket()
+	{
+		RenderPacket & recording = m_Packets[m_RecordPacket];
+		if(!recording.bIsReady && !recording.Passes.empty())
+		{
+			//Cached layers were recorded, the frame isn't flushed yet.
+			return &recording;
+		}
+		RenderPacket & latest = m_Packets[1 - m_RecordPacket];
+		if(latest.bIsReady)
+		{
+			return &latest;
+		}
+		if(recording.bIsReady)
+		{
+			return &recording;
+		}
+		return nullptr;
+	}
 
-			//1
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x + sprite->uvCoords.z);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y + sprite->uvCoords.w);
+	void SpriteBatch::DeleteTextures(uint32 count, const GLuint * pTextures)
+	{
+		//Packets are released in the order they were recorded, so the
+		//newest one is released after every packet that may use these.
+		RenderPacket * pPacket = m_pSpriteBatch != nullptr
+			? m_pSpriteBatch->GetNewestPacket()
+			: nullptr;
+		if(pPacket == nullptr)
+		{
+			glDeleteTextures(GLsizei(count), pTextures);
+			return;
+		}
+		pPacket->ReleasedTextures.insert(
+			pPacket->ReleasedTextures.end(),
+			pTextures,
+			pTextures + count
+			);
+	}
 
-			//3
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x + sprite->uvCoords.z);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y);
+	void SpriteBatch::DeleteFrameBuffer(GLuint frameBuffer)
+	{
+		RenderPacket * pPacket = m_pSpriteBatch != nullptr
+			? m_pSpriteBatch->GetNewestPacket()
+			: nullptr;
+		if(pPacket == nullptr)
+		{
+			glDeleteFramebuffers(1, &frameBuffer);
+			return;
+		}
+		pPacket->ReleasedFrameBuffers.push_back(frameBuffer);
+	}
 
-			//2
-			m_UvCoordBuffer.push_back(sprite->uvCoords.x);
-			m_UvCoordBuffer.push_back(sprite->uvCoords.y);
+	void SpriteBatch::DrawPacket(const RenderPacket & packet)
+	{
+		Begin();
+		SetPacketBuffers(packet);
 
-			//bool & color buffer
-			for(uint32 i = 0; i < 6; ++i)
+		//Cached layers were recorded first, their textures
+		//are drawn as sprites of the scene pass.
+		for(const auto & pass : packet.Passes)
+		{
+			if(pass.frameBufferID != 0)
+			{
+				DrawLayerPass(packet, pass);
+			}
+			else
 			{
-				m_IsHUDBuffer.push_back(float32(sprite->bIsHud));
-				//rgba
-				m_ColorBuffer.push_back(sprite->colorMultiplier);
+				DrawScenePass(packet, pass);
 			}
 		}
+
+		End();
+
+		DebugDraw::GetInstance()->Flush(packet.DebugPrimitives, packet.DebugMatrix);
 	}
 
-	void SpriteBatch::CreateTextQuads()
+	void SpriteBatch::DrawLayerPass(const RenderPacket & packet, const RenderPass & pass)
 	{
-		//for every sprite that has to be drawn, push back all vertices 
-		//(VERTEX_AMOUNT per sprite) into the vertexbuffer and all uvcoords 
-		//(UV_AMOUNT per sprite) into the uvbuffer and the isHUD bool
-		/*
-		*  TL    TR
-		*   0----1 
-		*   |   /| 
-		*   |  / |
-		*   | /  |
-		*   |/   |
-		*   2----3
-		*  BL    BR
-		*/
-		for(const TextInfo* text : m_TextQueue)
+		glBindFramebuffer(GL_FRAMEBUFFER, pass.frameBufferID);
+		glViewport(0, 0, pass.targetDimensions.x, pass.targetDimensions.y);
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		//Accumulate coverage in the alpha channel instead of squaring it,
+		//so the layer blends over the scene like its members would.
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+			GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+		SetUniforms(pass.scaleMatrix, pass.viewInverseMatrix, pass.projectionMatrix);
+		DrawSprites(packet, pass.firstSprite, pass.firstSprite + pass.spriteCount);
+		DrawTexts(packet, pass);
+
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glClearColor(0.f, 0.f, 0.f, 1.0f);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		auto graphics = GraphicsManager::GetInstance();
+		glViewport(
+			graphics->GetHorizontalViewportOffset(),
+			graphics->GetVerticalViewportOffset(),
+			graphics->GetViewportWidth(),
+			graphics->GetViewportHeight()
+			);
+	}
+
+	void SpriteBatch::DrawScenePass(const RenderPacket & packet, const RenderPass & pass)
+	{
+		uint32 first = pass.firstSprite;
+		uint32 last = pass.firstSprite + pass.spriteCount;
+
+		//World sprites are drawn into the scaled scene target, HUD sprites
+		//and all text are drawn afterwards at native resolution. Viewport
+		//and working resolution stay the same, so input needs no changes.
+		if(pass.bIsScaled && UpdateSceneTarget())
 		{
-			//Variables per textcomponent
-			mat4 transformMat, offsetMatrix; 
-			const mat4& worldMat = text->transformPtr->GetWorldMatrix();
-			int32 line_counter(0);
-			int32 offsetX(text->horizontalTextOffset.at(line_counter));
-			int32 offsetY(0);
-			int32 fontHeight(text->font->GetMaxLetterHeight() + text->font->GetMinLetterHeight());
-			for(auto it : text->text)
-			{
-				const CharacterInfo& charInfo = text->font->GetCharacterInfo(static_cast<suchar>(it));
-				offsetMatrix = Translate
-					(vec3(
-						offsetX, 
-						offsetY + charInfo.letterDimensions.y + text->textHeight - fontHeight, 
-						0));
-				offsetX += charInfo.letterDimensions.x;
+			auto graphics = GraphicsManager::GetInstance();
+			ivec2 sceneDimensions(
+				int32(graphics->GetViewportWidth() * pass.resolutionFactor),
+				int32(graphics->GetViewportHeight() * pass.resolutionFactor)
+				);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, m_SceneFrameBufferID);
+			glViewport(0, 0, sceneDimensions.x, sceneDimensions.y);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			SetUniforms(pass.scaleMatrix, pass.viewInverseMatrix, pass.projectionMatrix);
+			DrawSprites(packet, first, pass.firstHUDSprite);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(
+				graphics->GetHorizontalViewportOffset(),
+				graphics->GetVerticalViewportOffset(),
+				graphics->GetViewportWidth(),
+				graphics->GetViewportHeight()
+				);
+
+			DrawSceneTarget(vec2(
+				float32(sceneDimensions.x) / float32(m_SceneTextureDimensions.x),
+				float32(sceneDimensions.y) / float32(m_SceneTextureDimensions.y)
+				));
+			SetPacketBuffers(packet);
+
+			first = pass.firstHUDSprite;
+		}
 
-				transformMat = Transpose(worldMat * offsetMatrix);
+		SetUniforms(pass.scaleMatrix, pass.viewInverseMatrix, pass.projectionMatrix);
+		DrawSprites(packet, first, last);
+		DrawTexts(packet, pass);
+	}
 
-				vec4 TL = vec4(0, charInfo.vertexDimensions.y, 0, 1);
-				Mul(TL, transformMat, TL);
+	void SpriteBatch::Begin()
+	{
+		m_ShaderPtr->Bind();
 
-				vec4 TR = vec4(charInfo.vertexDimensions.x, charInfo.vertexDimensions.y, 0, 1);
-				Mul(TR, transformMat, TR);
+		//[TODO] Test android!
+		glEnableVertexAttribArray(m_VertexID);
+		glEnableVertexAttribArray(m_UVID);
+		glEnableVertexAttribArray(m_IsHUDID);
+		glEnableVertexAttribArray(m_ColorID);
 
-				vec4 BL = vec4(0, 0, 0, 1);
-				Mul(BL, transformMat, BL);
+		glUniform1i(m_TextureSamplerID, 0);
+	}
 
-				vec4 BR = vec4(charInfo.vertexDimensions.x, 0, 0, 1);
-				Mul(BR, transformMat, BR);
+	void SpriteBatch::SetBuffers(
+		const vec4 * vertices,
+		const float32 * uvs,
+		const float32 * isHUD,
+		const Color * colors
+		)
+	{
+		glVertexAttribPointer(m_VertexID, 4, GL_FLOAT, 0, 0,
+			reinterpret_cast<const GLvoid*>(vertices));
+		glVertexAttribPointer(m_UVID, 2, GL_FLOAT, 0, 0,
+			reinterpret_cast<const GLvoid*>(uvs));
+		glVertexAttribPointer(m_IsHUDID, 1, GL_FLOAT, 0, 0,
+			reinterpret_cast<const GLvoid*>(isHUD));
+		glVertexAttribPointer(m_ColorID, 4, GL_FLOAT, 0, 0,
+			reinterpret_cast<const GLvoid*>(colors));
+	}
 
-				//0
-				m_VertexBuffer.push_back(TL);
+	void SpriteBatch::SetPacketBuffers(const RenderPacket & packet)
+	{
+		if(!packet.VertexBuffer.empty())
+		{
+			SetBuffers(
+				&packet.VertexBuffer[0],
+				&packet.UvCoordBuffer[0],
+				&packet.IsHUDBuffer[0],
+				&packet.ColorBuffer[0]
+				);
+		}
+	}
 
-				//1
-				m_VertexBuffer.push_back(TR);
+	void SpriteBatch::SetUniforms(
+		const mat4 & scaleMat,
+		const mat4 & viewInverseMat,
+		const mat4 & projectionMat
+		)
+	{
+		glUniformMatrix4fv(m_ScalingID, 1, GL_FALSE, ToPointerValue(scaleMat));
+		glUniformMatrix4fv(m_ViewInverseID, 1, GL_FALSE, ToPointerValue(viewInverseMat));
+		glUniformMatrix4fv(m_ProjectionID, 1, GL_FALSE, ToPointerValue(projectionMat));
+	}
 
-				//2
-				m_VertexBuffer.push_back(BL);
+	void SpriteBatch::SetTargetUniforms(const vec2 & dimensions)
+	{
+		//[0, dimensions] maps straight onto the render target,
+		//no scaling and no camera.
+		SetUniforms(Scale(1.0f, 1.0f, 0), mat4(), GetTargetProjection(dimensions));
+	}
 
-				//1
-				m_VertexBuffer.push_back(TR);
+	mat4 SpriteBatch::GetTargetProjection(const vec2 & dimensions)
+	{
+		return mat4
+			(
+			2.0f / dimensions.x, 0, 0, -1,
+			0, 2.0f / dimensions.y, 0, -1,
+			0, 0, 0, 0,
+			0, 0, 0, 1
+			);
+	}
 
-				//3
-				m_VertexBuffer.push_back(BR);
+	void SpriteBatch::DrawSceneTarget(const vec2 & uvMax)
+	{
+		SetTargetUniforms(vec2(1, 1));
 
-				//2
-				m_VertexBuffer.push_back(BL);
+		const vec4 vertices[] =
+		{
+			vec4(0, 1, 0, 1),
+			vec4(1, 1, 0, 1),
+			vec4(0, 0, 0, 1),
+			vec4(1, 1, 0, 1),
+			vec4(1, 0, 0, 1),
+			vec4(0, 0, 0, 1)
+		};
+
+		const float32 uvCoords[] =
+		{
+			0, uvMax.y,
+			uvMax.x, uvMax.y,
+			0, 0,
+			uvMax.x, uvMax.y,
+			uvMax.x, 0,
+			0, 0
+		};
+
+		float32 isHUD[6];
+		Color colors[6];
+		for(uint32 i = 0; i < 6; ++i)
+		{
+			isHUD[i] = 1.0f;
+			colors[i] = Color::White;
+		}
+		SetBuffers(vertices, uvCoords, isHUD, colors);
 
-				//Push back all uv's
+		//The scene target is opaque, it replaces what is underneath.
+		glDisable(GL_BLEND);
+		FlushSprites(0, 1, m_SceneTextureID);
+		glEnable(GL_BLEND);
+	}
 
-				//0
-				m_UvCoordBuffer.push_back(0);
-				m_UvCoordBuffer.push_back(0);
+	bool SpriteBatch::UpdateSceneTarget()
+	{
+		//Allocated once at viewport size; lower factors only render into
+		//a smaller part of it, so changing the factor never reallocates.
+		ivec2 dimensions(
+			GraphicsManager::GetInstance()->GetViewportWidth(),
+			GraphicsManager::GetInstance()->GetViewportHeight()
+			);
+
+		if(dimensions.x <= 0 || dimensions.y <= 0)
+		{
+			return false;
+		}
 
-				//1
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.x);
-				m_UvCoordBuffer.push_back(0);
+		if(m_SceneFrameBufferID != 0 && dimensions == m_SceneTextureDimensions)
+		{
+			return true;
+		}
 
-				//2
-				m_UvCoordBuffer.push_back(0);
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.y);
+		DestroySceneTarget();
+
+		glGenTextures(1, &m_SceneTextureID);
+		glBindTexture(GL_TEXTURE_2D, m_SceneTextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y,
+			0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		glGenFramebuffers(1, &m_SceneFrameBufferID);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_SceneFrameBufferID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_TEXTURE_2D, m_SceneTextureID, 0);
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if(status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("SpriteBatch::UpdateSceneTarget: Could not create the scene target, \
+disabling dynamic resolution."), STARENGINE_LOG_TAG);
+			DestroySceneTarget();
+			ScaleSystem::GetInstance()->SetDynamicResolutionEnabled(false);
+			return false;
+		}
 
-				//1
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.x);
-				m_UvCoordBuffer.push_back(0);
+		m_SceneTextureDimensions = dimensions;
+		return true;
+	}
 
-				//3
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.x);
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.y);
+	void SpriteBatch::DestroySceneTarget()
+	{
+		if(m_SceneFrameBufferID != 0)
+		{
+			glDeleteFramebuffers(1, &m_SceneFrameBufferID);
+			m_SceneFrameBufferID = 0;
+		}
+		if(m_SceneTextureID != 0)
+		{
+			glDeleteTextures(1, &m_SceneTextureID);
+			m_SceneTextureID = 0;
+		}
+		m_SceneTextureDimensions = ivec2(0, 0);
+	}
+	
+	void SpriteBatch::DrawSprites(const RenderPacket & packet, uint32 first, uint32 last)
+	{
+		uint32 batchStart(first);
+		uint32 batchSize(0);
+		GLuint texture(0);
+		for(uint32 s = first ; s < last ; ++s)
+		{
+			//If != -> Flush
+			GLuint spriteTexture = packet.Sprites[packet.SpriteOrder[s]].textureID;
+			if(texture != spriteTexture)
+			{
+				FlushSprites(batchStart, batchSize, texture);
 
-				//2
-				m_UvCoordBuffer.push_back(0);
-				m_UvCoordBuffer.push_back(charInfo.uvDimensions.y);
+				batchStart += batchSize;
+				batchSize = 0;
 
-				//bool & color buffer
-				for(uint32 i = 0; i < 6; ++i)
-				{
-					m_IsHUDBuffer.push_back(float32(text->bIsHud));
-					//rgba
-					m_ColorBuffer.push_back(text->colorMultiplier);
-				}
+				texture = spriteTexture;
+			}
+			++batchSize;
+		}
+		FlushSprites(batchStart, batchSize, texture);
+	}
 
-				if(it == _T('\n'))
+	void SpriteBatch::FlushSprites(uint32 start, uint32 size, uint32 texture)
+	{
+		if(size > 0)
+		{
+			//[TODO] Check if this can be optimized
+			glBindTexture(GL_TEXTURE_2D, texture);
+			glDrawArrays(GL_TRIANGLES, start * 6, size * 6);
+		}
+	}
+
+	void SpriteBatch::End()
+	{
+		//Unbind attributes and buffers
+		glDisableVertexAttribArray(m_VertexID);
+		glDisableVertexAttribArray(m_UVID);
+		glDisableVertexAttribArray(m_IsHUDID);
+		glDisableVertexAttribArray(m_ColorID);
+
+		m_ShaderPtr->Unbind();
+	}
+
+	void SpriteBatch::DrawTexts(const RenderPacket & packet, const RenderPass & pass)
+	{
+		//One draw per character, the glyph quads follow the sprite quads.
+		uint32 firstGlyphQuad = uint32(packet.Sprites.size());
+		for(uint32 r = pass.firstRun ; r < pass.firstRun + pass.runCount ; ++r)
+		{
+			const TextRun & run = packet.Texts[r];
+			for(uint32 g = run.firstGlyph ; g < run.firstGlyph + run.glyphCount ; ++g)
+			{
+				GLuint texture = packet.Glyphs[g].textureID;
+				if(texture != 0)
 				{
-					offsetY -= text->font->GetMaxLetterHeight() + text->verticalSpacing;
-					++line_counter;
-					offsetX = text->horizontalTextOffset.at(line_counter);
+					glBindTexture(GL_TEXTURE_2D, texture);
+					glDrawArrays(GL_TRIANGLES, (firstGlyphQuad + g) * 6, 6);
 				}
 			}
 		}
 	}
 
-	void SpriteBatch::SortSprites(SpriteSortingMode mode)
+	void SpriteBatch::AddSpriteToQueue(const SpriteInfo* spriteInfo)
+	{
+		m_SpriteQueue.push_back(spriteInfo);
+	}
+
+	void SpriteBatch::AddTextToQueue(const TextInfo* text)
+	{
+		m_TextQueue.push_back(text);
+	}
+
+	void SpriteBatch::SetSpriteSortingMode(SpriteSortingMode mode)
 	{
 		switch(mode)
 		{
 		case SpriteSortingMode::BackToFront:
-			std::sort(m_SpriteQueue.begin(), m_SpriteQueue.end(), [](const SpriteInfo* a, const SpriteInfo* b) -> bool
-			{
-				return a->transformPtr->GetWorldPosition().l < b->transformPtr->GetWorldPosition().l;
-			});
-			break;
 		case SpriteSortingMode::FrontToBack:
-			std::sort(m_SpriteQueue.begin(), m_SpriteQueue.end(), [](const SpriteInfo* a, const SpriteInfo* b) -> bool
-			{
-				return a->transformPtr->GetWorldPosition().l > b->transformPtr->GetWorldPosition().l;
-			});
-			break;
 		case SpriteSortingMode::TextureID:
-			std::sort(m_SpriteQueue.begin(), m_SpriteQueue.end(), [](const SpriteInfo* a, const SpriteInfo* b) -> bool
-			{
-				return a->textureID < b->textureID;
-			});
+			m_SpriteSortingMode = mode;
 			break;
 		default:
-			Logger::GetInstance()->Log(false, _T("SpriteBatch::SortSprites: Please implement this SpriteSortingMode"));
+			Logger::GetInstance()->Log(false, _T("SpriteBatch::SetSpriteSortingMode: Please implement this SpriteSortingMode"));
 			break;
 		}
 	}
 
-	void SpriteBatch::AddSpriteToQueue(const SpriteInfo* spriteInfo)
+	void SpriteBatch::SetPipelined(bool pipelined)
 	{
-		m_SpriteQueue.push_back(spriteInfo);		
+		if(pipelined != m_bIsPipelined)
+		{
+			//Called during an update, the frame is recorded for
+			//the new mode at its end, so no frame is lost.
+			DiscardPackets();
+			m_bIsPipelined = pipelined;
+		}
 	}
 
-	void SpriteBatch::AddTextToQueue(const TextInfo* text)
+	bool SpriteBatch::IsPipelined() const
 	{
-		m_TextQueue.push_back(text);
+		return m_bIsPipelined;
 	}
 
-	void SpriteBatch::SetSpriteSortingMode(SpriteSortingMode mode)
+	uint32 SpriteBatch::GetFrameLatency() const
+	{
+		return m_bIsPipelined ? 1 : 0;
+	}
+
+	void SpriteBatch::BeginCachedLayer(
+		GLuint frameBufferID,
+		const ivec2 & textureDimensions,
+		const vec2 & layerDimensions,
+		const mat4 & layerInverseWorld
+		)
+	{
+		if(m_bIsRenderingCachedLayer)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SpriteBatch::BeginCachedLayer: Already rendering a cached layer."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		m_bIsRenderingCachedLayer = true;
+		m_CachedLayerFrameBufferID = frameBufferID;
+		m_CachedLayerTextureDimensions = textureDimensions;
+		m_CachedLayerDimensions = layerDimensions;
+		m_CachedLayerInverseWorld = layerInverseWorld;
+
+		m_StashedSpriteQueue.swap(m_SpriteQueue);
+		m_StashedTextQueue.swap(m_TextQueue);
+	}
+
+	void SpriteBatch::EndCachedLayer()
+	{
+		if(!m_bIsRenderingCachedLayer)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SpriteBatch::EndCachedLayer: No cached layer is being rendered."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		//Drawn into the framebuffer of the layer before the scene pass
+		//of the frame, which draws the layer texture.
+		RenderPass pass;
+		pass.scaleMatrix = Scale(1.0f, 1.0f, 0);
+		pass.projectionMatrix = GetTargetProjection(m_CachedLayerDimensions);
+		pass.frameBufferID = m_CachedLayerFrameBufferID;
+		pass.targetDimensions = m_CachedLayerTextureDimensions;
+		RecordPass(GetRecordPacket(), pass, &m_CachedLayerInverseWorld);
+
+		m_SpriteQueue.swap(m_StashedSpriteQueue);
+		m_TextQueue.swap(m_StashedTextQueue);
+
+		m_bIsRenderingCachedLayer = false;
+	}
+
+	bool SpriteBatch::IsRenderingCachedLayer() const
 	{
-		m_SpriteSortingMode = mode;
+		return m_bIsRenderingCachedLayer;
 	}
 }
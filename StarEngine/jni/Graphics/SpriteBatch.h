@@ -5,6 +5,8 @@
 #include "Shader.h"
 #include "../Components/Graphics/SpriteComponent.h"
 #include "../Components/Graphics/TextComponent.h"
+#include "../Helpers/Debug/DebugDraw.h"
+#include "../Helpers/JobSystem.h"
 
 namespace star
 {
@@ -22,38 +24,196 @@ namespace star
 		static SpriteBatch * GetInstance();
 
 		void Initialize();
+		//Records the queued sprites, texts and debug primitives into a
+		//render packet. Without pipelining the packet is drawn right away,
+		//otherwise its quads are built on the JobSystem and it is drawn
+		//by SubmitPacket during the next frame.
 		void Flush();
 		void AddSpriteToQueue(const SpriteInfo* spriteInfo);
 		void AddTextToQueue(const TextInfo* text);
 
 		void SetSpriteSortingMode(SpriteSortingMode mode);
 
+		//Pipelined frames are recorded at the end of StarEngine::Update
+		//and drawn one frame later, so the quads of a frame are built
+		//while the main thread simulates the next one.
+		void SetPipelined(bool pipelined);
+		bool IsPipelined() const;
+		//Frames between recording a frame and drawing it, 1 when pipelined.
+		uint32 GetFrameLatency() const;
+		//Draws the packet recorded during the previous frame.
+		void SubmitPacket();
+		//Waits for pending packet builds and drops their packets.
+		void DiscardPackets();
+
+		//Logs how quad generation for spriteCount sprites scales over
+		//the workers of the JobSystem. Like JobSystem::Benchmark it may
+		//only be called while no jobs are queued, so no packet may be
+		//building, StarEngine::BenchmarkJobSystem takes care of that.
+		void BenchmarkQuadGeneration(uint32 spriteCount);
+
+		//GL names that a recorded packet may still draw with are only
+		//deleted once that packet has been submitted or discarded.
+		static void DeleteTextures(uint32 count, const GLuint * pTextures);
+		static void DeleteFrameBuffer(GLuint frameBuffer);
+
+		void BeginCachedLayer(
+			GLuint frameBufferID,
+			const ivec2 & textureDimensions,
+			const vec2 & layerDimensions,
+			const mat4 & layerInverseWorld
+			);
+		void EndCachedLayer();
+		bool IsRenderingCachedLayer() const;
+
 	private:
+		//Copy of a queued sprite, taken when its pass is recorded.
+		struct SpriteEntry
+		{
+			mat4 worldMatrix;
+			vec4 uvCoords;
+			vec2 vertices;
+			Color colorMultiplier;
+			float32 depth;
+			uint32 textureID;
+			bool bIsHud;
+		};
+
+		//A character of a queued text, laid out against its font when
+		//the pass is recorded. Characters that aren't drawn have no texture.
+		struct GlyphEntry
+		{
+			vec2	offset,
+					vertexDimensions,
+					uvDimensions;
+			uint32 textureID;
+		};
+
+		struct TextRun
+		{
+			mat4 worldMatrix;
+			Color colorMultiplier;
+			uint32	firstGlyph,
+					glyphCount;
+			bool bIsHud;
+		};
+
+		//Sprites and texts drawn into one target with one set of uniforms.
+		//A frame has a pass per redrawn cached layer and ends with the scene.
+		struct RenderPass
+		{
+			RenderPass();
+
+			mat4	scaleMatrix,
+					viewInverseMatrix,
+					projectionMatrix;
+			GLuint frameBufferID;
+			ivec2 targetDimensions;
+			uint32	firstSprite,
+					spriteCount,
+					firstHUDSprite,
+					firstRun,
+					runCount;
+			float32 resolutionFactor;
+			bool bIsScaled;
+		};
+
+		struct RenderPacket
+		{
+			RenderPacket();
+
+			std::vector<SpriteEntry> Sprites;
+			std::vector<GlyphEntry> Glyphs;
+			std::vector<TextRun> Texts;
+			std::vector<RenderPass> Passes;
+			std::vector<PrimitiveInfo> DebugPrimitives;
+			mat4 DebugMatrix;
+			SpriteSortingMode SortingMode;
+
+			//Sprite order after sorting, and the quads built from it.
+			//Sprite quads come first, then one quad per glyph.
+			std::vector<uint32> SpriteOrder;
+			std::vector<vec4> VertexBuffer;
+			std::vector<float32> UvCoordBuffer;
+			std::vector<float32> IsHUDBuffer;
+			std::vector<Color> ColorBuffer;
+
+			std::vector<GLuint>	ReleasedTextures,
+								ReleasedFrameBuffers;
+			TaskGroup Build;
+			bool bIsReady;
+
+		private:
+			RenderPacket(const RenderPacket &);
+			RenderPacket & operator=(const RenderPacket &);
+		};
+
 		SpriteBatch();
+		RenderPacket & GetRecordPacket();
+		void RecordPass(
+			RenderPacket & packet,
+			RenderPass & pass,
+			const mat4 * pLayerInverseWorld
+			);
+		RenderPacket * GetNewestPacket();
+		void ReleasePacket(RenderPacket & packet);
+		static void BuildPacket(RenderPacket & packet);
+		static void SortSprites(RenderPacket & packet, uint32 first, uint32 last);
+		static void WriteSpriteQuads(RenderPacket & packet, uint32 first, uint32 last);
+		static void WriteQuad(
+			const mat4 & worldMat,
+			const vec2 & dimensions,
+			const vec4 & uvRect,
+			const Color & color,
+			bool bIsHud,
+			vec4 * vertices,
+			float32 * uvs,
+			float32 * isHUD,
+			Color * colors
+			);
+
+		void DrawPacket(const RenderPacket & packet);
+		void DrawLayerPass(const RenderPacket & packet, const RenderPass & pass);
+		void DrawScenePass(const RenderPacket & packet, const RenderPass & pass);
 		void Begin();
 		void End();
-		void CreateSpriteQuads();
-		void CreateTextQuads();
-		void SortSprites(SpriteSortingMode mode);
-		void DrawSprites();
+		void SetBuffers(
+			const vec4 * vertices,
+			const float32 * uvs,
+			const float32 * isHUD,
+			const Color * colors
+			);
+		void SetPacketBuffers(const RenderPacket & packet);
+		void DrawSprites(const RenderPacket & packet, uint32 first, uint32 last);
 		void FlushSprites(uint32 start, uint32 size, uint32 texture);
-		void DrawTextSprites();
+		void DrawTexts(const RenderPacket & packet, const RenderPass & pass);
+		void SetUniforms(
+			const mat4 & scaleMat,
+			const mat4 & viewInverseMat,
+			const mat4 & projectionMat
+			);
+		void SetTargetUniforms(const vec2 & dimensions);
+		static mat4 GetTargetProjection(const vec2 & dimensions);
+		void DrawSceneTarget(const vec2 & uvMax);
+		bool UpdateSceneTarget();
+		void DestroySceneTarget();
 
 		static SpriteBatch * m_pSpriteBatch;
 		static const uint32 BATCHSIZE = 50;
 		static const uint32 VERTEX_AMOUNT = 18;
 		static const uint32 UV_AMOUNT = 12;
 		static const uint32 FIRST_REAL_ASCII_CHAR = 31;
+		static const uint32 QUAD_GRAIN_SIZE = 128;
 
 		std::vector<const SpriteInfo*> m_SpriteQueue;
 		std::vector<const TextInfo*> m_TextQueue;
 
-		//[TODO] Check if can be changed to vector<vec4 or vec2>
-		std::vector<vec4> m_VertexBuffer;
-		std::vector<float32> m_UvCoordBuffer;
-		std::vector<float32> m_IsHUDBuffer;
-		std::vector<Color> m_ColorBuffer;
-		
+		//Recorded into m_Packets[m_RecordPacket], the other one is the
+		//packet of the previous frame while pipelining.
+		RenderPacket m_Packets[2];
+		uint32 m_RecordPacket;
+		bool m_bIsPipelined;
+
 		GLuint m_VertexID,
 			   m_UVID,
 			   m_IsHUDID;
@@ -68,6 +228,23 @@ namespace star
 
 		SpriteSortingMode m_SpriteSortingMode;
 
+		//Queues of the main pass are parked here while a cached layer
+		//records its members into a pass of its own.
+		std::vector<const SpriteInfo*> m_StashedSpriteQueue;
+		std::vector<const TextInfo*> m_StashedTextQueue;
+
+		bool m_bIsRenderingCachedLayer;
+		GLuint m_CachedLayerFrameBufferID;
+		ivec2 m_CachedLayerTextureDimensions;
+		vec2 m_CachedLayerDimensions;
+		mat4 m_CachedLayerInverseWorld;
+
+		//Dynamic resolution: world sprites are rendered into this target
+		//at a fraction of the viewport and upscaled, HUD stays native.
+		GLuint	m_SceneFrameBufferID,
+				m_SceneTextureID;
+		ivec2 m_SceneTextureDimensions;
+
 		SpriteBatch(const SpriteBatch& yRef);
 		SpriteBatch(SpriteBatch&& yRef);
 		SpriteBatch& operator=(const SpriteBatch& yRef);
@@ -1,4 +1,5 @@
 #include "Texture2D.h"
+#include "SpriteBatch.h"
 
 namespace star
 {
@@ -34,7 +35,7 @@ namespace star
 	{
 		if(mTextureId != 0)
 		{
-			glDeleteTextures(1, &mTextureId);
+			SpriteBatch::DeleteTextures(1, &mTextureId);
 			mTextureId = 0;
 		}
 		mWidth = 0;
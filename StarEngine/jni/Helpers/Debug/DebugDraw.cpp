@@ -275,29 +275,56 @@ namespace star
 		m_VertexBuffer.push_back(tempInfo);
 	}
 
-	void DebugDraw::Begin()
+	mat4 DebugDraw::GetMatrix() const
 	{
-		glUseProgram(m_Shader->GetID());
-		
 		float32 scaleValue(ScaleSystem::GetInstance()->GetScale());
 		mat4 scaleMat(Scale(scaleValue, scaleValue, 1.0f));
+		return scaleMat *
+			GraphicsManager::GetInstance()->GetViewInverseProjectionMatrix();
+	}
+
+	void DebugDraw::Begin(const mat4 & matrix)
+	{
+		glUseProgram(m_Shader->GetID());
 
 		glUniformMatrix4fv(
 			m_MVPLocation,
 			1, GL_FALSE,
-			ToPointerValue(
-				scaleMat *
-				GraphicsManager::GetInstance()->GetViewInverseProjectionMatrix()
-				)
+			ToPointerValue(matrix)
 			);
 	}
 
 	void DebugDraw::Flush()
 	{
+		Flush(m_VertexBuffer, GetMatrix());
+		m_VertexBuffer.clear();
+	}
+
+	void DebugDraw::TakePrimitives(
+		std::vector<PrimitiveInfo> & primitivesOut,
+		mat4 & matrixOut
+		)
+	{
+		primitivesOut.clear();
+		primitivesOut.swap(m_VertexBuffer);
+		matrixOut = GetMatrix();
+	}
+
+	void DebugDraw::Flush(
+		const std::vector<PrimitiveInfo> & primitives,
+		const mat4 & matrix
+		)
+	{
 #ifdef DESKTOP
-		Begin();
+		if(primitives.empty())
+		{
+			return;
+		}
 
-		for(const auto & elem : m_VertexBuffer)
+		Begin(matrix);
+
+		//The opacities are the ones set when the primitive was queued.
+		for(const auto & elem : primitives)
 		{
 			glEnableVertexAttribArray(m_PositionLocation);
 			glVertexAttribPointer(m_PositionLocation, 2, GL_FLOAT, 
@@ -305,19 +332,19 @@ namespace star
 
 			if ((elem.primitiveType & Triangles) != 0)
 			{
-				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, m_DrawOpTriangles);
+				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, elem.opacityTriangles);
 				glDrawArrays(GL_TRIANGLE_FAN, 0, elem.count);
 			}
 
 			if ((elem.primitiveType & Lines) != 0)
 			{
-				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, m_DrawOpLines);
+				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, elem.opacityLines);
 				glDrawArrays(GL_LINE_LOOP, 0, elem.count);
 			}
 
 			if ((elem.primitiveType & Points) != 0)
 			{
-				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, m_DrawOpPoints);
+				glUniform4f(m_ColorLocation, elem.color.r, elem.color.g, elem.color.b, elem.opacityPoints);
 				//[TODO] only works for windows..
 				glPointSize(m_PointSize);
 				glDrawArrays(GL_POINTS, 0, elem.count);
@@ -332,7 +359,6 @@ namespace star
 	void DebugDraw::End()
 	{
 		glUseProgram(0);
-		m_VertexBuffer.clear();
 	}
 
 }
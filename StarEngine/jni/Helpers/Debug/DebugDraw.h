@@ -116,6 +116,16 @@ namespace star
 		void SetDrawOpacityPoints(float32 opacity);
 
 		void Flush();  
+		//Hands the queued primitives and the matrix to draw them with
+		//to a render packet, which draws them with the Flush below.
+		void TakePrimitives(
+			std::vector<PrimitiveInfo> & primitivesOut,
+			mat4 & matrixOut
+			);
+		void Flush(
+			const std::vector<PrimitiveInfo> & primitives,
+			const mat4 & matrix
+			);
   
 	private:  
 		static const uint32 MAX_VERTICES = 64;
@@ -145,7 +155,8 @@ namespace star
 			const Color& color
 			);
 		
-		void Begin();
+		mat4 GetMatrix() const;
+		void Begin(const mat4 & matrix);
 		void End();
 
 		std::vector<PrimitiveInfo> m_VertexBuffer;
@@ -0,0 +1,185 @@
+#include "FramePacer.h"
+#include "../TimeManager.h"
+#include <thread>
+
+#ifdef _WIN32
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace star
+{
+#ifdef DESKTOP
+	const uint32 FramePacer::DEFAULT_FRAME_RATE = 0;
+#else
+	const uint32 FramePacer::DEFAULT_FRAME_RATE = 60;
+#endif
+
+	FramePacer::FramePacer()
+		: m_TargetFrameTime(0)
+		, m_SpinTime(0.002)
+		, m_FrameStart(0)
+		, m_AwakeTime(1.0)
+		, m_AwakeUntil(0)
+		, m_SampleIndex(0)
+		, m_SampleCount(0)
+		, m_bLowPowerMode(false)
+	{
+#ifdef _WIN32
+		//Sleep is only accurate to the system timer resolution.
+		timeBeginPeriod(1);
+#endif
+		SetTargetFrameRate(DEFAULT_FRAME_RATE);
+		m_FrameStart = GetTime();
+	}
+
+	FramePacer::~FramePacer()
+	{
+#ifdef _WIN32
+		timeEndPeriod(1);
+#endif
+	}
+
+	void FramePacer::SetTargetFrameRate(uint32 framesPerSecond)
+	{
+		m_TargetFrameTime = framesPerSecond > 0
+			? 1.0 / float64(framesPerSecond)
+			: 0;
+	}
+
+	uint32 FramePacer::GetTargetFrameRate() const
+	{
+		return m_TargetFrameTime > 0
+			? uint32(1.0 / m_TargetFrameTime + 0.5)
+			: 0;
+	}
+
+	float64 FramePacer::GetTargetFrameTime() const
+	{
+		return m_TargetFrameTime;
+	}
+
+	void FramePacer::SetSpinTime(float64 seconds)
+	{
+		m_SpinTime = seconds;
+	}
+
+	void FramePacer::EndFrame()
+	{
+		if(m_TargetFrameTime > 0)
+		{
+			float64 deadline = m_FrameStart + m_TargetFrameTime;
+			float64 remaining = deadline - GetTime();
+			if(remaining > m_SpinTime)
+			{
+				SleepFor(remaining - m_SpinTime);
+			}
+			while(GetTime() < deadline)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		//A late frame doesn't shorten the next one.
+		float64 frameEnd = GetTime();
+		AddSample(frameEnd - m_FrameStart);
+		m_FrameStart = frameEnd;
+	}
+
+	void FramePacer::Restart()
+	{
+		m_FrameStart = GetTime();
+	}
+
+	float64 FramePacer::GetAverageFrameTime() const
+	{
+		if(m_SampleCount == 0)
+		{
+			return 0;
+		}
+		float64 total(0);
+		for(uint32 i = 0 ; i < m_SampleCount ; ++i)
+		{
+			total += m_Samples[i];
+		}
+		return total / m_SampleCount * MILLIMULTIPLIER;
+	}
+
+	float64 FramePacer::GetFrameTimeVariance() const
+	{
+		if(m_SampleCount == 0)
+		{
+			return 0;
+		}
+		float64 average = GetAverageFrameTime();
+		float64 total(0);
+		for(uint32 i = 0 ; i < m_SampleCount ; ++i)
+		{
+			float64 difference = m_Samples[i] * MILLIMULTIPLIER - average;
+			total += difference * difference;
+		}
+		return total / m_SampleCount;
+	}
+
+	void FramePacer::SetLowPowerMode(bool enabled, float64 awakeSeconds)
+	{
+		m_bLowPowerMode = enabled;
+		m_AwakeTime = awakeSeconds;
+		m_AwakeUntil = GetTime() + m_AwakeTime;
+	}
+
+	bool FramePacer::IsLowPowerMode() const
+	{
+		return m_bLowPowerMode;
+	}
+
+	void FramePacer::WakeUp()
+	{
+		if(IsIdle())
+		{
+			Restart();
+		}
+		m_AwakeUntil = GetTime() + m_AwakeTime;
+	}
+
+	bool FramePacer::IsIdle() const
+	{
+		return m_bLowPowerMode && GetTime() >= m_AwakeUntil;
+	}
+
+	float64 FramePacer::GetTime()
+	{
+#ifdef _WIN32
+		LARGE_INTEGER counter, frequency;
+		QueryPerformanceCounter(&counter);
+		QueryPerformanceFrequency(&frequency);
+		return float64(counter.QuadPart) / float64(frequency.QuadPart);
+#else
+		timespec timeVal;
+		clock_gettime(CLOCK_MONOTONIC, &timeVal);
+		return timeVal.tv_sec + timeVal.tv_nsec * NSMULTIPLIER;
+#endif
+	}
+
+	void FramePacer::SleepFor(float64 seconds)
+	{
+#ifdef _WIN32
+		Sleep(DWORD(seconds * MILLIMULTIPLIER));
+#else
+		usleep(useconds_t(seconds * MICROMULTIPLIER));
+#endif
+	}
+
+	void FramePacer::AddSample(float64 frameTime)
+	{
+		m_Samples[m_SampleIndex] = frameTime;
+		m_SampleIndex = (m_SampleIndex + 1) % SAMPLE_COUNT;
+		if(m_SampleCount < SAMPLE_COUNT)
+		{
+			++m_SampleCount;
+		}
+	}
+}
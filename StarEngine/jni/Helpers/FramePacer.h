@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../defines.h"
+
+namespace star
+{
+	//Paces the main loop to a target frame time. The budget left at the
+	//end of a frame is slept away, except for the last stretch which is
+	//spun on the high resolution clock because sleeps tend to overshoot.
+	class FramePacer final
+	{
+	public:
+		FramePacer();
+		~FramePacer();
+
+		//0 doesn't limit the frame rate. Desktop builds leave the rate to
+		//vsync by default, Android builds cap it at 60 to save battery.
+		static const uint32 DEFAULT_FRAME_RATE;
+
+		void SetTargetFrameRate(uint32 framesPerSecond);
+		uint32 GetTargetFrameRate() const;
+		float64 GetTargetFrameTime() const;
+		void SetSpinTime(float64 seconds);
+
+		//Call once at the end of every frame that was updated and drawn.
+		void EndFrame();
+		//Starts timing the next frame from now, after the loop was blocked.
+		void Restart();
+
+		//Over the last SAMPLE_COUNT frames, in milliseconds.
+		float64 GetAverageFrameTime() const;
+		float64 GetFrameTimeVariance() const;
+
+		//For static screens: update and draw are skipped until input
+		//arrives, after which the game keeps running for awakeSeconds.
+		//Gamepads are polled, so they can't wake the game up.
+		void SetLowPowerMode(bool enabled, float64 awakeSeconds = 1.0);
+		bool IsLowPowerMode() const;
+		void WakeUp();
+		bool IsIdle() const;
+
+	private:
+		static const uint32 SAMPLE_COUNT = 120;
+
+		static float64 GetTime();
+		static void SleepFor(float64 seconds);
+		void AddSample(float64 frameTime);
+
+		float64 m_TargetFrameTime,
+				m_SpinTime,
+				m_FrameStart,
+				m_AwakeTime,
+				m_AwakeUntil;
+		float64 m_Samples[SAMPLE_COUNT];
+		uint32 m_SampleIndex,
+			   m_SampleCount;
+		bool m_bLowPowerMode;
+
+		FramePacer(const FramePacer &);
+		FramePacer(FramePacer &&);
+		FramePacer & operator=(const FramePacer &);
+		FramePacer & operator=(FramePacer &&);
+	};
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+
+namespace star
+{
+	//Weak reference to an element registered in the HandleTable of its type.
+	//The generation changes every time a slot gets reused, so a handle to a
+	//destroyed element resolves to nullptr instead of dangling.
+	template <typename T>
+	struct Handle
+	{
+		Handle();
+		Handle(uint32 index, uint32 generation);
+
+		bool operator==(const Handle & yRef) const;
+		bool operator!=(const Handle & yRef) const;
+
+		bool IsNull() const;
+		bool IsValid() const;
+		T * Get() const;
+
+		uint32 Index;
+		uint32 Generation;
+	};
+
+	template <typename T>
+	class HandleTable final
+	{
+	public:
+		~HandleTable();
+
+		static HandleTable<T> * GetInstance();
+
+		Handle<T> Register(T * pElement);
+		void Unregister(const Handle<T> & handle);
+		T * Resolve(const Handle<T> & handle) const;
+
+		uint32 GetElementCount() const;
+
+	private:
+		struct Slot
+		{
+			T * pElement;
+			uint32 Generation;
+		};
+
+		HandleTable();
+
+		static HandleTable<T> * m_pHandleTable;
+
+		std::vector<Slot> m_Slots;
+		std::vector<uint32> m_FreeSlots;
+
+		HandleTable(const HandleTable &);
+		HandleTable(HandleTable &&);
+		HandleTable & operator=(const HandleTable &);
+		HandleTable & operator=(HandleTable &&);
+	};
+
+	class Object;
+	class BaseComponent;
+
+	typedef Handle<Object> ObjectHandle;
+	typedef Handle<BaseComponent> ComponentHandle;
+}
+
+#include "Handle.inl"
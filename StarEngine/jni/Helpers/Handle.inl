@@ -0,0 +1,129 @@
+namespace star
+{
+	template <typename T>
+	Handle<T>::Handle()
+		: Index(0)
+		, Generation(0)
+	{
+	}
+
+	template <typename T>
+	Handle<T>::Handle(uint32 index, uint32 generation)
+		: Index(index)
+		, Generation(generation)
+	{
+	}
+
+	template <typename T>
+	bool Handle<T>::operator==(const Handle & yRef) const
+	{
+		return Index == yRef.Index && Generation == yRef.Generation;
+	}
+
+	template <typename T>
+	bool Handle<T>::operator!=(const Handle & yRef) const
+	{
+		return !(*this == yRef);
+	}
+
+	template <typename T>
+	bool Handle<T>::IsNull() const
+	{
+		return Generation == 0;
+	}
+
+	template <typename T>
+	bool Handle<T>::IsValid() const
+	{
+		return Get() != nullptr;
+	}
+
+	template <typename T>
+	T * Handle<T>::Get() const
+	{
+		return HandleTable<T>::GetInstance()->Resolve(*this);
+	}
+
+	template <typename T>
+	HandleTable<T> * HandleTable<T>::m_pHandleTable = nullptr;
+
+	template <typename T>
+	HandleTable<T>::HandleTable()
+		: m_Slots()
+		, m_FreeSlots()
+	{
+	}
+
+	template <typename T>
+	HandleTable<T>::~HandleTable()
+	{
+		m_pHandleTable = nullptr;
+	}
+
+	template <typename T>
+	HandleTable<T> * HandleTable<T>::GetInstance()
+	{
+		if(m_pHandleTable == nullptr)
+		{
+			m_pHandleTable = new HandleTable<T>();
+		}
+		return m_pHandleTable;
+	}
+
+	template <typename T>
+	Handle<T> HandleTable<T>::Register(T * pElement)
+	{
+		uint32 index;
+		if(m_FreeSlots.empty())
+		{
+			index = uint32(m_Slots.size());
+			Slot slot;
+			slot.pElement = nullptr;
+			//Generation 0 is reserved for null handles.
+			slot.Generation = 1;
+			m_Slots.push_back(slot);
+		}
+		else
+		{
+			index = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+
+		m_Slots[index].pElement = pElement;
+		return Handle<T>(index, m_Slots[index].Generation);
+	}
+
+	template <typename T>
+	void HandleTable<T>::Unregister(const Handle<T> & handle)
+	{
+		if(Resolve(handle) == nullptr)
+		{
+			return;
+		}
+
+		Slot & slot = m_Slots[handle.Index];
+		slot.pElement = nullptr;
+		if(++slot.Generation == 0)
+		{
+			slot.Generation = 1;
+		}
+		m_FreeSlots.push_back(handle.Index);
+	}
+
+	template <typename T>
+	T * HandleTable<T>::Resolve(const Handle<T> & handle) const
+	{
+		if(handle.Index >= m_Slots.size()
+			|| m_Slots[handle.Index].Generation != handle.Generation)
+		{
+			return nullptr;
+		}
+		return m_Slots[handle.Index].pElement;
+	}
+
+	template <typename T>
+	uint32 HandleTable<T>::GetElementCount() const
+	{
+		return uint32(m_Slots.size() - m_FreeSlots.size());
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../defines.h"
+#include <unordered_map>
+#include <vector>
+
+namespace star
+{
+	//Maps the hash of a name or tag to every element carrying it,
+	//so lookups cost the number of matches instead of the container size.
+	//The owner has to keep it in sync on add, remove and rename.
+	template <typename T>
+	class HashIndex final
+	{
+	public:
+		HashIndex();
+		~HashIndex();
+
+		void Add(uint32 hash, T * pElement);
+		bool Remove(uint32 hash, T * pElement);
+		//Only moves elements that were indexed under the old hash.
+		void Move(uint32 oldHash, uint32 newHash, T * pElement);
+		void Clear();
+
+		T * Find(uint32 hash) const;
+		void FindAll(uint32 hash, std::vector<T*> & elementsOut) const;
+
+		template <typename TFunc>
+		void ForEach(uint32 hash, TFunc func) const;
+
+	private:
+		typedef std::unordered_multimap<uint32, T*> IndexMap;
+
+		IndexMap m_Index;
+
+		HashIndex(const HashIndex &);
+		HashIndex(HashIndex &&);
+		HashIndex & operator=(const HashIndex &);
+		HashIndex & operator=(HashIndex &&);
+	};
+}
+
+#include "HashIndex.inl"
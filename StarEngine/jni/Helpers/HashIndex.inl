@@ -0,0 +1,77 @@
+namespace star
+{
+	template <typename T>
+	HashIndex<T>::HashIndex()
+		: m_Index()
+	{
+	}
+
+	template <typename T>
+	HashIndex<T>::~HashIndex()
+	{
+	}
+
+	template <typename T>
+	void HashIndex<T>::Add(uint32 hash, T * pElement)
+	{
+		m_Index.insert(std::make_pair(hash, pElement));
+	}
+
+	template <typename T>
+	bool HashIndex<T>::Remove(uint32 hash, T * pElement)
+	{
+		auto range = m_Index.equal_range(hash);
+		for(auto it = range.first ; it != range.second ; ++it)
+		{
+			if(it->second == pElement)
+			{
+				m_Index.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename T>
+	void HashIndex<T>::Move(uint32 oldHash, uint32 newHash, T * pElement)
+	{
+		if(oldHash != newHash && Remove(oldHash, pElement))
+		{
+			Add(newHash, pElement);
+		}
+	}
+
+	template <typename T>
+	void HashIndex<T>::Clear()
+	{
+		m_Index.clear();
+	}
+
+	template <typename T>
+	T * HashIndex<T>::Find(uint32 hash) const
+	{
+		auto it = m_Index.find(hash);
+		return it != m_Index.end() ? it->second : nullptr;
+	}
+
+	template <typename T>
+	void HashIndex<T>::FindAll(uint32 hash, std::vector<T*> & elementsOut) const
+	{
+		auto range = m_Index.equal_range(hash);
+		for(auto it = range.first ; it != range.second ; ++it)
+		{
+			elementsOut.push_back(it->second);
+		}
+	}
+
+	template <typename T>
+	template <typename TFunc>
+	void HashIndex<T>::ForEach(uint32 hash, TFunc func) const
+	{
+		auto range = m_Index.equal_range(hash);
+		for(auto it = range.first ; it != range.second ; ++it)
+		{
+			func(it->second);
+		}
+	}
+}
@@ -1,26 +1,27 @@
 #include "HashTag.h"
 #include "Helpers.h"
+#include "StringTable.h"
 
 namespace star
 {
 #define HASH uint32
 
 	HashTag::HashTag(const tstring & tag)
-		: m_Tag(tag)
+		: m_pTag(nullptr)
 		, m_Hash()
 	{
-		GenerateHash();
+		SetTag(tag);
 	}
 	
 	HashTag::HashTag(const HashTag & yRef)
-		: m_Tag(yRef.m_Tag)
+		: m_pTag(yRef.m_pTag)
 		, m_Hash(yRef.m_Hash)
 	{
 
 	}
 	
 	HashTag::HashTag(HashTag && yRef)
-		: m_Tag(yRef.m_Tag)
+		: m_pTag(yRef.m_pTag)
 		, m_Hash(yRef.m_Hash)
 	{
 
@@ -28,7 +29,7 @@ namespace star
 	
 	HashTag & HashTag::operator=(const HashTag & yRef)
 	{
-		m_Tag = yRef.m_Tag;
+		m_pTag = yRef.m_pTag;
 		m_Hash = yRef.m_Hash;
 
 		return *this;
@@ -36,7 +37,7 @@ namespace star
 	
 	HashTag & HashTag::operator=(HashTag && yRef)
 	{
-		m_Tag = yRef.m_Tag;
+		m_pTag = yRef.m_pTag;
 		m_Hash = yRef.m_Hash;
 
 		return *this;
@@ -64,12 +65,12 @@ namespace star
 	
 	bool HashTag::operator==(const tstring & tag) const
 	{
-		return m_Hash == star::GenerateHash(tag);
+		return *m_pTag == tag;
 	}
 	
 	bool HashTag::operator!=(const tstring & tag) const
 	{
-		return m_Hash != star::GenerateHash(tag);
+		return *m_pTag != tag;
 	}
 	
 	bool HashTag::operator==(HASH hash) const
@@ -79,28 +80,28 @@ namespace star
 	
 	bool HashTag::operator!=(HASH hash) const
 	{
-		return m_Hash == hash;
+		return m_Hash != hash;
 	}
 	
 	void HashTag::SetTag(const tstring & tag)
 	{
-		m_Tag = tag;
-		GenerateHash();
+		GenerateHash(tag, m_Hash);
+		m_pTag = StringTable::GetInstance()->Intern(tag, m_Hash);
 	}
 	
 	const tstring & HashTag::GetTag() const
 	{
-		return m_Tag;
+		return *m_pTag;
 	}
 	
 	bool operator==(const tstring & tag, const HashTag & other)
 	{
-		return other.GetHash() == star::GenerateHash(tag);
+		return other.GetTag() == tag;
 	}
 	
 	bool operator!=(const tstring & tag, const HashTag & other)
 	{
-		return other.GetHash() != star::GenerateHash(tag);
+		return other.GetTag() != tag;
 	}
 	
 	bool operator==(HASH hash, const HashTag & other)
@@ -118,11 +119,6 @@ namespace star
 		return m_Hash;
 	}
 	
-	void HashTag::GenerateHash()
-	{
-		GenerateHash(m_Tag, m_Hash);
-	}
-	
 	void HashTag::GenerateHash(const tstring & tag, HASH & hash)
 	{
 		hash = star::GenerateHash(tag);
@@ -7,6 +7,10 @@ namespace star
 {
 #define HASH uint32
 
+	//A tag is interned in the StringTable, so a HashTag is only a hash
+	//and a pointer to the shared string. Copying or comparing two tags
+	//never touches the characters, comparing with a string doesn't hash
+	//it but compares the characters with those of the interned tag.
 	class HashTag final
 	{
 	public:
@@ -40,9 +44,7 @@ namespace star
 		static void GenerateHash(const tstring & tag, HASH & hash);
 
 	private:
-		void GenerateHash();
-
-		tstring m_Tag;
+		const tstring * m_pTag;
 		HASH m_Hash;
 	};
 
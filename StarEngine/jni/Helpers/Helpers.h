@@ -20,6 +20,17 @@ namespace star
 	/// <returns>generated hash</returns>
 	const uint32 GenerateHash(const tstring & str);
 
+	/// <summary>
+	/// Generate the same hash as GenerateHash for a string literal.
+	/// The loop is unrolled over the length of the literal,
+	/// so an optimizing compiler folds the result into a constant.
+	/// Only pass literals: a buffer would be hashed over its full size.
+	/// </summary>
+	/// <param name="str">string literal to be hashed, e.g. _T("Enemy")</param>
+	/// <returns>generated hash</returns>
+	template <uint32 N>
+	uint32 HashLiteral(const tchar (&str)[N]);
+
 	/// <summary>
 	/// Opens a webpage in the user's default browser.
 	/// </summary>
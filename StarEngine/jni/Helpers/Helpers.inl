@@ -6,6 +6,34 @@
 
 namespace star
 {
+	template <uint32 N, uint32 I>
+	struct LiteralHasher
+	{
+		static uint32 Hash(const tchar (&str)[N])
+		{
+			return 65599 * LiteralHasher<N, I - 1>::Hash(str) + str[I - 1];
+		}
+	};
+
+	template <uint32 N>
+	struct LiteralHasher<N, 0>
+	{
+		static uint32 Hash(const tchar (&)[N])
+		{
+			return 0;
+		}
+	};
+
+	template <uint32 N>
+	uint32 HashLiteral(const tchar (&str)[N])
+	{
+		//N includes the terminating null character.
+		ASSERT(std::char_traits<tchar>::length(str) == N - 1,
+			_T("HashLiteral: Only string literals can be hashed."));
+		uint32 hash = LiteralHasher<N, N - 1>::Hash(str);
+		return hash ^ (hash >> 16);
+	}
+
 	template < typename TReturnValue, typename TValue>
 	TReturnValue string_cast(const TValue & value)
 	{
@@ -0,0 +1,233 @@
+#include "JobSystem.h"
+#include "Helpers.h"
+#include "../Logger.h"
+
+#ifdef _WIN32
+#define JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define JOB_THREAD_LOCAL __thread
+#endif
+
+namespace star
+{
+	//Index of the queue owned by the current thread, 0 for non-workers.
+	static JOB_THREAD_LOCAL uint32 g_QueueIndex = 0;
+
+	TaskGroup::TaskGroup()
+		: m_Pending(0)
+	{
+	}
+
+	TaskGroup::~TaskGroup()
+	{
+		Wait();
+	}
+
+	void TaskGroup::Run(const std::function<void()> & task)
+	{
+		auto jobSystem = JobSystem::GetInstance();
+		if(jobSystem->m_Workers.empty())
+		{
+			task();
+			return;
+		}
+
+		++m_Pending;
+		JobSystem::Job job;
+		job.Task = task;
+		job.pGroup = this;
+		jobSystem->Submit(job);
+	}
+
+	void TaskGroup::Wait()
+	{
+		auto jobSystem = JobSystem::GetInstance();
+		while(m_Pending > 0)
+		{
+			if(!jobSystem->TryRunJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool TaskGroup::IsDone() const
+	{
+		return m_Pending == 0;
+	}
+
+	JobSystem * JobSystem::m_pJobSystem = nullptr;
+
+	JobSystem::JobSystem()
+		: m_Workers()
+		, m_Queues()
+		, m_SleepMutex()
+		, m_WakeCondition()
+		, m_QueuedJobs(0)
+		, m_bStopping(false)
+	{
+		Initialize(GetDefaultWorkerCount());
+	}
+
+	JobSystem::~JobSystem()
+	{
+		StopWorkers();
+		m_pJobSystem = nullptr;
+	}
+
+	JobSystem * JobSystem::GetInstance()
+	{
+		if(m_pJobSystem == nullptr)
+		{
+			m_pJobSystem = new JobSystem();
+		}
+		return m_pJobSystem;
+	}
+
+	void JobSystem::Initialize(uint32 workerCount)
+	{
+		StopWorkers();
+
+		m_Queues.push_back(new WorkQueue());
+		for(uint32 i = 0 ; i < workerCount ; ++i)
+		{
+			m_Queues.push_back(new WorkQueue());
+		}
+		for(uint32 i = 0 ; i < workerCount ; ++i)
+		{
+			m_Workers.push_back(std::thread(&JobSystem::WorkerLoop, this, i + 1));
+		}
+
+		Logger::GetInstance()->Log(LogLevel::Info,
+			_T("JobSystem: Running with ") + string_cast<tstring>(workerCount)
+			+ _T(" worker threads."), STARENGINE_LOG_TAG);
+	}
+
+	uint32 JobSystem::GetWorkerCount() const
+	{
+		return uint32(m_Workers.size());
+	}
+
+	uint32 JobSystem::GetDefaultWorkerCount()
+	{
+		//One core stays reserved for the main thread.
+		uint32 cores = std::thread::hardware_concurrency();
+		return cores > 1 ? cores - 1 : 0;
+	}
+
+	void JobSystem::Submit(const Job & job)
+	{
+		WorkQueue * queue = m_Queues[g_QueueIndex];
+		{
+			std::lock_guard<std::mutex> lock(queue->Mutex);
+			queue->Jobs.push_back(job);
+		}
+		{
+			//Counted under the sleep mutex so no worker misses the wake up.
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			++m_QueuedJobs;
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryRunJob()
+	{
+		Job job;
+		if(!TryPopJob(g_QueueIndex, job) && !TryStealJob(g_QueueIndex, job))
+		{
+			return false;
+		}
+
+		--m_QueuedJobs;
+		job.Task();
+		--job.pGroup->m_Pending;
+		return true;
+	}
+
+	bool JobSystem::TryPopJob(uint32 queueIndex, Job & jobOut)
+	{
+		WorkQueue * queue = m_Queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->Mutex);
+		if(queue->Jobs.empty())
+		{
+			return false;
+		}
+		jobOut = queue->Jobs.back();
+		queue->Jobs.pop_back();
+		return true;
+	}
+
+	bool JobSystem::TryStealJob(uint32 queueIndex, Job & jobOut)
+	{
+		uint32 queueCount = uint32(m_Queues.size());
+		for(uint32 i = 1 ; i < queueCount ; ++i)
+		{
+			WorkQueue * queue = m_Queues[(queueIndex + i) % queueCount];
+			std::lock_guard<std::mutex> lock(queue->Mutex);
+			if(!queue->Jobs.empty())
+			{
+				jobOut = queue->Jobs.front();
+				queue->Jobs.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void JobSystem::WorkerLoop(uint32 queueIndex)
+	{
+		g_QueueIndex = queueIndex;
+		for(;;)
+		{
+			if(TryRunJob())
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_SleepMutex);
+			m_WakeCondition.wait(lock, [this]()
+			{
+				return m_bStopping || m_QueuedJobs > 0;
+			});
+			if(m_bStopping)
+			{
+				return;
+			}
+		}
+	}
+
+	void JobSystem::StopWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_bStopping = true;
+		}
+		m_WakeCondition.notify_all();
+
+		for(auto & worker : m_Workers)
+		{
+			worker.join();
+		}
+		m_Workers.clear();
+
+		for(auto queue : m_Queues)
+		{
+			delete queue;
+		}
+		m_Queues.clear();
+		m_QueuedJobs = 0;
+		m_bStopping = false;
+	}
+
+	void JobSystem::LogBenchmarkResult(const tstring & name, uint32 threads,
+		float64 milliSeconds, float64 baseMilliSeconds) const
+	{
+		float64 speedUp = milliSeconds > 0 ? baseMilliSeconds / milliSeconds : 0;
+		Logger::GetInstance()->Log(LogLevel::Info,
+			_T("JobSystem benchmark '") + name + _T("': ")
+			+ string_cast<tstring>(threads) + _T(" threads, ")
+			+ string_cast<tstring>(milliSeconds) + _T(" ms, ")
+			+ string_cast<tstring>(speedUp) + _T("x"),
+			STARENGINE_LOG_TAG);
+	}
+}
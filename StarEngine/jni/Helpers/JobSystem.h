@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace star
+{
+	class JobSystem;
+
+	//A set of jobs that is joined as a whole. Wait only returns once
+	//every job of the group has finished, the waiting thread helps
+	//running queued jobs in the meantime instead of blocking.
+	class TaskGroup final
+	{
+	public:
+		TaskGroup();
+		~TaskGroup();
+
+		void Run(const std::function<void()> & task);
+		void Wait();
+		bool IsDone() const;
+
+	private:
+		std::atomic<uint32> m_Pending;
+
+		friend class JobSystem;
+
+		TaskGroup(const TaskGroup &);
+		TaskGroup(TaskGroup &&);
+		TaskGroup & operator=(const TaskGroup &);
+		TaskGroup & operator=(TaskGroup &&);
+	};
+
+	//Engine-owned worker threads, each with its own job deque.
+	//A thread pops its own newest job first and steals the oldest
+	//job of another queue when it runs dry. Jobs may read the scene
+	//but must not create or destroy objects: the handle tables, Logger
+	//and managers are only safe to use from the main thread.
+	class JobSystem final
+	{
+	public:
+		~JobSystem();
+
+		static JobSystem * GetInstance();
+
+		//Restarts the workers, only call this while no jobs are running.
+		//With 0 workers every job runs inline on the calling thread.
+		void Initialize(uint32 workerCount);
+		uint32 GetWorkerCount() const;
+		static uint32 GetDefaultWorkerCount();
+
+		//Calls func(first, last) for consecutive chunks of at most grainSize
+		//indices. The chunks only depend on the range and the grain size,
+		//so results written per index don't depend on the worker count.
+		template <typename TFunc>
+		void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, TFunc func);
+
+		//Logs the time a ParallelFor takes with 1, 2, 4 and 8 threads,
+		//the calling thread included. Restarts the workers for every
+		//count and restores the worker count afterwards, so like
+		//Initialize it may only be called while no jobs are queued.
+		template <typename TFunc>
+		void Benchmark(
+			const tstring & name,
+			uint32 begin,
+			uint32 end,
+			uint32 grainSize,
+			TFunc func,
+			uint32 iterations = 10
+			);
+
+	private:
+		struct Job
+		{
+			std::function<void()> Task;
+			TaskGroup * pGroup;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex Mutex;
+			std::deque<Job> Jobs;
+		};
+
+		JobSystem();
+
+		void Submit(const Job & job);
+		bool TryRunJob();
+		bool TryPopJob(uint32 queueIndex, Job & jobOut);
+		bool TryStealJob(uint32 queueIndex, Job & jobOut);
+		void WorkerLoop(uint32 queueIndex);
+		void StopWorkers();
+		void LogBenchmarkResult(const tstring & name, uint32 threads,
+			float64 milliSeconds, float64 baseMilliSeconds) const;
+
+		static JobSystem * m_pJobSystem;
+
+		std::vector<std::thread> m_Workers;
+		//Queue 0 belongs to the main thread and every other non-worker.
+		std::vector<WorkQueue*> m_Queues;
+		std::mutex m_SleepMutex;
+		std::condition_variable m_WakeCondition;
+		//Signed, a job can be stolen and counted down
+		//before its submitter has counted it up.
+		std::atomic<int32> m_QueuedJobs;
+		bool m_bStopping;
+
+		friend class TaskGroup;
+
+		JobSystem(const JobSystem &);
+		JobSystem(JobSystem &&);
+		JobSystem & operator=(const JobSystem &);
+		JobSystem & operator=(JobSystem &&);
+	};
+}
+
+#include "JobSystem.inl"
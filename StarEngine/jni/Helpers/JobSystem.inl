@@ -0,0 +1,83 @@
+#include "../TimeManager.h"
+
+namespace star
+{
+	template <typename TFunc>
+	void JobSystem::ParallelFor(uint32 begin, uint32 end, uint32 grainSize, TFunc func)
+	{
+		if(end <= begin)
+		{
+			return;
+		}
+		if(grainSize == 0)
+		{
+			grainSize = 1;
+		}
+
+		uint32 firstChunkEnd = end - begin > grainSize ? begin + grainSize : end;
+		if(m_Workers.empty())
+		{
+			for(uint32 first = begin ; first < end ; )
+			{
+				uint32 last = end - first > grainSize ? first + grainSize : end;
+				func(first, last);
+				first = last;
+			}
+			return;
+		}
+
+		TaskGroup group;
+		for(uint32 first = firstChunkEnd ; first < end ; )
+		{
+			uint32 last = end - first > grainSize ? first + grainSize : end;
+			group.Run([=]()
+			{
+				func(first, last);
+			});
+			first = last;
+		}
+
+		//The calling thread takes the first chunk itself.
+		func(begin, firstChunkEnd);
+		group.Wait();
+	}
+
+	template <typename TFunc>
+	void JobSystem::Benchmark(
+		const tstring & name,
+		uint32 begin,
+		uint32 end,
+		uint32 grainSize,
+		TFunc func,
+		uint32 iterations
+		)
+	{
+		static const uint32 THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+		uint32 originalWorkerCount = GetWorkerCount();
+		float64 baseMilliSeconds(0);
+		for(uint32 threads : THREAD_COUNTS)
+		{
+			Initialize(threads - 1);
+
+			//Warm up the caches and the worker threads.
+			ParallelFor(begin, end, grainSize, func);
+
+			TimeManager timer;
+			timer.StartMonitoring();
+			for(uint32 i = 0 ; i < iterations ; ++i)
+			{
+				ParallelFor(begin, end, grainSize, func);
+			}
+			timer.StopMonitoring();
+
+			float64 milliSeconds = timer.GetMilliSeconds() / float64(iterations);
+			if(threads == 1)
+			{
+				baseMilliSeconds = milliSeconds;
+			}
+			LogBenchmarkResult(name, threads, milliSeconds, baseMilliSeconds);
+		}
+		Initialize(originalWorkerCount);
+	}
+}
@@ -0,0 +1,252 @@
+#include "MemoryPool.h"
+#include "Helpers.h"
+#include "../Logger.h"
+#include <new>
+
+namespace star
+{
+	std::atomic<MemoryPool*> MemoryPool::m_pMemoryPool(nullptr);
+	std::atomic<bool> MemoryPool::m_bDestroyed(false);
+
+	MemoryPool::Statistics::Statistics()
+		: BlockSize(0)
+		, Capacity(0)
+		, Used(0)
+		, Peak(0)
+		, Slabs(0)
+	{
+	}
+
+	MemoryPool::SizeClass::SizeClass()
+		: pFreeList(nullptr)
+		, Slabs()
+		, Capacity(0)
+		, Used(0)
+		, Peak(0)
+	{
+	}
+
+	MemoryPool::MemoryPool()
+		: m_OversizedAllocations(0)
+		, m_Mutex()
+	{
+	}
+
+	MemoryPool::~MemoryPool()
+	{
+		m_pMemoryPool = nullptr;
+		m_bDestroyed = true;
+
+		bool inUse(false);
+		for(uint32 i = 0 ; i < SIZE_CLASSES ; ++i)
+		{
+			inUse |= m_SizeClasses[i].Used > 0;
+		}
+
+		//Blocks that are still alive would point into freed memory,
+		//so the slabs are left to the OS when anything leaked.
+		if(inUse)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("MemoryPool: Blocks are still in use on shutdown, keeping the slabs alive."),
+				STARENGINE_LOG_TAG);
+			LogStatistics();
+		}
+		else
+		{
+			for(uint32 i = 0 ; i < SIZE_CLASSES ; ++i)
+			{
+				for(auto slab : m_SizeClasses[i].Slabs)
+				{
+					::operator delete(slab);
+				}
+			}
+		}
+	}
+
+	void MemoryPool::Create()
+	{
+		if(m_pMemoryPool == nullptr && !m_bDestroyed)
+		{
+			m_pMemoryPool = new MemoryPool();
+		}
+	}
+
+	MemoryPool * MemoryPool::GetInstance()
+	{
+		return m_pMemoryPool;
+	}
+
+	void * MemoryPool::Allocate(size_t size)
+	{
+		MemoryPool * pPool = m_pMemoryPool;
+		if(pPool == nullptr && !m_bDestroyed)
+		{
+			//Objects created before StarEngine::Initialize,
+			//still on the main thread without any workers.
+			Create();
+			pPool = m_pMemoryPool;
+		}
+		return pPool != nullptr ? pPool->AllocateBlock(size) : ::operator new(size);
+	}
+
+	void MemoryPool::Deallocate(void * pMemory, size_t size)
+	{
+		if(pMemory == nullptr)
+		{
+			return;
+		}
+
+		//After shutdown the block might belong to a slab of the deleted
+		//pool, which was kept alive, or to the heap. Either way it is
+		//left to the OS.
+		MemoryPool * pPool = m_pMemoryPool;
+		if(pPool != nullptr)
+		{
+			pPool->DeallocateBlock(pMemory, size);
+		}
+	}
+
+	void * MemoryPool::AllocateBlock(size_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if(size > MAX_BLOCK_SIZE)
+		{
+			++m_OversizedAllocations;
+			return ::operator new(size);
+		}
+
+		uint32 sizeClass = GetSizeClass(size);
+		SizeClass & pool = m_SizeClasses[sizeClass];
+		if(pool.pFreeList == nullptr)
+		{
+			AddSlab(sizeClass);
+		}
+
+		FreeBlock * pBlock = pool.pFreeList;
+		pool.pFreeList = pBlock->pNext;
+		++pool.Used;
+		if(pool.Used > pool.Peak)
+		{
+			pool.Peak = pool.Used;
+		}
+		return pBlock;
+	}
+
+	void MemoryPool::DeallocateBlock(void * pMemory, size_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if(size > MAX_BLOCK_SIZE)
+		{
+			--m_OversizedAllocations;
+			::operator delete(pMemory);
+			return;
+		}
+
+		SizeClass & pool = m_SizeClasses[GetSizeClass(size)];
+		FreeBlock * pBlock = static_cast<FreeBlock*>(pMemory);
+		pBlock->pNext = pool.pFreeList;
+		pool.pFreeList = pBlock;
+		--pool.Used;
+	}
+
+	void MemoryPool::Reserve(size_t size, uint32 count)
+	{
+		if(size > MAX_BLOCK_SIZE)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		uint32 sizeClass = GetSizeClass(size);
+		while(m_SizeClasses[sizeClass].Capacity < count)
+		{
+			AddSlab(sizeClass);
+		}
+	}
+
+	MemoryPool::Statistics MemoryPool::GetStatistics(size_t size) const
+	{
+		if(size > MAX_BLOCK_SIZE)
+		{
+			return Statistics();
+		}
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return GetClassStatistics(GetSizeClass(size));
+	}
+
+	void MemoryPool::GetStatistics(std::vector<Statistics> & statisticsOut) const
+	{
+		statisticsOut.clear();
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for(uint32 i = 0 ; i < SIZE_CLASSES ; ++i)
+		{
+			if(!m_SizeClasses[i].Slabs.empty())
+			{
+				statisticsOut.push_back(GetClassStatistics(i));
+			}
+		}
+	}
+
+	void MemoryPool::LogStatistics() const
+	{
+		std::vector<Statistics> statistics;
+		GetStatistics(statistics);
+		for(auto & stats : statistics)
+		{
+			Logger::GetInstance()->Log(LogLevel::Info,
+				_T("MemoryPool: ") + string_cast<tstring>(stats.BlockSize)
+				+ _T(" byte blocks | used ") + string_cast<tstring>(stats.Used)
+				+ _T(" | peak ") + string_cast<tstring>(stats.Peak)
+				+ _T(" | capacity ") + string_cast<tstring>(stats.Capacity)
+				+ _T(" in ") + string_cast<tstring>(stats.Slabs) + _T(" slabs"),
+				STARENGINE_LOG_TAG);
+		}
+		if(m_OversizedAllocations > 0)
+		{
+			Logger::GetInstance()->Log(LogLevel::Info,
+				_T("MemoryPool: ") + string_cast<tstring>(m_OversizedAllocations)
+				+ _T(" blocks too big for the pool"),
+				STARENGINE_LOG_TAG);
+		}
+	}
+
+	uint32 MemoryPool::GetSizeClass(size_t size)
+	{
+		return size == 0 ? 0 : uint32((size - 1) / GRANULARITY);
+	}
+
+	void MemoryPool::AddSlab(uint32 sizeClass)
+	{
+		SizeClass & pool = m_SizeClasses[sizeClass];
+		const uint32 blockSize = (sizeClass + 1) * GRANULARITY;
+		const uint32 blockCount = std::max<uint32>(SLAB_BYTES / blockSize, 1);
+
+		//::operator new returns memory aligned for any fundamental type,
+		//the block size keeps every block after the first one aligned too.
+		char * pSlab = static_cast<char*>(::operator new(blockCount * blockSize));
+		pool.Slabs.push_back(pSlab);
+
+		for(uint32 i = blockCount ; i > 0 ; --i)
+		{
+			FreeBlock * pBlock = reinterpret_cast<FreeBlock*>(
+				pSlab + (i - 1) * blockSize
+				);
+			pBlock->pNext = pool.pFreeList;
+			pool.pFreeList = pBlock;
+		}
+		pool.Capacity += blockCount;
+	}
+
+	MemoryPool::Statistics MemoryPool::GetClassStatistics(uint32 sizeClass) const
+	{
+		const SizeClass & pool = m_SizeClasses[sizeClass];
+		Statistics stats;
+		stats.BlockSize = (sizeClass + 1) * GRANULARITY;
+		stats.Capacity = pool.Capacity;
+		stats.Used = pool.Used;
+		stats.Peak = pool.Peak;
+		stats.Slabs = uint32(pool.Slabs.size());
+		return stats;
+	}
+}
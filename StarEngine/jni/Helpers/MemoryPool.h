@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+namespace star
+{
+	//Slab allocator behind Object, BaseComponent, Action, SpriteInfo and TextInfo.
+	//Blocks are grouped in size classes; a freed block goes back on the free
+	//list of its class, so spawning and destroying objects of the same types
+	//stops allocating once the pools have grown to the peak amount in use.
+	//All calls are locked, pooled types can be created on any thread.
+	//StarEngine::Initialize creates the pool and StarEngine::End deletes
+	//it, pooled objects created after that use the heap.
+	class MemoryPool final
+	{
+	public:
+		struct Statistics
+		{
+			Statistics();
+
+			uint32 BlockSize;
+			uint32 Capacity;
+			uint32 Used;
+			uint32 Peak;
+			uint32 Slabs;
+		};
+
+		~MemoryPool();
+
+		//Called by StarEngine::Initialize, before any job can run. Not
+		//thread safe, the pool is never created again once deleted.
+		static void Create();
+		//nullptr outside of the lifetime of the pool.
+		static MemoryPool * GetInstance();
+
+		//Used by the operator new and delete of the pooled types.
+		static void * Allocate(size_t size);
+		static void Deallocate(void * pMemory, size_t size);
+
+		template <typename T>
+		void Reserve(uint32 count);
+		void Reserve(size_t size, uint32 count);
+
+		//The statistics of a type are those of its size class,
+		//which it shares with every other type of about the same size.
+		template <typename T>
+		Statistics GetStatistics() const;
+		Statistics GetStatistics(size_t size) const;
+		void GetStatistics(std::vector<Statistics> & statisticsOut) const;
+		void LogStatistics() const;
+
+	private:
+		static const uint32 GRANULARITY = 16;
+		static const uint32 MAX_BLOCK_SIZE = 1024;
+		static const uint32 SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+		static const uint32 SLAB_BYTES = 16384;
+
+		struct FreeBlock
+		{
+			FreeBlock * pNext;
+		};
+
+		struct SizeClass
+		{
+			SizeClass();
+
+			FreeBlock * pFreeList;
+			std::vector<char*> Slabs;
+			uint32 Capacity;
+			uint32 Used;
+			uint32 Peak;
+		};
+
+		MemoryPool();
+
+		void * AllocateBlock(size_t size);
+		void DeallocateBlock(void * pMemory, size_t size);
+		static uint32 GetSizeClass(size_t size);
+		void AddSlab(uint32 sizeClass);
+		Statistics GetClassStatistics(uint32 sizeClass) const;
+
+		static std::atomic<MemoryPool*> m_pMemoryPool;
+		//Set once the pool was deleted on shutdown.
+		static std::atomic<bool> m_bDestroyed;
+
+		SizeClass m_SizeClasses[SIZE_CLASSES];
+		uint32 m_OversizedAllocations;
+		mutable std::mutex m_Mutex;
+
+		MemoryPool(const MemoryPool &);
+		MemoryPool(MemoryPool &&);
+		MemoryPool & operator=(const MemoryPool &);
+		MemoryPool & operator=(MemoryPool &&);
+	};
+}
+
+#include "MemoryPool.inl"
@@ -0,0 +1,14 @@
+namespace star
+{
+	template <typename T>
+	void MemoryPool::Reserve(uint32 count)
+	{
+		Reserve(sizeof(T), count);
+	}
+
+	template <typename T>
+	MemoryPool::Statistics MemoryPool::GetStatistics() const
+	{
+		return GetStatistics(sizeof(T));
+	}
+}
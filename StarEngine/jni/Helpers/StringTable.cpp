@@ -0,0 +1,60 @@
+#include "StringTable.h"
+#include "Helpers.h"
+
+namespace star
+{
+	StringTable * StringTable::m_pStringTable = nullptr;
+
+	StringTable::StringTable()
+		: m_Strings()
+		, m_Lookup()
+		, m_Mutex()
+	{
+		//The empty string is used by every unnamed entity.
+		Intern(EMPTY_STRING);
+	}
+
+	StringTable::~StringTable()
+	{
+		m_pStringTable = nullptr;
+	}
+
+	StringTable * StringTable::GetInstance()
+	{
+		if(m_pStringTable == nullptr)
+		{
+			m_pStringTable = new StringTable();
+		}
+		return m_pStringTable;
+	}
+
+	const tstring * StringTable::Intern(const tstring & str)
+	{
+		return Intern(str, GenerateHash(str));
+	}
+
+	const tstring * StringTable::Intern(const tstring & str, uint32 hash)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		auto range = m_Lookup.equal_range(hash);
+		for(auto it = range.first ; it != range.second ; ++it)
+		{
+			if(*it->second == str)
+			{
+				return it->second;
+			}
+		}
+
+		//A deque never moves its elements when growing at the back.
+		m_Strings.push_back(str);
+		const tstring * pString = &m_Strings.back();
+		m_Lookup.insert(std::make_pair(hash, pString));
+		return pString;
+	}
+
+	uint32 StringTable::GetStringCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return uint32(m_Strings.size());
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../defines.h"
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+namespace star
+{
+	//Global table of interned strings. Every distinct string is stored once
+	//and keeps its address until shutdown, so HashTags only carry a pointer
+	//into the table next to their hash. Interning is locked, HashTags
+	//can be set from jobs.
+	class StringTable final
+	{
+	public:
+		~StringTable();
+
+		static StringTable * GetInstance();
+
+		const tstring * Intern(const tstring & str);
+		const tstring * Intern(const tstring & str, uint32 hash);
+
+		uint32 GetStringCount() const;
+
+	private:
+		StringTable();
+
+		static StringTable * m_pStringTable;
+
+		std::deque<tstring> m_Strings;
+		std::unordered_multimap<uint32, const tstring*> m_Lookup;
+		mutable std::mutex m_Mutex;
+
+		StringTable(const StringTable &);
+		StringTable(StringTable &&);
+		StringTable & operator=(const StringTable &);
+		StringTable & operator=(StringTable &&);
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../defines.h"
+#include <atomic>
+
+namespace star
+{
+	//The slot holding the ID of type T within a family of IDs, like
+	//ComponentType. Slots and counters are zero-initialized statics,
+	//so unlike function-local statics, which VS2012 doesn't initialize
+	//thread safe, they are ready before the first worker asks for an ID.
+	//A slot stores the ID plus one, zero means it wasn't taken yet.
+	template <typename Family, typename T>
+	struct TypeIDSlot
+	{
+		static std::atomic<uint32> Value;
+	};
+
+	template <typename Family, typename T>
+	std::atomic<uint32> TypeIDSlot<Family, T>::Value;
+
+	//Threads asking for the ID of a new type at the same time each take
+	//a value from the counter, only the first one stored in the slot is
+	//kept. The others leave a gap in the IDs, which is harmless.
+	inline uint32 TakeTypeID(
+		std::atomic<uint32> & slot,
+		std::atomic<uint32> & counter
+		)
+	{
+		uint32 id = slot.load();
+		if(id == 0)
+		{
+			uint32 expected = 0;
+			slot.compare_exchange_strong(expected, counter.fetch_add(1) + 1);
+			id = slot.load();
+		}
+		return id - 1;
+	}
+}
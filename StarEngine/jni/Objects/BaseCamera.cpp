@@ -13,6 +13,9 @@ namespace star
 		//Camera Component
 		m_pCamera = new CameraComponent();
 		AddComponent(m_pCamera);
+
+		//Has no Update of its own, cameras that move turn it back on.
+		SetTickEnabled(false);
 	}
 
 	BaseCamera::~BaseCamera()
@@ -48,4 +51,9 @@ namespace star
 	{
 		GetComponent<CameraComponent>()->ConvertScreenToWorld(posInOut);
 	}
+
+	uint32 BaseCamera::GetTypeID() const
+	{
+		return ObjectType::GetID<BaseCamera>();
+	}
 }
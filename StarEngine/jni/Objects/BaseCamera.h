@@ -20,6 +20,8 @@ namespace star
 
 		void ConvertScreenToWorld(vec2 & posInOut);
 
+		virtual uint32 GetTypeID() const;
+
 	protected:
 		virtual void Initialize();
 		CameraComponent *m_pCamera;
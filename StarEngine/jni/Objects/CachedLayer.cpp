@@ -0,0 +1,336 @@
+#include "CachedLayer.h"
+#include "../Components/Graphics/SpriteComponent.h"
+#include "../Components/TransformComponent.h"
+#include "../Graphics/SpriteBatch.h"
+#include "../Graphics/ScaleSystem.h"
+#include "../Graphics/GraphicsManager.h"
+#include "../Helpers/Math.h"
+#include "../Logger.h"
+#include <cmath>
+#include <algorithm>
+
+namespace star
+{
+	CachedLayer::CachedLayer(int32 width, int32 height)
+		: Object()
+		, m_LayerDimensions(width, height)
+		, m_TextureDimensions(0, 0)
+		, m_FrameBufferID(0)
+		, m_TextureID(0)
+		, m_ContextID(0)
+		, m_pSpriteInfo(nullptr)
+		, m_RedrawCount(0)
+		, m_bIsDirty(true)
+		, m_bIsCachingEnabled(true)
+	{
+		m_pSpriteInfo = new SpriteInfo();
+		m_pSpriteInfo->vertices = m_LayerDimensions;
+		GetTransform()->SetDimensions(width, height);
+		SetTickEnabled(false);
+	}
+
+	CachedLayer::CachedLayer(
+		const tstring & name,
+		int32 width,
+		int32 height
+		)
+		: Object(name)
+		, m_LayerDimensions(width, height)
+		, m_TextureDimensions(0, 0)
+		, m_FrameBufferID(0)
+		, m_TextureID(0)
+		, m_ContextID(0)
+		, m_pSpriteInfo(nullptr)
+		, m_RedrawCount(0)
+		, m_bIsDirty(true)
+		, m_bIsCachingEnabled(true)
+	{
+		m_pSpriteInfo = new SpriteInfo();
+		m_pSpriteInfo->vertices = m_LayerDimensions;
+		GetTransform()->SetDimensions(width, height);
+		SetTickEnabled(false);
+	}
+
+	CachedLayer::~CachedLayer(void)
+	{
+		DestroyRenderTarget();
+		delete m_pSpriteInfo;
+	}
+
+	void CachedLayer::BaseDraw()
+	{
+		if(m_IsVisible)
+		{
+			Draw();
+
+			for(auto component : m_pComponents)
+			{
+				if(component)
+				{
+					component->BaseDraw();
+				}
+			}
+
+			DrawLayer();
+		}
+	}
+
+	void CachedLayer::BaseDrawWithCulling(
+		float32 left,
+		float32 right,
+		float32 top,
+		float32 bottom
+		)
+	{
+		//The children are culled as a whole, using the bounds of the layer.
+		if(m_IsVisible && BaseCheckCulling(left, right, top, bottom))
+		{
+			Draw();
+
+			for(auto component : m_pComponents)
+			{
+				if(component)
+				{
+					component->BaseDraw();
+				}
+			}
+
+			DrawLayer();
+		}
+	}
+
+	void CachedLayer::SetCachingEnabled(bool enabled)
+	{
+		m_bIsCachingEnabled = enabled;
+		if(!enabled)
+		{
+			DestroyRenderTarget();
+		}
+		m_bIsDirty = true;
+	}
+
+	bool CachedLayer::IsCachingEnabled() const
+	{
+		return m_bIsCachingEnabled;
+	}
+
+	void CachedLayer::SetHUDOptionEnabled(bool enabled)
+	{
+		m_pSpriteInfo->bIsHud = enabled;
+		MarkCacheDirty();
+	}
+
+	bool CachedLayer::IsHUDOptionEnabled() const
+	{
+		return m_pSpriteInfo->bIsHud;
+	}
+
+	void CachedLayer::SetColorMultiplier(const Color & color)
+	{
+		m_pSpriteInfo->colorMultiplier = color;
+		MarkCacheDirty();
+	}
+
+	void CachedLayer::Invalidate()
+	{
+		m_bIsDirty = true;
+	}
+
+	bool CachedLayer::IsDirty() const
+	{
+		return m_bIsDirty;
+	}
+
+	uint32 CachedLayer::GetRedrawCount() const
+	{
+		return m_RedrawCount;
+	}
+
+	void CachedLayer::OnChildCacheDirty()
+	{
+		m_bIsDirty = true;
+		Object::OnChildCacheDirty();
+	}
+
+	bool CachedLayer::CheckCulling(
+		float32 left,
+		float32 right,
+		float32 top,
+		float32 bottom
+		)
+	{
+		if(m_pSpriteInfo->bIsHud)
+		{
+			return true;
+		}
+
+		//The bounds of the corners as drawn, so rotated layers
+		//aren't culled while a corner is still on screen.
+		mat4 transformMat = Transpose(GetTransform()->GetRenderMatrix());
+		vec4 corners[4] =
+		{
+			vec4(0, 0, 0, 1),
+			vec4(m_LayerDimensions.x, 0, 0, 1),
+			vec4(0, m_LayerDimensions.y, 0, 1),
+			vec4(m_LayerDimensions.x, m_LayerDimensions.y, 0, 1)
+		};
+		Mul(corners[0], transformMat, corners[0]);
+		vec2 layerMin(corners[0].x, corners[0].y),
+			layerMax(layerMin);
+		for(uint32 i = 1 ; i < 4 ; ++i)
+		{
+			Mul(corners[i], transformMat, corners[i]);
+			layerMin.x = std::min(layerMin.x, corners[i].x);
+			layerMin.y = std::min(layerMin.y, corners[i].y);
+			layerMax.x = std::max(layerMax.x, corners[i].x);
+			layerMax.y = std::max(layerMax.y, corners[i].y);
+		}
+
+		return
+			(layerMin.x <= right && layerMax.x >= left)
+			&&
+			(layerMin.y <= top && layerMax.y >= bottom);
+	}
+
+	void CachedLayer::DrawLayer()
+	{
+		//Nested layers are drawn straight into the texture of the outer layer.
+		if(!m_bIsCachingEnabled
+			|| SpriteBatch::GetInstance()->IsRenderingCachedLayer()
+			|| !UpdateRenderTarget())
+		{
+			DrawChildren();
+			return;
+		}
+
+		if(m_bIsDirty)
+		{
+			RenderToTexture();
+		}
+
+		m_pSpriteInfo->transformPtr = GetTransform();
+		SpriteBatch::GetInstance()->AddSpriteToQueue(m_pSpriteInfo);
+	}
+
+	void CachedLayer::DrawChildren()
+	{
+		for(auto child : m_pChildren)
+		{
+			if(child)
+			{
+				child->BaseDraw();
+			}
+		}
+	}
+
+	void CachedLayer::RenderToTexture()
+	{
+		float32 scale = ScaleSystem::GetInstance()->GetScale();
+		vec2 textureSpace(
+			m_TextureDimensions.x / scale,
+			m_TextureDimensions.y / scale
+			);
+
+		SpriteBatch::GetInstance()->BeginCachedLayer(
+			m_FrameBufferID,
+			m_TextureDimensions,
+			textureSpace,
+			Inverse(GetTransform()->GetRenderMatrix())
+			);
+		DrawChildren();
+		SpriteBatch::GetInstance()->EndCachedLayer();
+
+		m_bIsDirty = false;
+		++m_RedrawCount;
+	}
+
+	bool CachedLayer::UpdateRenderTarget()
+	{
+		//The texture matches the on-screen pixel size of the layer,
+		//so it has to follow the viewport when the window is resized.
+		float32 scale = ScaleSystem::GetInstance()->GetScale();
+		ivec2 dimensions(
+			int32(ceil(m_LayerDimensions.x * scale)),
+			int32(ceil(m_LayerDimensions.y * scale))
+			);
+
+		if(dimensions.x <= 0 || dimensions.y <= 0)
+		{
+			return false;
+		}
+
+		//The names of a lost context are dropped without deleting them,
+		//they could belong to new objects in the current one.
+		uint32 contextID = GraphicsManager::GetInstance()->GetContextID();
+		if(m_ContextID != contextID)
+		{
+			m_FrameBufferID = 0;
+			m_TextureID = 0;
+			m_TextureDimensions = ivec2(0, 0);
+			m_ContextID = contextID;
+		}
+
+		if(dimensions != m_TextureDimensions || m_FrameBufferID == 0)
+		{
+			DestroyRenderTarget();
+			CreateRenderTarget(dimensions);
+			m_bIsDirty = true;
+		}
+		return m_FrameBufferID != 0;
+	}
+
+	void CachedLayer::CreateRenderTarget(const ivec2 & dimensions)
+	{
+		glGenTextures(1, &m_TextureID);
+		glBindTexture(GL_TEXTURE_2D, m_TextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y,
+			0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		glGenFramebuffers(1, &m_FrameBufferID);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBufferID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_TEXTURE_2D, m_TextureID, 0);
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if(status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("CachedLayer '") + GetName() +
+				_T("': Could not create the render target, drawing uncached."),
+				STARENGINE_LOG_TAG);
+			DestroyRenderTarget();
+			m_bIsCachingEnabled = false;
+			return;
+		}
+
+		m_TextureDimensions = dimensions;
+
+		float32 scale = ScaleSystem::GetInstance()->GetScale();
+		m_pSpriteInfo->textureID = m_TextureID;
+		m_pSpriteInfo->uvCoords = vec4(
+			0, 0,
+			m_LayerDimensions.x * scale / dimensions.x,
+			m_LayerDimensions.y * scale / dimensions.y
+			);
+	}
+
+	void CachedLayer::DestroyRenderTarget()
+	{
+		if(m_FrameBufferID != 0)
+		{
+			SpriteBatch::DeleteFrameBuffer(m_FrameBufferID);
+			m_FrameBufferID = 0;
+		}
+		if(m_TextureID != 0)
+		{
+			SpriteBatch::DeleteTextures(1, &m_TextureID);
+			m_TextureID = 0;
+		}
+		m_TextureDimensions = ivec2(0, 0);
+	}
+}
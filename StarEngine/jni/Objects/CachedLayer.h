@@ -0,0 +1,86 @@
+#pragma once
+#include "../defines.h"
+#include "../Graphics/Color.h"
+#include "Object.h"
+
+#ifdef DESKTOP
+#include <glew.h>
+#else
+#include <GLES2/gl2.h>
+#endif
+
+namespace star
+{
+	struct SpriteInfo;
+
+	//Renders its children once into an offscreen texture and draws that
+	//texture as a single quad until one of them changes its transform,
+	//visibility, color or text. Children are laid out in the local space
+	//of the layer, which spans [0, width] x [0, height].
+	class CachedLayer : public Object
+	{
+	public:
+		CachedLayer(int32 width, int32 height);
+		CachedLayer(
+			const tstring & name,
+			int32 width,
+			int32 height
+			);
+		virtual ~CachedLayer(void);
+
+		virtual void BaseDraw();
+		virtual void BaseDrawWithCulling(
+			float32 left,
+			float32 right,
+			float32 top,
+			float32 bottom
+			);
+
+		void SetCachingEnabled(bool enabled);
+		bool IsCachingEnabled() const;
+
+		void SetHUDOptionEnabled(bool enabled);
+		bool IsHUDOptionEnabled() const;
+
+		void SetColorMultiplier(const Color & color);
+
+		void Invalidate();
+		bool IsDirty() const;
+
+		uint32 GetRedrawCount() const;
+
+	protected:
+		virtual void OnChildCacheDirty();
+
+		virtual bool CheckCulling(
+			float32 left,
+			float32 right,
+			float32 top,
+			float32 bottom
+			);
+
+	private:
+		void DrawLayer();
+		void DrawChildren();
+		void RenderToTexture();
+		bool UpdateRenderTarget();
+		void CreateRenderTarget(const ivec2 & dimensions);
+		void DestroyRenderTarget();
+
+		vec2 m_LayerDimensions;
+		ivec2 m_TextureDimensions;
+		GLuint	m_FrameBufferID,
+				m_TextureID;
+		//The OpenGL context the render target was created in.
+		uint32 m_ContextID;
+		SpriteInfo* m_pSpriteInfo;
+		uint32 m_RedrawCount;
+		bool	m_bIsDirty,
+				m_bIsCachingEnabled;
+
+		CachedLayer(const CachedLayer &);
+		CachedLayer(CachedLayer &&);
+		CachedLayer & operator=(const CachedLayer &);
+		CachedLayer & operator=(CachedLayer&&);
+	};
+}
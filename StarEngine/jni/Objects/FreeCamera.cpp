@@ -17,6 +17,7 @@ namespace star
 		,m_bisStatic(false)
 		,m_bZoom(false)
 	{
+		SetTickEnabled(true);
 	}
 
 	FreeCamera::~FreeCamera()
@@ -48,6 +49,11 @@ namespace star
 		m_MoveSpeed = speed;
 	}
 
+	uint32 FreeCamera::GetTypeID() const
+	{
+		return ObjectType::GetID<FreeCamera>();
+	}
+
 	void FreeCamera::Update(const Context& context)
 	{
 		if(m_pCamera->IsActive())
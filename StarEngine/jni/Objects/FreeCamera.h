@@ -16,6 +16,8 @@ namespace star
 		void SetZoomSpeed(float32 speed);
 		bool IsZoomEnabled() const;
 		void SetMoveSpeed(float32 speed);
+
+		virtual uint32 GetTypeID() const;
 		
 	protected:
 		virtual void Update(const Context& context);
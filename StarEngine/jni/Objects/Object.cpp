@@ -5,11 +5,15 @@
 #include "../Graphics/GraphicsManager.h"
 #include "../Scenes/BaseScene.h"
 #include "../Physics/Collision/CollisionManager.h"
+#include "../Helpers/MemoryPool.h"
+#include "../Components/TransformStore.h"
 #include <algorithm>
-#include <typeinfo>
 
 namespace star
 {
+	//Zero-initialized, see TypeIDSlot.
+	std::atomic<uint32> ObjectType::m_NextID;
+
 	Object::Object(void)
 		: Entity()
 		, m_bIsInitialized(false)
@@ -20,12 +24,31 @@ namespace star
 		, m_pScene(nullptr)
 		, m_pGarbageContainer()
 		, m_pComponents()
+		, m_ComponentTable()
+		, m_pTransform(nullptr)
 		, m_pChildren()
 		, m_pActions()
 		, m_GroupTag(_T("Default"))
 		, m_PhysicsTag(_T("Default"))
+		, m_Handle()
+		, m_SlotIndex(INVALID_SLOT)
+		, m_bIsGarbage(false)
+		, m_ChildNameIndex()
+		, m_ActionNameIndex()
+		, m_UpdateLOD(UpdateLOD::Full)
+		, m_LODAccumulatedTime(0)
+		, m_LODFrame(0)
+		, m_bUpdateLODEnabled(true)
+		, m_bUpdateSkipped(false)
+		, m_TickComponents()
+		, m_TickChildren()
+		, m_bTickEnabled(true)
+		, m_bTickDirty(true)
+		, m_bHasTickWork(true)
 	{
-		m_pComponents.push_back(new TransformComponent(this));
+		m_Handle = HandleTable<Object>::GetInstance()->Register(this);
+		m_pTransform = new TransformComponent(this);
+		AddComponent(m_pTransform);
 	}
 
 	Object::Object(const tstring & name)
@@ -38,12 +61,31 @@ namespace star
 		, m_pScene(nullptr)
 		, m_pGarbageContainer()
 		, m_pComponents()
+		, m_ComponentTable()
+		, m_pTransform(nullptr)
 		, m_pChildren()
 		, m_pActions()
 		, m_GroupTag(_T("Default"))
 		, m_PhysicsTag(_T("Default"))
+		, m_Handle()
+		, m_SlotIndex(INVALID_SLOT)
+		, m_bIsGarbage(false)
+		, m_ChildNameIndex()
+		, m_ActionNameIndex()
+		, m_UpdateLOD(UpdateLOD::Full)
+		, m_LODAccumulatedTime(0)
+		, m_LODFrame(0)
+		, m_bUpdateLODEnabled(true)
+		, m_bUpdateSkipped(false)
+		, m_TickComponents()
+		, m_TickChildren()
+		, m_bTickEnabled(true)
+		, m_bTickDirty(true)
+		, m_bHasTickWork(true)
 	{
-		m_pComponents.push_back(new TransformComponent(this));
+		m_Handle = HandleTable<Object>::GetInstance()->Register(this);
+		m_pTransform = new TransformComponent(this);
+		AddComponent(m_pTransform);
 	}
 
 	Object::Object(
@@ -59,16 +101,37 @@ namespace star
 		, m_pScene(nullptr)
 		, m_pGarbageContainer()
 		, m_pComponents()
+		, m_ComponentTable()
+		, m_pTransform(nullptr)
 		, m_pChildren()
 		, m_pActions()
 		, m_GroupTag(groupTag)
 		, m_PhysicsTag(_T("Default"))
+		, m_Handle()
+		, m_SlotIndex(INVALID_SLOT)
+		, m_bIsGarbage(false)
+		, m_ChildNameIndex()
+		, m_ActionNameIndex()
+		, m_UpdateLOD(UpdateLOD::Full)
+		, m_LODAccumulatedTime(0)
+		, m_LODFrame(0)
+		, m_bUpdateLODEnabled(true)
+		, m_bUpdateSkipped(false)
+		, m_TickComponents()
+		, m_TickChildren()
+		, m_bTickEnabled(true)
+		, m_bTickDirty(true)
+		, m_bHasTickWork(true)
 	{
-		m_pComponents.push_back(new TransformComponent(this));
+		m_Handle = HandleTable<Object>::GetInstance()->Register(this);
+		m_pTransform = new TransformComponent(this);
+		AddComponent(m_pTransform);
 	}
 
 	Object::~Object(void)
 	{
+		HandleTable<Object>::GetInstance()->Unregister(m_Handle);
+
 		for(auto & info : m_pGarbageContainer)
 		{
 			DestroyGarbageElement(info);
@@ -94,6 +157,16 @@ namespace star
 		m_pActions.clear();
 	}
 
+	void * Object::operator new(size_t size)
+	{
+		return MemoryPool::Allocate(size);
+	}
+
+	void Object::operator delete(void * pMemory, size_t size)
+	{
+		MemoryPool::Deallocate(pMemory, size);
+	}
+
 	void Object::Destroy()
 	{
 		if(m_pParentGameObject)
@@ -139,7 +212,6 @@ namespace star
 		{
 			if(child && !child->m_bIsInitialized)
 			{
-				child->SetScene(GetScene());
 				child->BaseInitialize();
 			}
 		}
@@ -165,13 +237,13 @@ namespace star
 				auto action = dynamic_cast<Action*>(info.Element);
 				auto it = std::find(m_pActions.begin(), m_pActions.end(), action);
 				m_pActions.erase(it);
+				m_ActionNameIndex.Remove(action->GetNameHash(), action);
 			}
 			break;
 			case GarbageType::ObjectType:
 			{
-				auto object = dynamic_cast<Object*>(info.Element);
-				auto it = std::find(m_pChildren.begin(), m_pChildren.end(), object);
-				m_pChildren.erase(it);
+				RemoveChildSlot(static_cast<Object*>(info.Element));
+				OnChildCacheDirty();
 			}
 			break;
 			case GarbageType::ComponentType:
@@ -179,7 +251,16 @@ namespace star
 				auto component = dynamic_cast<BaseComponent*>(info.Element);
 				auto it = std::find(m_pComponents.begin(), m_pComponents.end(), component);
 				m_pComponents.erase(it);
+				if(GetComponentByID(component->m_TypeID) == component)
+				{
+					m_ComponentTable[component->m_TypeID] = nullptr;
+				}
+				if(component == m_pTransform)
+				{
+					m_pTransform = nullptr;
+				}
 				RecalculateDimensions();
+				MarkCacheDirty();
 			}
 			break;
 		}
@@ -208,6 +289,128 @@ namespace star
 		transform->SetDimensions(dim);
 	}
 
+	void Object::MarkCacheDirty()
+	{
+		if(m_pParentGameObject)
+		{
+			m_pParentGameObject->OnChildCacheDirty();
+		}
+	}
+
+	void Object::OnChildCacheDirty()
+	{
+		MarkCacheDirty();
+	}
+
+	void Object::SetUpdateLODEnabled(bool enabled)
+	{
+		m_bUpdateLODEnabled = enabled;
+	}
+
+	bool Object::IsUpdateLODEnabled() const
+	{
+		return m_bUpdateLODEnabled;
+	}
+
+	UpdateLOD Object::GetUpdateLOD() const
+	{
+		return m_UpdateLOD;
+	}
+
+	bool Object::IsUpdateSkipped() const
+	{
+		return m_bUpdateSkipped;
+	}
+
+	uint32 Object::GetTypeID() const
+	{
+		return ObjectType::GetID<Object>();
+	}
+
+	void Object::Serialize(SnapshotWriter & writer) const
+	{
+	}
+
+	void Object::Deserialize(SnapshotReader & reader)
+	{
+	}
+
+	void Object::BaseUpdateLOD(const Context & context, UpdateLOD lod, uint32 interval)
+	{
+		//Spread the reduced updates of the objects over the interval.
+		if(lod == UpdateLOD::Reduced && m_UpdateLOD != UpdateLOD::Reduced)
+		{
+			m_LODFrame = m_SlotIndex % interval;
+		}
+		m_UpdateLOD = lod;
+
+		if(lod == UpdateLOD::Suspended)
+		{
+			//Time stands still for suspended objects.
+			m_LODAccumulatedTime = 0;
+			m_bUpdateSkipped = true;
+			CollectGarbage();
+			return;
+		}
+
+		if(lod == UpdateLOD::Reduced && ++m_LODFrame < interval)
+		{
+			m_LODAccumulatedTime += context.mTimeManager->GetSeconds();
+			m_bUpdateSkipped = true;
+			return;
+		}
+
+		m_LODFrame = 0;
+		m_bUpdateSkipped = false;
+		if(m_LODAccumulatedTime > 0)
+		{
+			//Catch up with the time of the skipped frames in one update.
+			TimeManager * timeManager = context.mTimeManager;
+			float64 delta = timeManager->GetSeconds();
+			timeManager->SetStepDelta(delta + m_LODAccumulatedTime);
+			m_LODAccumulatedTime = 0;
+			BaseUpdate(context);
+			timeManager->SetStepDelta(delta);
+		}
+		else
+		{
+			BaseUpdate(context);
+		}
+	}
+
+	void Object::ResetUpdateLOD()
+	{
+		m_UpdateLOD = UpdateLOD::Full;
+		m_LODAccumulatedTime = 0;
+		m_LODFrame = 0;
+		m_bUpdateSkipped = false;
+	}
+
+	bool Object::IsInUpdateRange(
+		float32 left, float32 right, float32 top, float32 bottom
+		)
+	{
+		//Objects without anything to draw are placed by their position.
+		const pos & position = GetTransform()->GetWorldPosition();
+		if(position.x >= left && position.x <= right
+			&& position.y >= bottom && position.y <= top)
+		{
+			return true;
+		}
+		if(BaseCheckCulling(left, right, top, bottom))
+		{
+			return true;
+		}
+		for(auto child : m_pChildren)
+		{
+			if(child && child->IsInUpdateRange(left, right, top, bottom))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	void Object::Initialize()
 	{
 	}
@@ -230,7 +433,14 @@ namespace star
 		CollectGarbage();
 		if(!m_IsFrozen)
 		{
-			Update(context);
+			if(m_bTickDirty)
+			{
+				RebuildTickList();
+			}
+			if(m_bTickEnabled)
+			{
+				Update(context);
+			}
 
 			for(auto action : m_pActions)
 			{
@@ -252,46 +462,101 @@ namespace star
 				}
 			}
 
-			for(auto component : m_pComponents)
+			//The lists only change in RebuildTickList, so components
+			//and children added during the update start next frame.
+			for(auto component : m_TickComponents)
 			{
-				if(component)
-				{
-					component->BaseUpdate(context);
-				}
-				else
-				{
-					m_pComponents.erase(
-						std::find(
-						m_pComponents.begin(),
-						m_pComponents.end(),
-						component)
-						);
-					Logger::GetInstance()->Log(LogLevel::Warning,
-						_T("Trying to update nullptr component from object '")
-						+ GetName() + _T("'."), STARENGINE_LOG_TAG);
-				}
+				component->BaseUpdate(context);
 			}
 
-			for(auto child : m_pChildren)
+			for(auto child : m_TickChildren)
 			{
-				if(child)
-				{
-					child->BaseUpdate(context);
-				}
-				else
-				{
-					m_pChildren.erase(
-						std::find(
-						m_pChildren.begin(),
-						m_pChildren.end(),
-						child)
-						);
-					Logger::GetInstance()->Log(LogLevel::Warning,
-						_T("Trying to update nullptr child from object '")
-						+ GetName() + _T("'."), STARENGINE_LOG_TAG);
-				}
+				child->BaseUpdate(context);
+			}
+		}
+	}
+
+	void Object::SetTickEnabled(bool enabled)
+	{
+		if(m_bTickEnabled != enabled)
+		{
+			m_bTickEnabled = enabled;
+			MarkTickDirty();
+		}
+	}
+
+	bool Object::IsTickEnabled() const
+	{
+		return m_bTickEnabled;
+	}
+
+	void Object::MarkTickDirty()
+	{
+		//A dirty object always has dirty ancestors, which rebuild it.
+		if(m_bTickDirty)
+		{
+			return;
+		}
+		m_bTickDirty = true;
+		if(m_pParentGameObject)
+		{
+			m_pParentGameObject->MarkTickDirty();
+		}
+		else if(m_pScene)
+		{
+			m_pScene->m_bTickListDirty = true;
+		}
+	}
+
+	bool Object::HasTickWork()
+	{
+		if(m_bTickDirty)
+		{
+			RebuildTickList();
+		}
+		return m_bHasTickWork;
+	}
+
+	void Object::RebuildTickList()
+	{
+		m_TickComponents.clear();
+		bool hasScheduledComponents(false);
+		for(auto component : m_pComponents)
+		{
+			if(component == nullptr)
+			{
+				continue;
+			}
+			//Scheduled components are updated per phase by the scene.
+			if(component->m_pScheduler != nullptr
+				&& UpdateScheduler::IsScheduledType(component->m_TypeID))
+			{
+				hasScheduledComponents = true;
+			}
+			else if(component->IsEnabled() && component->IsTickEnabled())
+			{
+				m_TickComponents.push_back(component);
 			}
 		}
+
+		m_TickChildren.clear();
+		for(auto child : m_pChildren)
+		{
+			if(child != nullptr && child->HasTickWork())
+			{
+				m_TickChildren.push_back(child);
+			}
+		}
+
+		//Objects with scheduled components stay, their update LOD
+		//decides whether the scheduler skips them.
+		m_bHasTickWork = m_bTickEnabled
+			|| hasScheduledComponents
+			|| !m_TickComponents.empty()
+			|| !m_TickChildren.empty()
+			|| !m_pActions.empty()
+			|| !m_pGarbageContainer.empty();
+		m_bTickDirty = false;
 	}
 
 	void Object::Draw()
@@ -413,11 +678,16 @@ namespace star
 		m_PhysicsTag.SetTag(tag);
 	}
 
-	bool Object::ComparePhysicsTag(const tstring & tag)
+	bool Object::ComparePhysicsTag(const tstring & tag) const
 	{
 		return m_PhysicsTag == tag;
 	}
 
+	bool Object::ComparePhysicsTag(uint32 hash) const
+	{
+		return m_PhysicsTag == hash;
+	}
+
 	bool CompareName(const tstring & name);
 
 	const tstring& Object::GetGroupTag() const
@@ -427,24 +697,45 @@ namespace star
 
 	void Object::SetGroupTag(const tstring& tag)
 	{
+		uint32 previousHash = m_GroupTag.GetHash();
 		m_GroupTag.SetTag(tag);
+		if(m_pScene && !m_pParentGameObject)
+		{
+			m_pScene->UpdateObjectGroup(this, previousHash);
+		}
 	}
 	
-	bool Object::CompareGroupTag(const tstring & tag)
+	bool Object::CompareGroupTag(const tstring & tag) const
 	{
 		return m_GroupTag == tag;
 	}
 
-	void Object::AddComponent(BaseComponent *pComponent)
+	bool Object::CompareGroupTag(uint32 hash) const
 	{
-		for(auto comp : m_pComponents)
+		return m_GroupTag == hash;
+	}
+
+	void Object::RegisterComponent(BaseComponent *pComponent, uint32 typeID)
+	{
+		//Only build the message when it's needed, this runs for every spawn.
+		if(GetComponentByID(typeID) != nullptr)
 		{
-			Logger::GetInstance()->Log(typeid(*comp) != typeid(*pComponent), 
+			Logger::GetInstance()->Log(false, 
 				_T("Object::AddComponent: \
 Adding 2 components of the same type \
 to the same object is illegal."), STARENGINE_LOG_TAG);
 		}
 
+		if(typeID >= m_ComponentTable.size())
+		{
+			m_ComponentTable.resize(typeID + 1, nullptr);
+		}
+		if(m_ComponentTable[typeID] == nullptr)
+		{
+			m_ComponentTable[typeID] = pComponent;
+		}
+		pComponent->m_TypeID = typeID;
+
 		pComponent->SetParent(this);
 
 		if(m_bIsInitialized && ! pComponent->IsInitialized())
@@ -453,33 +744,48 @@ to the same object is illegal."), STARENGINE_LOG_TAG);
 		}
 
 		m_pComponents.push_back(pComponent);
+		MarkCacheDirty();
+		MarkTickDirty();
 	}	
 
 	void Object::AddChild(Object *pChild)
 	{
 		pChild->m_pParentGameObject = this;
+		pChild->SetScene(GetScene());
+		pChild->GetTransform()->OnParentChanged();
 
 		if(m_bIsInitialized && !pChild->m_bIsInitialized)
 		{
-			pChild->SetScene(GetScene());
 			pChild->BaseInitialize();
 		}
 
+		pChild->m_SlotIndex = uint32(m_pChildren.size());
 		m_pChildren.push_back(pChild);
+		m_ChildNameIndex.Add(pChild->GetNameHash(), pChild);
+		OnChildCacheDirty();
+		MarkTickDirty();
 	}
 
 	void Object::RemoveChild(const Object* pObject)
 	{
-		auto it = std::find(m_pChildren.begin(), m_pChildren.end(), pObject);
-		bool isOK = it != m_pChildren.end();
+		bool isOK = pObject != nullptr
+			&& pObject->m_pParentGameObject == this
+			&& pObject->m_SlotIndex < m_pChildren.size()
+			&& m_pChildren[pObject->m_SlotIndex] == pObject;
 		if(isOK)
 		{
-			m_pGarbageContainer.push_back(
-				GarbageInfo(
-					*it,
-					GarbageType::ObjectType
-					)
-				);
+			Object * pChild = m_pChildren[pObject->m_SlotIndex];
+			if(!pChild->m_bIsGarbage)
+			{
+				pChild->m_bIsGarbage = true;
+				m_pGarbageContainer.push_back(
+					GarbageInfo(
+						pChild,
+						GarbageType::ObjectType
+						)
+					);
+				MarkTickDirty();
+			}
 		}
 		else
 		{
@@ -491,13 +797,11 @@ to remove is not a child of this object!"), STARENGINE_LOG_TAG);
 	
 	void Object::RemoveChild(const tstring & name)
 	{
-		for(auto child : m_pChildren)
+		auto child = m_ChildNameIndex.Find(GenerateHash(name));
+		if(child)
 		{
-			if(child->CompareName(name))
-			{
-				RemoveChild(child);
-				return;
-			}
+			RemoveChild(child);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Error,
 			_T("Object::RemoveChild: The object you tried \
@@ -511,13 +815,11 @@ to remove is not a child of this object!"), STARENGINE_LOG_TAG);
 
 	void Object::SetChildFrozen(const tstring & name, bool freeze)
 	{
-		for(auto child : m_pChildren)
+		auto child = m_ChildNameIndex.Find(GenerateHash(name));
+		if(child)
 		{
-			if(child->CompareName(name))
-			{
-				child->Freeze(freeze);
-				return;
-			}
+			child->Freeze(freeze);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("Object::SetChildFrozen: \
@@ -527,13 +829,11 @@ Trying to (un)freeze unknown child '")
 
 	void Object::SetChildDisabled(const tstring & name, bool disabled)
 	{
-		for(auto child : m_pChildren)
+		auto child = m_ChildNameIndex.Find(GenerateHash(name));
+		if(child)
 		{
-			if(child->CompareName(name))
-			{
-				child->SetDisabled(disabled);
-				return;
-			}
+			child->SetDisabled(disabled);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("Object::SetChildDisabled: \
@@ -543,13 +843,11 @@ Trying to enable/disable unknown child '")
 
 	void Object::SetChildVisible(const tstring & name, bool visible)
 	{
-		for(auto child : m_pChildren)
+		auto child = m_ChildNameIndex.Find(GenerateHash(name));
+		if(child)
 		{
-			if(child->CompareName(name))
-			{
-				child->SetVisible(visible);
-				return;
-			}
+			child->SetVisible(visible);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("Object::SetChildVisible: \
@@ -597,6 +895,8 @@ Trying to (un)hide unknown child '")
 			}
 		}
 		m_pActions.push_back(pAction);
+		m_ActionNameIndex.Add(pAction->GetNameHash(), pAction);
+		MarkTickDirty();
 		pAction->SetParent(this);
 		if(m_bIsInitialized)
 		{
@@ -619,18 +919,17 @@ to remove could not be found."), STARENGINE_LOG_TAG);
 					GarbageType::ActionType
 					)
 				);
+			MarkTickDirty();
 		}
 	}
 
 	void Object::RemoveAction(const tstring & name)
 	{
-		for(auto action : m_pActions)
+		auto action = m_ActionNameIndex.Find(GenerateHash(name));
+		if(action)
 		{
-			if(action->CompareName(name))
-			{
-				RemoveAction(action);
-				return;
-			}
+			RemoveAction(action);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 			_T("Object::RemoveAction: Action '")
@@ -639,13 +938,11 @@ to remove could not be found."), STARENGINE_LOG_TAG);
 
 	void Object::RestartAction(const tstring & name)
 	{
-		for(auto action : m_pActions)
+		auto action = m_ActionNameIndex.Find(GenerateHash(name));
+		if(action)
 		{
-			if(action->CompareName(name))
-			{
-				action->Restart();
-				return;
-			}
+			action->Restart();
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 			_T("Object::RestartAction: Action '")
@@ -654,13 +951,11 @@ to remove could not be found."), STARENGINE_LOG_TAG);
 
 	void Object::PauseAction(const tstring & name)
 	{
-		for(auto action : m_pActions)
+		auto action = m_ActionNameIndex.Find(GenerateHash(name));
+		if(action)
 		{
-			if(action->CompareName(name))
-			{
-				action->Pause();
-				return;
-			}
+			action->Pause();
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 			_T("Object::PauseAction: Action '")
@@ -669,13 +964,11 @@ to remove could not be found."), STARENGINE_LOG_TAG);
 
 	void Object::ResumeAction(const tstring & name)
 	{
-		for(auto action : m_pActions)
+		auto action = m_ActionNameIndex.Find(GenerateHash(name));
+		if(action)
 		{
-			if(action->CompareName(name))
-			{
-				action->Resume();
-				return;
-			}
+			action->Resume();
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 			_T("Object::ResumeAction: Action '")
@@ -697,6 +990,7 @@ to remove could not be found."));
 					GarbageType::ComponentType
 					)
 				);
+			MarkTickDirty();
 		}
 	}
 
@@ -707,6 +1001,7 @@ to remove could not be found."));
 		{
 			child->SetVisible(visible);
 		}
+		MarkCacheDirty();
 	}
 
 	bool Object::IsVisible() const
@@ -732,6 +1027,7 @@ to remove could not be found."));
 	{
 		m_IsVisible = !disabled;
 		m_IsFrozen = disabled;
+		MarkCacheDirty();
 	}
 
 	bool Object::IsDisabled() const
@@ -747,11 +1043,63 @@ to remove could not be found."));
 	void Object::SetScene(BaseScene * pScene)
 	{
 		m_pScene = pScene;
+#ifdef STAR2D
+		//The transform moves before the ones of the children,
+		//which are linked to it again in the new store.
+		if(m_pTransform)
+		{
+			m_pTransform->SetStore(pScene
+				? pScene->GetTransformStore().get()
+				: TransformStore::GetInstance());
+		}
+#endif
+		for(auto child : m_pChildren)
+		{
+			child->SetScene(pScene);
+		}
 	}
 
 	void Object::UnsetScene()
 	{
-		m_pScene = nullptr;
+		SetScene(nullptr);
+	}
+
+	const ObjectHandle & Object::GetHandle() const
+	{
+		return m_Handle;
+	}
+
+	void Object::RemoveChildSlot(Object * pChild)
+	{
+		//Swap-and-pop, the order of the children is not preserved.
+		uint32 index = pChild->m_SlotIndex;
+		Object * pLast = m_pChildren.back();
+		m_pChildren[index] = pLast;
+		pLast->m_SlotIndex = index;
+		m_pChildren.pop_back();
+		pChild->m_SlotIndex = INVALID_SLOT;
+		m_ChildNameIndex.Remove(pChild->GetNameHash(), pChild);
+	}
+
+	void Object::UpdateActionName(Action * pAction, uint32 previousHash)
+	{
+		m_ActionNameIndex.Move(previousHash, pAction->GetNameHash(), pAction);
+	}
+
+	void Object::OnNameChanged(uint32 previousHash)
+	{
+		if(m_pParentGameObject)
+		{
+			m_pParentGameObject->m_ChildNameIndex.Move(
+				previousHash,
+				GetNameHash(),
+				this
+				);
+		}
+		else if(m_pScene)
+		{
+			m_pScene->UpdateObjectName(this, previousHash);
+		}
 	}
 
 	void Object::Reset()
@@ -764,7 +1112,14 @@ to remove could not be found."));
 	
 	TransformComponent * Object::GetTransform() const
 	{
-		return GetComponent<TransformComponent>();
+		return m_pTransform;
+	}
+
+	BaseComponent * Object::GetComponentByID(uint32 typeID) const
+	{
+		return typeID < m_ComponentTable.size()
+			? m_ComponentTable[typeID]
+			: nullptr;
 	}
 	
 	BaseScene * Object::GetScene() const
@@ -779,6 +1134,10 @@ to remove could not be found."));
 
 	void Object::CollectGarbage()
 	{
+		if(m_pGarbageContainer.empty())
+		{
+			return;
+		}
 		for(auto & info : m_pGarbageContainer)
 		{
 			Logger::GetInstance()->Log(LogLevel::Info,
@@ -787,5 +1146,6 @@ to remove could not be found."));
 			DestroyGarbageElement(info);
 		}
 		m_pGarbageContainer.clear();
+		MarkTickDirty();
 	}
 }
@@ -7,6 +7,9 @@
 #include "../Components/TransformComponent.h"
 #include "../AI/Pathfinding/PathFindManager.h"
 #include "../Helpers/HashTag.h"
+#include "../Helpers/Handle.h"
+#include "../Helpers/HashIndex.h"
+#include "../Helpers/TypeID.h"
 #include "../Graphics/Color.h"
 
 namespace star
@@ -15,6 +18,33 @@ namespace star
 	class PathFindNodeComponent;
 	class BaseScene;
 	class Action;
+	class SnapshotWriter;
+	class SnapshotReader;
+
+	//How often an object is updated, chosen by the scene from its
+	//distance to the screen when the scene uses update LOD.
+	enum class UpdateLOD : byte
+	{
+		Full = 0,
+		Reduced = 1,
+		Suspended = 2
+	};
+
+	//Hands out a small integer per object type, like ComponentType does
+	//for components. Objects report theirs through GetTypeID.
+	class ObjectType final
+	{
+	public:
+		static const uint32 INVALID_ID = 0xFFFFFFFF;
+
+		template <typename T>
+		static uint32 GetID();
+
+	private:
+		static std::atomic<uint32> m_NextID;
+
+		ObjectType();
+	};
 
 	class Object : public Entity
 	{
@@ -27,6 +57,9 @@ namespace star
 			);
 		virtual ~Object(void);
 
+		static void * operator new(size_t size);
+		static void operator delete(void * pMemory, size_t size);
+
 		void Destroy();
 
 		Object* GetParent() const;
@@ -34,8 +67,8 @@ namespace star
 		void BaseInitialize();
 		void BaseAfterInitialized();
 		void BaseUpdate(const Context& context);
-		void BaseDraw();
-		void BaseDrawWithCulling(
+		virtual void BaseDraw();
+		virtual void BaseDrawWithCulling(
 			float32 left,
 			float32 right,
 			float32 top,
@@ -44,13 +77,21 @@ namespace star
 
 		const tstring& GetPhysicsTag() const;
 		void SetPhysicsTag(const tstring& tag);
-		bool ComparePhysicsTag(const tstring & tag);
+		bool ComparePhysicsTag(const tstring & tag) const;
+		template <uint32 N>
+		bool ComparePhysicsTag(const tchar (&tag)[N]) const;
+		bool ComparePhysicsTag(uint32 hash) const;
 
 		const tstring& GetGroupTag() const;
 		void SetGroupTag(const tstring& tag);
-		bool CompareGroupTag(const tstring & tag);
+		bool CompareGroupTag(const tstring & tag) const;
+		//Literals like _T("Enemy") are hashed at compile time.
+		template <uint32 N>
+		bool CompareGroupTag(const tchar (&tag)[N]) const;
+		bool CompareGroupTag(uint32 hash) const;
 
-		void AddComponent(BaseComponent* pComponent);
+		template <typename T>
+		void AddComponent(T* pComponent);
 
 		virtual void AddChild(Object* pObject);
 		void RemoveChild(const Object* pObject);
@@ -98,6 +139,8 @@ namespace star
 
 		BaseScene * GetScene() const;
 
+		const ObjectHandle & GetHandle() const;
+
 		template <typename T>
 		void RemoveComponent();
 
@@ -117,6 +160,33 @@ namespace star
 
 		void RecalculateDimensions();
 
+		void MarkCacheDirty();
+
+		//Gameplay-critical objects opt out to always update at full rate.
+		void SetUpdateLODEnabled(bool enabled);
+		bool IsUpdateLODEnabled() const;
+		UpdateLOD GetUpdateLOD() const;
+		//True when the update LOD skipped this object in the current frame.
+		bool IsUpdateSkipped() const;
+
+		//Objects tick by default. Objects without per-frame work of their
+		//own turn it off, their Update is no longer called. An object that
+		//doesn't tick and has no ticking components, actions or ticking
+		//children is left out of the update of its parent or scene.
+		void SetTickEnabled(bool enabled);
+		bool IsTickEnabled() const;
+		//Called when a component, action or child was added, removed
+		//or changed whether it ticks.
+		void MarkTickDirty();
+
+		//Scene snapshot hooks for the state of derived objects. Name,
+		//tags, transform, components, actions and children are stored already.
+		//Derived types that are stored in snapshots or prefabs
+		//override GetTypeID with ObjectType::GetID of themselves.
+		virtual uint32 GetTypeID() const;
+		virtual void Serialize(SnapshotWriter & writer) const;
+		virtual void Deserialize(SnapshotReader & reader);
+
 	protected:
 		enum class GarbageType : byte
 		{
@@ -154,6 +224,9 @@ namespace star
 			float32 bottom
 			);
 
+		virtual void OnChildCacheDirty();
+		virtual void OnNameChanged(uint32 previousHash);
+
 		bool m_bIsInitialized;
 		bool m_IsVisible;
 		bool m_IsFrozen;
@@ -164,13 +237,48 @@ namespace star
 		std::vector<GarbageInfo> m_pGarbageContainer;
 
 		std::vector<BaseComponent*> m_pComponents;
+		//Indexed by ComponentType ID, holds at most one component per type.
+		std::vector<BaseComponent*> m_ComponentTable;
+		TransformComponent* m_pTransform;
 		std::vector<Object*> m_pChildren;
 		std::vector<Action*> m_pActions;
 
 		HashTag m_GroupTag, m_PhysicsTag;
 
 	private:
+		friend class BaseScene;
+		friend class Action;
+		friend class SceneSnapshot;
+
+		static const uint32 INVALID_SLOT = 0xFFFFFFFF;
+
 		void CollectGarbage();
+		void RegisterComponent(BaseComponent* pComponent, uint32 typeID);
+		BaseComponent* GetComponentByID(uint32 typeID) const;
+		void RemoveChildSlot(Object* pChild);
+		void UpdateActionName(Action* pAction, uint32 previousHash);
+		void BaseUpdateLOD(const Context & context, UpdateLOD lod, uint32 interval);
+		void ResetUpdateLOD();
+		bool IsInUpdateRange(float32 left, float32 right, float32 top, float32 bottom);
+		bool HasTickWork();
+		void RebuildTickList();
+
+		ObjectHandle m_Handle;
+		//Index in the children of the parent or in the objects of the scene.
+		uint32 m_SlotIndex;
+		bool m_bIsGarbage;
+		HashIndex<Object> m_ChildNameIndex;
+		HashIndex<Action> m_ActionNameIndex;
+		UpdateLOD m_UpdateLOD;
+		float64 m_LODAccumulatedTime;
+		uint32 m_LODFrame;
+		bool m_bUpdateLODEnabled;
+		bool m_bUpdateSkipped;
+		std::vector<BaseComponent*> m_TickComponents;
+		std::vector<Object*> m_TickChildren;
+		bool m_bTickEnabled;
+		bool m_bTickDirty;
+		bool m_bHasTickWork;
 
 		Object(const Object& t);
 		Object(Object&& t);
@@ -3,28 +3,45 @@
 #include "../Entity.h"
 #include "../Logger.h"
 #include "../Context.h"
+#include "../Helpers/Helpers.h"
 #include "../Components/TransformComponent.h"
 #include "../Helpers/HashTag.h"
 
 namespace star
 {
+	template <typename T>
+	uint32 ObjectType::GetID()
+	{
+		return TakeTypeID(TypeIDSlot<ObjectType, T>::Value, m_NextID);
+	}
+
+	template <uint32 N>
+	bool Object::ComparePhysicsTag(const tchar (&tag)[N]) const
+	{
+		return ComparePhysicsTag(HashLiteral(tag));
+	}
+
+	template <uint32 N>
+	bool Object::CompareGroupTag(const tchar (&tag)[N]) const
+	{
+		return CompareGroupTag(HashLiteral(tag));
+	}
+
 	template <typename T>
 	T * Object::GetChildByName(const tstring & name)
 	{
-		for(auto child : m_pChildren)
+		auto child = m_ChildNameIndex.Find(GenerateHash(name));
+		if(child)
 		{
-			if(child->CompareName(name))
+			auto returnobject = dynamic_cast<T*>(child);
+			if(returnobject == nullptr)
 			{
-				auto returnobject = dynamic_cast<T*>(child);
-				if(returnobject == nullptr)
-				{
-					Logger::GetInstance()->Log(LogLevel::Error,
-						_T("Object::GetChildByName: couldn't convert object '")
-						+ name + _T("' to the requested type. Returning nullptr..."),
-						STARENGINE_LOG_TAG);
-				}
-				return returnobject;
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("Object::GetChildByName: couldn't convert object '")
+					+ name + _T("' to the requested type. Returning nullptr..."),
+					STARENGINE_LOG_TAG);
 			}
+			return returnobject;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("Object::GetChildByName: \
@@ -33,41 +50,51 @@ Trying to get unknown child '")
 		return nullptr;
 	}
 
+	template <typename T>
+	void Object::AddComponent(T * pComponent)
+	{
+		uint32 typeID = pComponent->GetTypeID();
+		if(typeID == ComponentType::INVALID_ID)
+		{
+			typeID = ComponentType::GetID<T>();
+		}
+		RegisterComponent(pComponent, typeID);
+	}
+
 	template <typename T>
 	void Object::RemoveComponent()
 	{
-		const std::type_info& ti = typeid(T);
-		for(auto component : m_pComponents)
+		auto component = GetComponentByID(ComponentType::GetID<T>());
+		if(component)
 		{
-			if(component && typeid(*component) == ti)
-			{
-				m_pGarbageContainer.push_back(
-					GarbageInfo(
-						component,
-						GarbageType::ComponentType
-						)
-					);
-			}
-		}	
+			m_pGarbageContainer.push_back(
+				GarbageInfo(
+					component,
+					GarbageType::ComponentType
+					)
+				);
+			MarkTickDirty();
+		}
 	}
 
 	template <typename T>
 	T* Object::GetComponent(bool searchChildren) const
 	{
-		const std::type_info& ti = typeid(T);
-		for(auto component : m_pComponents)
+		auto component = GetComponentByID(ComponentType::GetID<T>());
+		if(component)
 		{
-			if(component && typeid(*component) == ti)
-			{
-				return dynamic_cast<T*>(component);
-			}
+			return static_cast<T*>(component);
 		}
 
 		if(searchChildren)
 		{
 			for(auto child : m_pChildren)
 			{
-				return (child->GetComponent<T>(searchChildren));
+				T* childComponent = child->GetComponent<T>(searchChildren);
+				if(childComponent)
+				{
+					return childComponent;
+				}
 			}
 		}
 		return nullptr;
@@ -91,30 +118,22 @@ Trying to get unknown child '")
 	T* Object::GetChild(const tstring & name) const
 	{
 		const std::type_info& ti = typeid(T);
-		for(auto child : m_pChildren)
+		T* result(nullptr);
+		m_ChildNameIndex.ForEach(GenerateHash(name), [&](Object * child)
 		{
-			if(child && typeid(*child) == ti
-				&& child->GetName() == name)
+			if(result == nullptr && typeid(*child) == ti)
 			{
-				return dynamic_cast<T*>(child);
+				result = dynamic_cast<T*>(child);
 			}
-		}
-		return nullptr;
+		});
+		return result;
 	}
 
 	
 	template <typename T>
 	bool Object::HasComponent(BaseComponent * component) const
 	{
-		const std::type_info& ti = typeid(T);
-		for(auto comp : m_pComponents)
-		{
-			if(comp != component &&
-				typeid(*comp) == ti)
-			{
-				return true;
-			}
-		}
-		return false;
+		auto found = GetComponentByID(ComponentType::GetID<T>());
+		return found != nullptr && found != component;
 	}
 }
@@ -0,0 +1,93 @@
+#include "Prefab.h"
+#include "Object.h"
+#include "../Logger.h"
+#include "../Scenes/BaseScene.h"
+#include "../Scenes/SceneSnapshot.h"
+
+namespace star
+{
+	Prefab::Prefab(const Object * pTemplate)
+		: m_Template()
+	{
+		if(pTemplate == nullptr)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("Prefab::Prefab: Trying to make a prefab of a nullptr object."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		SnapshotWriter writer;
+		SceneSnapshot::WriteObjectTree(pTemplate, writer);
+		SnapshotReader reader(writer.GetData(), writer.GetSize());
+		SceneSnapshot::ReadObjectTree(reader, m_Template);
+	}
+
+	Prefab::~Prefab()
+	{
+	}
+
+	bool Prefab::IsValid() const
+	{
+		return !m_Template.Objects.empty();
+	}
+
+	Object * Prefab::Instantiate() const
+	{
+		if(m_Template.Objects.empty())
+		{
+			return nullptr;
+		}
+		return SceneSnapshot::BuildObjectTree(m_Template);
+	}
+
+	Object * Prefab::Instantiate(BaseScene * pScene, const pos & position) const
+	{
+		Object * pObject = Instantiate();
+		if(pObject != nullptr)
+		{
+			pObject->GetTransform()->Translate(position);
+			pScene->AddObject(pObject);
+		}
+		return pObject;
+	}
+
+	void Prefab::Instantiate(
+		BaseScene * pScene,
+		uint32 count,
+		std::vector<Object*> & instances
+		) const
+	{
+		instances.reserve(instances.size() + count);
+		pScene->ReserveObjects(count);
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			Object * pObject = Instantiate();
+			if(pObject == nullptr)
+			{
+				return;
+			}
+			pScene->AddObject(pObject);
+			instances.push_back(pObject);
+		}
+	}
+
+	void Prefab::Instantiate(
+		BaseScene * pScene,
+		const std::vector<pos> & positions,
+		std::vector<Object*> & instances
+		) const
+	{
+		instances.reserve(instances.size() + positions.size());
+		pScene->ReserveObjects(uint32(positions.size()));
+		for(const pos & position : positions)
+		{
+			Object * pObject = Instantiate(pScene, position);
+			if(pObject == nullptr)
+			{
+				return;
+			}
+			instances.push_back(pObject);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../defines.h"
+#include "../Scenes/SceneSnapshot.h"
+#include <vector>
+
+namespace star
+{
+	class Object;
+	class BaseScene;
+
+	//An object tree described once and copied many times. The tree is
+	//written to a scene snapshot and parsed into a template when the
+	//prefab is made, so spawning a copy only creates its objects,
+	//components and actions and hands them their own data. Textures and
+	//fonts are kept by path and name and looked up per copy, so copies
+	//made after the graphics context is recreated get the new ones.
+	//Every type in the tree has to be registered with SceneSnapshot.
+	class Prefab final
+	{
+	public:
+		//The template is only read, it can be deleted afterwards.
+		explicit Prefab(const Object * pTemplate);
+		~Prefab();
+
+		bool IsValid() const;
+
+		//The copy isn't added to a scene yet.
+		Object * Instantiate() const;
+		Object * Instantiate(BaseScene * pScene, const pos & position) const;
+
+		//Batch spawn, the copies are appended to instances.
+		void Instantiate(
+			BaseScene * pScene,
+			uint32 count,
+			std::vector<Object*> & instances
+			) const;
+		void Instantiate(
+			BaseScene * pScene,
+			const std::vector<pos> & positions,
+			std::vector<Object*> & instances
+			) const;
+
+	private:
+		SceneSnapshot::ObjectTreeTemplate m_Template;
+
+		Prefab(const Prefab &);
+		Prefab(Prefab &&);
+		Prefab & operator=(const Prefab &);
+		Prefab & operator=(Prefab &&);
+	};
+}
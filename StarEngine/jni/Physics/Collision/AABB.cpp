@@ -0,0 +1,92 @@
+#include "AABB.h"
+#include <algorithm>
+#include <cmath>
+
+namespace star
+{
+	AABB::AABB()
+		: Min()
+		, Max()
+	{
+	}
+
+	AABB::AABB(const vec2 & min, const vec2 & max)
+		: Min(min)
+		, Max(max)
+	{
+	}
+
+	bool AABB::Overlaps(const AABB & other) const
+	{
+		return Min.x <= other.Max.x && other.Min.x <= Max.x
+			&& Min.y <= other.Max.y && other.Min.y <= Max.y;
+	}
+
+	bool AABB::Equals(const AABB & other) const
+	{
+		return Min == other.Min && Max == other.Max;
+	}
+
+	bool AABB::Contains(const AABB & other) const
+	{
+		return Min.x <= other.Min.x && Min.y <= other.Min.y
+			&& other.Max.x <= Max.x && other.Max.y <= Max.y;
+	}
+
+	bool AABB::IntersectsSegment(const vec2 & from, const vec2 & to) const
+	{
+		//Clips the segment against the slab of each axis.
+		float32 enter(0.0f),
+			leave(1.0f);
+		const float32 start[2] = { from.x, from.y };
+		const float32 delta[2] = { to.x - from.x, to.y - from.y };
+		const float32 lower[2] = { Min.x, Min.y };
+		const float32 upper[2] = { Max.x, Max.y };
+		for(uint32 axis = 0 ; axis < 2 ; ++axis)
+		{
+			if(std::abs(delta[axis]) < 1e-6f)
+			{
+				if(start[axis] < lower[axis] || start[axis] > upper[axis])
+				{
+					return false;
+				}
+				continue;
+			}
+			float32 inverse = 1.0f / delta[axis];
+			float32 nearTime = (lower[axis] - start[axis]) * inverse;
+			float32 farTime = (upper[axis] - start[axis]) * inverse;
+			if(nearTime > farTime)
+			{
+				std::swap(nearTime, farTime);
+			}
+			enter = std::max(enter, nearTime);
+			leave = std::min(leave, farTime);
+			if(enter > leave)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	float32 AABB::GetPerimeter() const
+	{
+		return 2.0f * ((Max.x - Min.x) + (Max.y - Min.y));
+	}
+
+	void AABB::Combine(const AABB & first, const AABB & second)
+	{
+		Min.x = std::min(first.Min.x, second.Min.x);
+		Min.y = std::min(first.Min.y, second.Min.y);
+		Max.x = std::max(first.Max.x, second.Max.x);
+		Max.y = std::max(first.Max.y, second.Max.y);
+	}
+
+	void AABB::Expand(float32 margin)
+	{
+		Min.x -= margin;
+		Min.y -= margin;
+		Max.x += margin;
+		Max.y += margin;
+	}
+}
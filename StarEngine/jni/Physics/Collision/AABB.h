@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../../defines.h"
+
+namespace star
+{
+	//Axis aligned bounds of a collider, in the space the colliders
+	//test against each other. Touching bounds count as overlapping,
+	//so the broadphase never drops a pair the narrowphase would accept.
+	struct AABB
+	{
+		AABB();
+		AABB(const vec2 & min, const vec2 & max);
+
+		bool Overlaps(const AABB & other) const;
+		bool Equals(const AABB & other) const;
+		bool Contains(const AABB & other) const;
+		bool IntersectsSegment(const vec2 & from, const vec2 & to) const;
+
+		//Sum of the sides, the cost measure of the AABB tree.
+		float32 GetPerimeter() const;
+		void Combine(const AABB & first, const AABB & second);
+		void Expand(float32 margin);
+
+		vec2 Min;
+		vec2 Max;
+	};
+}
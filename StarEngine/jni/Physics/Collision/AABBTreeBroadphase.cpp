@@ -0,0 +1,75 @@
+#include "AABBTreeBroadphase.h"
+#include "../../Components/Physics/BaseColliderComponent.h"
+#include <algorithm>
+
+namespace star
+{
+	AABBTreeBroadphase::AABBTreeBroadphase()
+		: Broadphase()
+		, m_Tree()
+		, m_Proxies()
+		, m_Bounds()
+	{
+	}
+
+	AABBTreeBroadphase::~AABBTreeBroadphase()
+	{
+	}
+
+	void AABBTreeBroadphase::AddCollider(BaseColliderComponent * collider)
+	{
+		AABB bounds;
+		collider->GetBounds(bounds);
+		m_Proxies.push_back(m_Tree.CreateProxy(
+			bounds, collider, uint32(m_Proxies.size())));
+		m_Bounds.push_back(bounds);
+	}
+
+	void AABBTreeBroadphase::RemoveCollider(uint32 index)
+	{
+		m_Tree.DestroyProxy(m_Proxies[index]);
+		uint32 last = uint32(m_Proxies.size()) - 1;
+		if(index != last)
+		{
+			m_Proxies[index] = m_Proxies[last];
+			m_Bounds[index] = m_Bounds[last];
+			m_Tree.SetUserData(m_Proxies[index], index);
+		}
+		m_Proxies.pop_back();
+		m_Bounds.pop_back();
+	}
+
+	void AABBTreeBroadphase::FindPairs(std::vector<ColliderPair> & pairs)
+	{
+		pairs.clear();
+
+		uint32 count = uint32(m_Proxies.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			m_Tree.GetCollider(m_Proxies[i])->GetBounds(m_Bounds[i]);
+			m_Tree.MoveProxy(m_Proxies[i], m_Bounds[i]);
+		}
+
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			//The tree holds fat bounds, the tight ones filter what it finds.
+			auto callback = [&](int32 proxy) -> bool
+			{
+				uint32 other = m_Tree.GetUserData(proxy);
+				if(other > i && m_Bounds[i].Overlaps(m_Bounds[other]))
+				{
+					pairs.push_back(ColliderPair(i, other));
+				}
+				return true;
+			};
+			m_Tree.Query(m_Bounds[i], callback);
+		}
+
+		std::sort(pairs.begin(), pairs.end());
+	}
+
+	const AABB & AABBTreeBroadphase::GetBounds(uint32 index) const
+	{
+		return m_Bounds[index];
+	}
+}
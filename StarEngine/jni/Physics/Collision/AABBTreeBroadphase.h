@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "DynamicAABBTree.h"
+
+namespace star
+{
+	//Finds the pairs of a layer by querying a DynamicAABBTree with the
+	//bounds of every collider. Unlike a grid it doesn't depend on a cell
+	//size, so it suits layers mixing tiny and huge colliders.
+	class AABBTreeBroadphase final : public Broadphase
+	{
+	public:
+		AABBTreeBroadphase();
+		~AABBTreeBroadphase();
+
+		void AddCollider(BaseColliderComponent * collider);
+		void RemoveCollider(uint32 index);
+		void FindPairs(std::vector<ColliderPair> & pairs);
+		const AABB & GetBounds(uint32 index) const;
+
+	private:
+		DynamicAABBTree m_Tree;
+		//Proxy and tight bounds of every collider, by layer index.
+		std::vector<int32> m_Proxies;
+		std::vector<AABB> m_Bounds;
+
+		AABBTreeBroadphase(const AABBTreeBroadphase &);
+		AABBTreeBroadphase(AABBTreeBroadphase &&);
+		AABBTreeBroadphase & operator=(const AABBTreeBroadphase &);
+		AABBTreeBroadphase & operator=(AABBTreeBroadphase &&);
+	};
+}
@@ -0,0 +1,35 @@
+#include "Broadphase.h"
+
+namespace star
+{
+	ColliderPair::ColliderPair()
+		: First(0)
+		, Second(0)
+	{
+	}
+
+	ColliderPair::ColliderPair(uint32 first, uint32 second)
+		: First(first)
+		, Second(second)
+	{
+	}
+
+	bool ColliderPair::operator==(const ColliderPair & other) const
+	{
+		return First == other.First && Second == other.Second;
+	}
+
+	bool ColliderPair::operator<(const ColliderPair & other) const
+	{
+		return First < other.First
+			|| (First == other.First && Second < other.Second);
+	}
+
+	Broadphase::Broadphase()
+	{
+	}
+
+	Broadphase::~Broadphase()
+	{
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../defines.h"
+#include "AABB.h"
+#include <vector>
+
+namespace star
+{
+	class BaseColliderComponent;
+
+	enum class BroadphaseType : byte
+	{
+		SpatialHash = 0,
+		SweepAndPrune = 1,
+		AABBTree = 2
+	};
+
+	//Two colliders of a layer, by their index in that layer.
+	//First is always the lower index.
+	struct ColliderPair
+	{
+		ColliderPair();
+		ColliderPair(uint32 first, uint32 second);
+
+		bool operator==(const ColliderPair & other) const;
+		bool operator<(const ColliderPair & other) const;
+
+		uint32 First;
+		uint32 Second;
+	};
+
+	//Culls the pairs of a collision layer that can't collide, so only
+	//the remaining ones go through the CollidesWith tests. A collider
+	//is known by its index in the layer: an added collider gets the next
+	//index and removing one moves the last collider into its index.
+	class Broadphase
+	{
+	public:
+		virtual ~Broadphase();
+
+		virtual void AddCollider(BaseColliderComponent * collider) = 0;
+		virtual void RemoveCollider(uint32 index) = 0;
+
+		//Picks up the colliders that moved since the last call and
+		//fills pairs with every pair whose bounds overlap, sorted.
+		virtual void FindPairs(std::vector<ColliderPair> & pairs) = 0;
+		//The bounds of a collider as of the last FindPairs.
+		virtual const AABB & GetBounds(uint32 index) const = 0;
+
+	protected:
+		Broadphase();
+
+	private:
+		Broadphase(const Broadphase &);
+		Broadphase(Broadphase &&);
+		Broadphase & operator=(const Broadphase &);
+		Broadphase & operator=(Broadphase &&);
+	};
+}
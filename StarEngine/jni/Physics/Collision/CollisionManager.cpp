@@ -2,11 +2,38 @@
 #include "../../StarComponents.h"
 #include <algorithm>
 #include "../../Components/Physics/BaseColliderComponent.h"
+#include "../../Helpers/JobSystem.h"
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+#include "AABBTreeBroadphase.h"
 
 namespace star
 {
+	CollisionManager::CollisionLayer::CollisionLayer()
+		: Colliders()
+		, pBroadphase(nullptr)
+		, CellSize(SpatialHashGrid::DEFAULT_CELL_SIZE)
+		, StaticColliders()
+		, pStaticTree(nullptr)
+		, bStaticDirty(false)
+	{
+	}
+
 	CollisionManager::CollisionManager(void)
 		: m_CollisionMap()
+		, m_Pairs()
+		, m_StaticPairs()
+		, m_PairResults()
+		, m_Hits()
+		, m_bCollidersRemoved(false)
+		, m_Contacts()
+		, m_Frame(0)
+		, m_PotentialPairCount(0)
+		, m_BroadphasePairCount(0)
+		, m_BroadphaseType(BroadphaseType::SpatialHash)
+		, m_QueryTree()
+		, m_QueryProxies()
+		, m_bStaticQueriesDirty(false)
 	{
 	}
 	
@@ -14,6 +41,11 @@ namespace star
 	{
 		//Components get deleted by their parent objects,
 		//which get deleted from the scene, don't delete them here
+		for(auto& key : m_CollisionMap)
+		{
+			delete key.second.pBroadphase;
+			delete key.second.pStaticTree;
+		}
 		m_CollisionMap.clear();
 	}
 
@@ -22,55 +54,58 @@ namespace star
 		const tstring* layers, 
 		uint8 n)
 	{
+		if(m_QueryProxies.find(component) == m_QueryProxies.end())
+		{
+			AABB bounds;
+			component->GetBounds(bounds);
+			m_QueryProxies[component] = m_QueryTree.CreateProxy(bounds, component);
+		}
+
 		for(uint8 i = 0; i < n; ++i)
 		{
-			//If the layer already exists
-			auto it = m_CollisionMap.find(layers[i]);
-			if(it != m_CollisionMap.end())
+			CollisionLayer & layer = GetLayer(layers[i]);
+			//If the component isn't in the vector already
+			if(std::find(layer.Colliders.begin(), layer.Colliders.end(), component)
+					!= layer.Colliders.end()
+				|| std::find(layer.StaticColliders.begin(), layer.StaticColliders.end(), component)
+					!= layer.StaticColliders.end())
 			{
-				//If the component isn't in the vector already
-				auto vecIt = std::find((*it).second.begin(), (*it).second.end(), component);
-				if(vecIt != (*it).second.end())
-				{
-					Logger::GetInstance()->Log(false, _T("CollisionManager::AddComponent \
+				Logger::GetInstance()->Log(false, _T("CollisionManager::AddComponent \
 The component you tried to add is already in the CollisionManager"));
-				}
-				else
-				{
-					(*it).second.push_back(component);
-				}
 			}
-			//make a new layer!
+			else if(component->IsStatic())
+			{
+				layer.StaticColliders.push_back(component);
+				layer.bStaticDirty = true;
+			}
 			else
 			{
-				m_CollisionMap.insert(
-					std::pair<tstring, std::vector<BaseColliderComponent*>>(
-					layers[i],std::vector<BaseColliderComponent*>()));
-				m_CollisionMap.at(layers[i]).push_back(component);
+				layer.Colliders.push_back(component);
+				layer.pBroadphase->AddCollider(component);
 			}
 		}
 	}
 
 	void CollisionManager::RemoveComponent(const BaseColliderComponent* component)
 	{
+		auto proxy = m_QueryProxies.find(component);
+		if(proxy != m_QueryProxies.end())
+		{
+			m_QueryTree.DestroyProxy((*proxy).second);
+			m_QueryProxies.erase(proxy);
+		}
+		//Removed colliders leave without an exit.
+		m_Contacts.RemoveCollider(component);
+		m_bCollidersRemoved = true;
+
 		const tstring* layers = component->GetLayers().elements;
 		uint8 n = component->GetLayers().amount;
 		for(uint8 i = 0; i < n; ++i)
 		{
 			auto it = m_CollisionMap.find(layers[i]);
 			if(it != m_CollisionMap.end())
-			{				
-				auto vecIt = std::find((*it).second.begin(), (*it).second.end(), component);
-				if(vecIt != (*it).second.end())
-				{
-					(*it).second.erase(
-						std::remove(
-							(*it).second.begin(),
-							(*it).second.end(),
-							component),
-						(*it).second.end());
-				}
-				else
+			{
+				if(!RemoveFromLayer((*it).second, component))
 				{
 					Logger::GetInstance()->Log(false, _T("CollisionManager::RemoveComponent: \
 The component you tried to remove is not in the CollisionManager"), STARENGINE_LOG_TAG);
@@ -90,48 +125,441 @@ The component you tried to remove is not in the CollisionManager"), STARENGINE_L
 
 	void CollisionManager::Update(const Context& context)
 	{
+		m_PotentialPairCount = 0;
+		m_BroadphasePairCount = 0;
+		++m_Frame;
+		//Before the callbacks, which may query.
+		RefreshQueryTree();
 		for(auto& key : m_CollisionMap)
 		{
+			CollisionLayer & layer = key.second;
+			if(layer.bStaticDirty)
+			{
+				BuildStaticTree(layer);
+			}
 
-			for(auto iter1 = key.second.begin(); iter1 != key.second.end(); ++iter1)
+			uint32 count = uint32(layer.Colliders.size() + layer.StaticColliders.size());
+			m_PotentialPairCount += count > 1 ? count * (count - 1) / 2 : 0;
+
+			layer.pBroadphase->FindPairs(m_Pairs);
+			FindStaticPairs(layer);
+			m_BroadphasePairCount += uint32(m_Pairs.size() + m_StaticPairs.size());
+
+			//The pair tests run in parallel, the enter and stay callbacks
+			//fire afterwards on this thread, in the order of the pairs.
+			TestLayerPairs(layer);
+			ApplyLayerContacts(layer);
+		}
+		ApplyExits();
+	}
+
+	void CollisionManager::SetBroadphaseType(BroadphaseType type)
+	{
+		if(type == m_BroadphaseType)
+		{
+			return;
+		}
+
+		//The colliders keep their indices, so the contacts stay valid.
+		m_BroadphaseType = type;
+		for(auto& key : m_CollisionMap)
+		{
+			CollisionLayer & layer = key.second;
+			delete layer.pBroadphase;
+			CreateBroadphase(layer);
+			for(auto collider : layer.Colliders)
 			{
-				for(auto iter2 = iter1 +1; iter2 != key.second.end(); ++iter2)
-				{
-					if(iter1 != iter2)
-					{
-						if((*iter1)->CollidesWith(*iter2))
-						{
-							if(!(*iter1)->GetEntered())
-							{
-								(*iter1)->SetEntered(true);
-								(*iter2)->SetEntered(true);
-								(*iter1)->SetExited(false);
-								(*iter2)->SetExited(false);
-								(*iter1)->TriggerOnEnter(*iter2);
-								(*iter2)->TriggerOnEnter(*iter1);
-								continue;
-							}
-							else
-							{
-								(*iter1)->TriggerOnStay(*iter2);
-								(*iter2)->TriggerOnStay(*iter1);
-							}
-						}
-						else
-						{
-							if(!(*iter1)->GetExited())
-							{
-								(*iter1)->SetEntered(false);
-								(*iter2)->SetEntered(false);
-								(*iter1)->SetExited(true);
-								(*iter2)->SetExited(true);
-								(*iter1)->TriggerOnExit(*iter2);
-								(*iter2)->TriggerOnExit(*iter1);
-							}
-						}
-					}
-				}
+				layer.pBroadphase->AddCollider(collider);
+			}
+		}
+	}
+
+	BroadphaseType CollisionManager::GetBroadphaseType() const
+	{
+		return m_BroadphaseType;
+	}
+
+	void CollisionManager::UpdateStaticState(BaseColliderComponent * component)
+	{
+		const tstring* layers = component->GetLayers().elements;
+		uint8 n = component->GetLayers().amount;
+		for(uint8 i = 0; i < n; ++i)
+		{
+			auto it = m_CollisionMap.find(layers[i]);
+			if(it == m_CollisionMap.end() || !RemoveFromLayer((*it).second, component))
+			{
+				continue;
+			}
+
+			CollisionLayer & layer = (*it).second;
+			if(component->IsStatic())
+			{
+				layer.StaticColliders.push_back(component);
+				layer.bStaticDirty = true;
+			}
+			else
+			{
+				layer.Colliders.push_back(component);
+				layer.pBroadphase->AddCollider(component);
+			}
+		}
+
+		//Static colliders are skipped when the query tree is refreshed.
+		auto proxy = m_QueryProxies.find(component);
+		if(proxy != m_QueryProxies.end())
+		{
+			AABB bounds;
+			component->GetBounds(bounds);
+			m_QueryTree.MoveProxy((*proxy).second, bounds);
+		}
+	}
+
+	void CollisionManager::RebuildStaticColliders()
+	{
+		for(auto& key : m_CollisionMap)
+		{
+			key.second.bStaticDirty = true;
+		}
+		m_bStaticQueriesDirty = true;
+	}
+
+	void CollisionManager::SetLayerCellSize(const tstring & layer, float32 cellSize)
+	{
+		if(cellSize <= 0.0f)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("CollisionManager::SetLayerCellSize: The cell size has to be positive."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		CollisionLayer & collisionLayer = GetLayer(layer);
+		collisionLayer.CellSize = cellSize;
+		if(m_BroadphaseType == BroadphaseType::SpatialHash)
+		{
+			static_cast<SpatialHashGrid*>(collisionLayer.pBroadphase)->SetCellSize(cellSize);
+		}
+	}
+
+	float32 CollisionManager::GetLayerCellSize(const tstring & layer) const
+	{
+		auto it = m_CollisionMap.find(layer);
+		if(it == m_CollisionMap.end())
+		{
+			return SpatialHashGrid::DEFAULT_CELL_SIZE;
+		}
+		return (*it).second.CellSize;
+	}
+
+	uint32 CollisionManager::GetPotentialPairCount() const
+	{
+		return m_PotentialPairCount;
+	}
+
+	uint32 CollisionManager::GetBroadphasePairCount() const
+	{
+		return m_BroadphasePairCount;
+	}
+
+	uint32 CollisionManager::GetContactCount() const
+	{
+		return m_Contacts.GetCount();
+	}
+
+	void CollisionManager::QueryAABB(
+		const AABB & bounds,
+		std::vector<BaseColliderComponent*> & colliders
+		) const
+	{
+		colliders.clear();
+
+		auto callback = [&](int32 proxy) -> bool
+		{
+			BaseColliderComponent * collider = m_QueryTree.GetCollider(proxy);
+			AABB colliderBounds;
+			collider->GetBounds(colliderBounds);
+			if(colliderBounds.Overlaps(bounds))
+			{
+				colliders.push_back(collider);
+			}
+			return true;
+		};
+		m_QueryTree.Query(bounds, callback);
+	}
+
+	void CollisionManager::RayCast(
+		const vec2 & from,
+		const vec2 & to,
+		std::vector<BaseColliderComponent*> & colliders
+		) const
+	{
+		colliders.clear();
+
+		auto callback = [&](int32 proxy) -> bool
+		{
+			BaseColliderComponent * collider = m_QueryTree.GetCollider(proxy);
+			if(collider->CollidesWithLine(from, to))
+			{
+				colliders.push_back(collider);
+			}
+			return true;
+		};
+		m_QueryTree.RayCast(from, to, callback);
+	}
+
+	CollisionManager::CollisionLayer & CollisionManager::GetLayer(const tstring & name)
+	{
+		auto it = m_CollisionMap.find(name);
+		if(it == m_CollisionMap.end())
+		{
+			//make a new layer!
+			it = m_CollisionMap.insert(
+				std::pair<tstring, CollisionLayer>(name, CollisionLayer())).first;
+			CreateBroadphase((*it).second);
+			(*it).second.pStaticTree = new DynamicAABBTree(0.0f);
+		}
+		return (*it).second;
+	}
+
+	void CollisionManager::CreateBroadphase(CollisionLayer & layer) const
+	{
+		switch(m_BroadphaseType)
+		{
+		case BroadphaseType::SweepAndPrune:
+			layer.pBroadphase = new SweepAndPrune();
+			break;
+		case BroadphaseType::AABBTree:
+			layer.pBroadphase = new AABBTreeBroadphase();
+			break;
+		default:
+			layer.pBroadphase = new SpatialHashGrid(layer.CellSize);
+			break;
+		}
+	}
+
+	void CollisionManager::BuildStaticTree(CollisionLayer & layer)
+	{
+		layer.pStaticTree->Clear();
+		AABB bounds;
+		for(uint32 i = 0 ; i < layer.StaticColliders.size() ; ++i)
+		{
+			layer.StaticColliders[i]->GetBounds(bounds);
+			layer.pStaticTree->CreateProxy(bounds, layer.StaticColliders[i], i);
+		}
+		layer.bStaticDirty = false;
+	}
+
+	void CollisionManager::FindStaticPairs(const CollisionLayer & layer)
+	{
+		m_StaticPairs.clear();
+		if(layer.StaticColliders.empty())
+		{
+			return;
+		}
+
+		//The broadphase refreshed the bounds of the other colliders already.
+		for(uint32 i = 0 ; i < layer.Colliders.size() ; ++i)
+		{
+			auto callback = [&](int32 proxy) -> bool
+			{
+				m_StaticPairs.push_back(ColliderPair(i, layer.pStaticTree->GetUserData(proxy)));
+				return true;
+			};
+			layer.pStaticTree->Query(layer.pBroadphase->GetBounds(i), callback);
+		}
+	}
+
+	bool CollisionManager::RemoveFromLayer(
+		CollisionLayer & layer,
+		const BaseColliderComponent * component
+		)
+	{
+		auto vecIt = std::find(layer.Colliders.begin(), layer.Colliders.end(), component);
+		if(vecIt != layer.Colliders.end())
+		{
+			//Swap-and-pop, the broadphase moves its last collider the same way.
+			uint32 index = uint32(vecIt - layer.Colliders.begin());
+			*vecIt = layer.Colliders.back();
+			layer.Colliders.pop_back();
+			layer.pBroadphase->RemoveCollider(index);
+			return true;
+		}
+
+		vecIt = std::find(layer.StaticColliders.begin(), layer.StaticColliders.end(), component);
+		if(vecIt != layer.StaticColliders.end())
+		{
+			*vecIt = layer.StaticColliders.back();
+			layer.StaticColliders.pop_back();
+			layer.bStaticDirty = true;
+			return true;
+		}
+		return false;
+	}
+
+	void CollisionManager::TestLayerPairs(const CollisionLayer & layer)
+	{
+		uint32 pairCount = uint32(m_Pairs.size());
+		uint32 count = pairCount + uint32(m_StaticPairs.size());
+		m_PairResults.resize(count);
+
+		JobSystem::GetInstance()->ParallelFor(0, count, PAIR_GRAIN_SIZE,
+			[&](uint32 first, uint32 last)
+		{
+			TestPairs(layer, first, last);
+		});
+	}
+
+	void CollisionManager::TestPairs(
+		const CollisionLayer & layer,
+		uint32 first,
+		uint32 last
+		)
+	{
+		uint32 pairCount = uint32(m_Pairs.size());
+		for(uint32 i = first ; i < last ; ++i)
+		{
+			if(i < pairCount)
+			{
+				const ColliderPair & pair = m_Pairs[i];
+				m_PairResults[i] = layer.Colliders[pair.First]->CollidesWith(
+					layer.Colliders[pair.Second]) ? 1 : 0;
+			}
+			else
+			{
+				const ColliderPair & pair = m_StaticPairs[i - pairCount];
+				m_PairResults[i] = layer.Colliders[pair.First]->CollidesWith(
+					layer.StaticColliders[pair.Second]) ? 1 : 0;
+			}
+		}
+	}
+
+	void CollisionManager::BenchmarkPairTests()
+	{
+		for(auto& key : m_CollisionMap)
+		{
+			CollisionLayer & layer = key.second;
+			if(layer.bStaticDirty)
+			{
+				BuildStaticTree(layer);
+			}
+
+			layer.pBroadphase->FindPairs(m_Pairs);
+			FindStaticPairs(layer);
+			uint32 count = uint32(m_Pairs.size() + m_StaticPairs.size());
+			m_PairResults.resize(count);
+
+			JobSystem::GetInstance()->Benchmark(
+				_T("CollisionManager pairs of layer ") + key.first,
+				0, count, PAIR_GRAIN_SIZE,
+				[&](uint32 first, uint32 last)
+			{
+				TestPairs(layer, first, last);
+			});
+		}
+		m_Pairs.clear();
+		m_StaticPairs.clear();
+		m_PairResults.clear();
+	}
+
+	void CollisionManager::ApplyLayerContacts(const CollisionLayer & layer)
+	{
+		//The pairs hold indices into the layer, which SetAsStatic or
+		//RemoveComponent called from a callback swap around. So all
+		//colliding pairs are resolved to colliders first.
+		m_Hits.clear();
+		uint32 pairCount = uint32(m_Pairs.size());
+		uint32 count = uint32(m_PairResults.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			if(m_PairResults[i] == 0)
+			{
+				continue;
+			}
+
+			if(i < pairCount)
+			{
+				m_Hits.push_back(std::make_pair(
+					layer.Colliders[m_Pairs[i].First],
+					layer.Colliders[m_Pairs[i].Second]));
+			}
+			else
+			{
+				const ColliderPair & pair = m_StaticPairs[i - pairCount];
+				m_Hits.push_back(std::make_pair(
+					layer.Colliders[pair.First],
+					layer.StaticColliders[pair.Second]));
+			}
+		}
+
+		//Only the pairs that collide are looked up, a pair that is already
+		//a contact gets one stay per update, even when it shares more than
+		//one layer.
+		m_bCollidersRemoved = false;
+		for(auto & hit : m_Hits)
+		{
+			BaseColliderComponent * collider1 = hit.first;
+			BaseColliderComponent * collider2 = hit.second;
+			//Removed colliders stay allocated until the end of the frame,
+			//but may not become contacts again.
+			if(m_bCollidersRemoved
+				&& (m_QueryProxies.find(collider1) == m_QueryProxies.end()
+					|| m_QueryProxies.find(collider2) == m_QueryProxies.end()))
+			{
+				continue;
+			}
+			bool isNew(false);
+			ContactSet::Contact & contact = m_Contacts.Add(collider1, collider2, isNew);
+			if(!isNew && contact.Frame == m_Frame)
+			{
+				continue;
+			}
+			contact.Frame = m_Frame;
+
+			if(isNew)
+			{
+				collider1->TriggerOnEnter(collider2);
+				collider2->TriggerOnEnter(collider1);
+			}
+			else
+			{
+				collider1->TriggerOnStay(collider2);
+				collider2->TriggerOnStay(collider1);
+			}
+		}
+	}
+
+	void CollisionManager::ApplyExits()
+	{
+		uint32 index(0);
+		while(index < m_Contacts.GetCount())
+		{
+			ContactSet::Contact & contact = m_Contacts.GetContact(index);
+			if(contact.Frame == m_Frame)
+			{
+				++index;
+				continue;
+			}
+
+			BaseColliderComponent * collider1 = contact.pFirst;
+			BaseColliderComponent * collider2 = contact.pSecond;
+			m_Contacts.RemoveAt(index);
+			collider1->TriggerOnExit(collider2);
+			collider2->TriggerOnExit(collider1);
+		}
+	}
+
+	void CollisionManager::RefreshQueryTree()
+	{
+		AABB bounds;
+		for(auto & proxy : m_QueryProxies)
+		{
+			if(proxy.first->IsStatic() && !m_bStaticQueriesDirty)
+			{
+				continue;
 			}
+			proxy.first->GetBounds(bounds);
+			m_QueryTree.MoveProxy(proxy.second, bounds);
 		}
+		m_bStaticQueriesDirty = false;
 	}
 }
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "../../defines.h"
+#include "Broadphase.h"
+#include "DynamicAABBTree.h"
+#include "ContactSet.h"
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace star
 {
@@ -23,9 +27,102 @@ namespace star
 		void RemoveComponent(const BaseColliderComponent* component);
 		void Update(const Context& context);
 
+		//The broadphase every layer sorts its colliders in, only the pairs
+		//it keeps are tested against each other. A spatial hash by default,
+		//sweep and prune fits layers spread out along one axis and
+		//the AABB tree layers mixing very small and very large colliders.
+		void SetBroadphaseType(BroadphaseType type);
+		BroadphaseType GetBroadphaseType() const;
+
+		//Colliders set as static are kept out of the broadphase, in a tree
+		//per layer that is only rebuilt when static colliders are added or
+		//removed. Static colliders are never tested against each other.
+		//Called by SetAsStatic, to move a registered collider over.
+		void UpdateStaticState(BaseColliderComponent * component);
+		//Call after moving static colliders.
+		void RebuildStaticColliders();
+
+		//Only used by the spatial hash.
+		void SetLayerCellSize(const tstring & layer, float32 cellSize);
+		float32 GetLayerCellSize(const tstring & layer) const;
+
+		//Stats of the last update: the pairs the layers hold in total,
+		//and the pairs left over by the broadphase for the narrowphase.
+		uint32 GetPotentialPairCount() const;
+		uint32 GetBroadphasePairCount() const;
+		//Pairs of colliders that are touching.
+		uint32 GetContactCount() const;
+
+		//Logs how the pair tests of every layer scale over the workers of
+		//the JobSystem, on the pairs the broadphases find right now.
+		//Contacts and callbacks are left alone. Like JobSystem::Benchmark
+		//it may only be called while no jobs are queued,
+		//StarEngine::BenchmarkJobSystem takes care of that.
+		void BenchmarkPairTests();
+
+		//Queries over the colliders of all layers, in no particular order.
+		//They go through an AABB tree which is brought up to date once at
+		//the start of every update, and only read it afterwards.
+		void QueryAABB(
+			const AABB & bounds,
+			std::vector<BaseColliderComponent*> & colliders
+			) const;
+		void RayCast(
+			const vec2 & from,
+			const vec2 & to,
+			std::vector<BaseColliderComponent*> & colliders
+			) const;
+
 	private:
 
-		std::map<tstring, std::vector<BaseColliderComponent*>> m_CollisionMap;
+		static const uint32 PAIR_GRAIN_SIZE = 64;
+
+		struct CollisionLayer
+		{
+			CollisionLayer();
+
+			//The colliders that aren't static.
+			std::vector<BaseColliderComponent*> Colliders;
+			Broadphase * pBroadphase;
+			float32 CellSize;
+			std::vector<BaseColliderComponent*> StaticColliders;
+			DynamicAABBTree * pStaticTree;
+			bool bStaticDirty;
+		};
+
+		CollisionLayer & GetLayer(const tstring & name);
+		void CreateBroadphase(CollisionLayer & layer) const;
+		void BuildStaticTree(CollisionLayer & layer);
+		void FindStaticPairs(const CollisionLayer & layer);
+		static bool RemoveFromLayer(
+			CollisionLayer & layer,
+			const BaseColliderComponent * component
+			);
+		void TestLayerPairs(const CollisionLayer & layer);
+		void TestPairs(const CollisionLayer & layer, uint32 first, uint32 last);
+		void ApplyLayerContacts(const CollisionLayer & layer);
+		void ApplyExits();
+		void RefreshQueryTree();
+
+		std::map<tstring, CollisionLayer> m_CollisionMap;
+		//Broadphase pairs of the current layer and the result of their test,
+		//followed by the pairs of a collider and a static collider.
+		std::vector<ColliderPair> m_Pairs;
+		std::vector<ColliderPair> m_StaticPairs;
+		std::vector<uint8> m_PairResults;
+		//The colliding pairs of the current layer, resolved before any
+		//callback fires, callbacks may reorder or leave the layer.
+		std::vector<std::pair<BaseColliderComponent*, BaseColliderComponent*>> m_Hits;
+		bool m_bCollidersRemoved;
+		//Contacts that weren't found again in an update have ended.
+		ContactSet m_Contacts;
+		uint32 m_Frame;
+		uint32 m_PotentialPairCount,
+			m_BroadphasePairCount;
+		BroadphaseType m_BroadphaseType;
+		DynamicAABBTree m_QueryTree;
+		std::unordered_map<const BaseColliderComponent*, int32> m_QueryProxies;
+		bool m_bStaticQueriesDirty;
 
 		CollisionManager(const CollisionManager& yRef);
 		CollisionManager(CollisionManager&& yRef);
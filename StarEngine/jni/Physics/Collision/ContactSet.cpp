@@ -0,0 +1,172 @@
+#include "ContactSet.h"
+#include <functional>
+#include <algorithm>
+
+namespace star
+{
+	ContactSet::ContactSet()
+		: m_Contacts()
+		, m_Slots(MIN_CAPACITY, uint32(EMPTY_SLOT))
+		, m_Mask(MIN_CAPACITY - 1)
+	{
+	}
+
+	ContactSet::~ContactSet()
+	{
+	}
+
+	ContactSet::Contact & ContactSet::Add(
+		BaseColliderComponent * first,
+		BaseColliderComponent * second,
+		bool & isNew
+		)
+	{
+		if(std::less<BaseColliderComponent*>()(second, first))
+		{
+			std::swap(first, second);
+		}
+
+		//Probe sequences stay short as long as the table is at most half full.
+		if((m_Contacts.size() + 1) * 2 > m_Slots.size())
+		{
+			Rehash(uint32(m_Slots.size()) * 2);
+		}
+
+		uint32 slot = FindSlot(first, second);
+		if(m_Slots[slot] != EMPTY_SLOT)
+		{
+			isNew = false;
+			return m_Contacts[m_Slots[slot]];
+		}
+
+		Contact contact;
+		contact.pFirst = first;
+		contact.pSecond = second;
+		contact.Frame = 0;
+		m_Slots[slot] = uint32(m_Contacts.size());
+		m_Contacts.push_back(contact);
+		isNew = true;
+		return m_Contacts.back();
+	}
+
+	bool ContactSet::Contains(
+		const BaseColliderComponent * first,
+		const BaseColliderComponent * second
+		) const
+	{
+		return m_Slots[FindSlot(first, second)] != EMPTY_SLOT;
+	}
+
+	void ContactSet::RemoveAt(uint32 index)
+	{
+		const Contact & contact = m_Contacts[index];
+		uint32 hole = FindSlot(contact.pFirst, contact.pSecond);
+		m_Slots[hole] = EMPTY_SLOT;
+
+		//Shifts the entries after the hole back, so no probe sequence is
+		//broken and the table never needs tombstones. An entry can fill
+		//the hole when the hole lies between its home slot and itself.
+		uint32 next = (hole + 1) & m_Mask;
+		while(m_Slots[next] != EMPTY_SLOT)
+		{
+			const Contact & entry = m_Contacts[m_Slots[next]];
+			uint32 home = Hash(entry.pFirst, entry.pSecond) & m_Mask;
+			if(((next - home) & m_Mask) >= ((next - hole) & m_Mask))
+			{
+				m_Slots[hole] = m_Slots[next];
+				m_Slots[next] = EMPTY_SLOT;
+				hole = next;
+			}
+			next = (next + 1) & m_Mask;
+		}
+
+		uint32 last = uint32(m_Contacts.size()) - 1;
+		if(index != last)
+		{
+			m_Contacts[index] = m_Contacts[last];
+			m_Slots[FindSlot(m_Contacts[index].pFirst, m_Contacts[index].pSecond)] = index;
+		}
+		m_Contacts.pop_back();
+	}
+
+	void ContactSet::RemoveCollider(const BaseColliderComponent * collider)
+	{
+		uint32 index(0);
+		while(index < m_Contacts.size())
+		{
+			const Contact & contact = m_Contacts[index];
+			if(contact.pFirst == collider || contact.pSecond == collider)
+			{
+				RemoveAt(index);
+			}
+			else
+			{
+				++index;
+			}
+		}
+	}
+
+	void ContactSet::Clear()
+	{
+		m_Contacts.clear();
+		m_Slots.assign(m_Slots.size(), uint32(EMPTY_SLOT));
+	}
+
+	uint32 ContactSet::GetCount() const
+	{
+		return uint32(m_Contacts.size());
+	}
+
+	ContactSet::Contact & ContactSet::GetContact(uint32 index)
+	{
+		return m_Contacts[index];
+	}
+
+	uint32 ContactSet::Hash(
+		const BaseColliderComponent * first,
+		const BaseColliderComponent * second
+		)
+	{
+		uint64 a = uint64(size_t(first)),
+			b = uint64(size_t(second));
+		uint64 hash = a * 0x9E3779B97F4A7C15ULL ^ (b + (a << 6) + (a >> 2));
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		return uint32(hash);
+	}
+
+	uint32 ContactSet::FindSlot(
+		const BaseColliderComponent * first,
+		const BaseColliderComponent * second
+		) const
+	{
+		if(std::less<const BaseColliderComponent*>()(second, first))
+		{
+			std::swap(first, second);
+		}
+
+		//Either the slot of the pair or the empty slot it would go in.
+		uint32 slot = Hash(first, second) & m_Mask;
+		while(m_Slots[slot] != EMPTY_SLOT)
+		{
+			const Contact & contact = m_Contacts[m_Slots[slot]];
+			if(contact.pFirst == first && contact.pSecond == second)
+			{
+				break;
+			}
+			slot = (slot + 1) & m_Mask;
+		}
+		return slot;
+	}
+
+	void ContactSet::Rehash(uint32 capacity)
+	{
+		m_Slots.assign(capacity, uint32(EMPTY_SLOT));
+		m_Mask = capacity - 1;
+		for(uint32 i = 0 ; i < m_Contacts.size() ; ++i)
+		{
+			m_Slots[FindSlot(m_Contacts[i].pFirst, m_Contacts[i].pSecond)] = i;
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../defines.h"
+#include <vector>
+
+namespace star
+{
+	class BaseColliderComponent;
+
+	//The pairs of colliders that are touching, keyed by the pair. The
+	//contacts are kept in a dense array, so walking them costs as much
+	//as there are contacts, and an open addressing table with linear
+	//probing finds a pair in that array. Removing a contact moves the
+	//last one in its place.
+	class ContactSet final
+	{
+	public:
+		struct Contact
+		{
+			BaseColliderComponent * pFirst;
+			BaseColliderComponent * pSecond;
+			//The last update the pair was found touching.
+			uint32 Frame;
+		};
+
+		ContactSet();
+		~ContactSet();
+
+		//The order of the colliders doesn't matter. Returns the contact of
+		//the pair, adding it with a frame of 0 when it didn't exist yet.
+		Contact & Add(
+			BaseColliderComponent * first,
+			BaseColliderComponent * second,
+			bool & isNew
+			);
+		bool Contains(
+			const BaseColliderComponent * first,
+			const BaseColliderComponent * second
+			) const;
+		void RemoveAt(uint32 index);
+		//Drops the contacts of a collider that's going away.
+		void RemoveCollider(const BaseColliderComponent * collider);
+		void Clear();
+
+		uint32 GetCount() const;
+		Contact & GetContact(uint32 index);
+
+	private:
+		static const uint32 EMPTY_SLOT = 0xFFFFFFFF;
+		static const uint32 MIN_CAPACITY = 64;
+
+		static uint32 Hash(
+			const BaseColliderComponent * first,
+			const BaseColliderComponent * second
+			);
+		uint32 FindSlot(
+			const BaseColliderComponent * first,
+			const BaseColliderComponent * second
+			) const;
+		void Rehash(uint32 capacity);
+
+		std::vector<Contact> m_Contacts;
+		//Index of a contact in m_Contacts, or EMPTY_SLOT.
+		std::vector<uint32> m_Slots;
+		uint32 m_Mask;
+
+		ContactSet(const ContactSet &);
+		ContactSet(ContactSet &&);
+		ContactSet & operator=(const ContactSet &);
+		ContactSet & operator=(ContactSet &&);
+	};
+}
@@ -0,0 +1,372 @@
+#include "DynamicAABBTree.h"
+#include <algorithm>
+
+namespace star
+{
+	const float32 DynamicAABBTree::DEFAULT_MARGIN = 8.0f;
+
+	DynamicAABBTree::Node::Node()
+		: Bounds()
+		, pCollider(nullptr)
+		, UserData(0)
+		, Parent(NULL_NODE)
+		, Child1(NULL_NODE)
+		, Child2(NULL_NODE)
+		, Height(-1)
+	{
+	}
+
+	bool DynamicAABBTree::Node::IsLeaf() const
+	{
+		return Child1 == NULL_NODE;
+	}
+
+	DynamicAABBTree::DynamicAABBTree(float32 margin)
+		: m_Nodes()
+		, m_Root(NULL_NODE)
+		, m_FreeList(NULL_NODE)
+		, m_ProxyCount(0)
+		, m_Margin(margin)
+	{
+	}
+
+	DynamicAABBTree::~DynamicAABBTree()
+	{
+	}
+
+	int32 DynamicAABBTree::CreateProxy(
+		const AABB & bounds,
+		BaseColliderComponent * collider,
+		uint32 userData
+		)
+	{
+		int32 proxy = AllocateNode();
+		Node & node = m_Nodes[proxy];
+		node.Bounds = bounds;
+		node.Bounds.Expand(m_Margin);
+		node.pCollider = collider;
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(proxy);
+		++m_ProxyCount;
+		return proxy;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32 proxy)
+	{
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--m_ProxyCount;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32 proxy, const AABB & bounds)
+	{
+		if(m_Nodes[proxy].Bounds.Contains(bounds))
+		{
+			return false;
+		}
+
+		RemoveLeaf(proxy);
+		m_Nodes[proxy].Bounds = bounds;
+		m_Nodes[proxy].Bounds.Expand(m_Margin);
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NULL_NODE;
+		m_FreeList = NULL_NODE;
+		m_ProxyCount = 0;
+	}
+
+	BaseColliderComponent * DynamicAABBTree::GetCollider(int32 proxy) const
+	{
+		return m_Nodes[proxy].pCollider;
+	}
+
+	uint32 DynamicAABBTree::GetUserData(int32 proxy) const
+	{
+		return m_Nodes[proxy].UserData;
+	}
+
+	void DynamicAABBTree::SetUserData(int32 proxy, uint32 userData)
+	{
+		m_Nodes[proxy].UserData = userData;
+	}
+
+	const AABB & DynamicAABBTree::GetFatBounds(int32 proxy) const
+	{
+		return m_Nodes[proxy].Bounds;
+	}
+
+	int32 DynamicAABBTree::GetHeight() const
+	{
+		return m_Root == NULL_NODE ? 0 : m_Nodes[m_Root].Height;
+	}
+
+	uint32 DynamicAABBTree::GetProxyCount() const
+	{
+		return m_ProxyCount;
+	}
+
+	int32 DynamicAABBTree::AllocateNode()
+	{
+		int32 node;
+		if(m_FreeList == NULL_NODE)
+		{
+			node = int32(m_Nodes.size());
+			m_Nodes.push_back(Node());
+		}
+		else
+		{
+			node = m_FreeList;
+			m_FreeList = m_Nodes[node].Parent;
+			m_Nodes[node] = Node();
+		}
+		return node;
+	}
+
+	void DynamicAABBTree::FreeNode(int32 node)
+	{
+		m_Nodes[node].Parent = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_Nodes[node].pCollider = nullptr;
+		m_FreeList = node;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32 leaf)
+	{
+		if(m_Root == NULL_NODE)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = NULL_NODE;
+			return;
+		}
+
+		//Walks down to the sibling that grows the tree the least,
+		//by the perimeter the new parent and its ancestors gain.
+		AABB leafBounds = m_Nodes[leaf].Bounds;
+		int32 index = m_Root;
+		while(!m_Nodes[index].IsLeaf())
+		{
+			const Node & node = m_Nodes[index];
+			float32 perimeter = node.Bounds.GetPerimeter();
+
+			AABB combined;
+			combined.Combine(node.Bounds, leafBounds);
+			float32 combinedPerimeter = combined.GetPerimeter();
+
+			//Cost of a new parent for this node and the leaf,
+			//and the cost pushed down to the children.
+			float32 cost = 2.0f * combinedPerimeter;
+			float32 inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+			float32 childCosts[2];
+			const int32 children[2] = { node.Child1, node.Child2 };
+			for(uint32 i = 0 ; i < 2 ; ++i)
+			{
+				const Node & child = m_Nodes[children[i]];
+				AABB childCombined;
+				childCombined.Combine(child.Bounds, leafBounds);
+				childCosts[i] = child.IsLeaf()
+					? childCombined.GetPerimeter() + inheritanceCost
+					: childCombined.GetPerimeter() - child.Bounds.GetPerimeter()
+						+ inheritanceCost;
+			}
+
+			if(cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+			index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+		}
+
+		int32 sibling = index;
+		int32 oldParent = m_Nodes[sibling].Parent;
+		int32 newParent = AllocateNode();
+		Node & parent = m_Nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Bounds.Combine(leafBounds, m_Nodes[sibling].Bounds);
+		parent.Height = m_Nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if(oldParent == NULL_NODE)
+		{
+			m_Root = newParent;
+		}
+		else
+		{
+			ReplaceChild(oldParent, sibling, newParent);
+		}
+
+		RefitFrom(m_Nodes[leaf].Parent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32 leaf)
+	{
+		if(leaf == m_Root)
+		{
+			m_Root = NULL_NODE;
+			return;
+		}
+
+		int32 parent = m_Nodes[leaf].Parent;
+		int32 grandParent = m_Nodes[parent].Parent;
+		int32 sibling = m_Nodes[parent].Child1 == leaf
+			? m_Nodes[parent].Child2
+			: m_Nodes[parent].Child1;
+
+		//The sibling takes the place of the parent.
+		m_Nodes[sibling].Parent = grandParent;
+		if(grandParent == NULL_NODE)
+		{
+			m_Root = sibling;
+		}
+		else
+		{
+			ReplaceChild(grandParent, parent, sibling);
+		}
+		FreeNode(parent);
+
+		RefitFrom(grandParent);
+	}
+
+	void DynamicAABBTree::RefitFrom(int32 node)
+	{
+		int32 index = node;
+		while(index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			Node & current = m_Nodes[index];
+			const Node & child1 = m_Nodes[current.Child1];
+			const Node & child2 = m_Nodes[current.Child2];
+			current.Height = 1 + std::max(child1.Height, child2.Height);
+			current.Bounds.Combine(child1.Bounds, child2.Bounds);
+
+			index = current.Parent;
+		}
+	}
+
+	int32 DynamicAABBTree::Balance(int32 a)
+	{
+		Node & nodeA = m_Nodes[a];
+		if(nodeA.IsLeaf() || nodeA.Height < 2)
+		{
+			return a;
+		}
+
+		int32 b = nodeA.Child1;
+		int32 c = nodeA.Child2;
+		Node & nodeB = m_Nodes[b];
+		Node & nodeC = m_Nodes[c];
+		int32 balance = nodeC.Height - nodeB.Height;
+
+		if(balance > 1)
+		{
+			//Rotates C up, A takes the lower child of C.
+			int32 f = nodeC.Child1;
+			int32 g = nodeC.Child2;
+			Node & nodeF = m_Nodes[f];
+			Node & nodeG = m_Nodes[g];
+
+			nodeC.Child1 = a;
+			nodeC.Parent = nodeA.Parent;
+			nodeA.Parent = c;
+			if(nodeC.Parent == NULL_NODE)
+			{
+				m_Root = c;
+			}
+			else
+			{
+				ReplaceChild(nodeC.Parent, a, c);
+			}
+
+			if(nodeF.Height > nodeG.Height)
+			{
+				nodeC.Child2 = f;
+				nodeA.Child2 = g;
+				nodeG.Parent = a;
+				nodeA.Bounds.Combine(nodeB.Bounds, nodeG.Bounds);
+				nodeC.Bounds.Combine(nodeA.Bounds, nodeF.Bounds);
+				nodeA.Height = 1 + std::max(nodeB.Height, nodeG.Height);
+				nodeC.Height = 1 + std::max(nodeA.Height, nodeF.Height);
+			}
+			else
+			{
+				nodeC.Child2 = g;
+				nodeA.Child2 = f;
+				nodeF.Parent = a;
+				nodeA.Bounds.Combine(nodeB.Bounds, nodeF.Bounds);
+				nodeC.Bounds.Combine(nodeA.Bounds, nodeG.Bounds);
+				nodeA.Height = 1 + std::max(nodeB.Height, nodeF.Height);
+				nodeC.Height = 1 + std::max(nodeA.Height, nodeG.Height);
+			}
+			return c;
+		}
+
+		if(balance < -1)
+		{
+			//Rotates B up, A takes the lower child of B.
+			int32 d = nodeB.Child1;
+			int32 e = nodeB.Child2;
+			Node & nodeD = m_Nodes[d];
+			Node & nodeE = m_Nodes[e];
+
+			nodeB.Child1 = a;
+			nodeB.Parent = nodeA.Parent;
+			nodeA.Parent = b;
+			if(nodeB.Parent == NULL_NODE)
+			{
+				m_Root = b;
+			}
+			else
+			{
+				ReplaceChild(nodeB.Parent, a, b);
+			}
+
+			if(nodeD.Height > nodeE.Height)
+			{
+				nodeB.Child2 = d;
+				nodeA.Child1 = e;
+				nodeE.Parent = a;
+				nodeA.Bounds.Combine(nodeC.Bounds, nodeE.Bounds);
+				nodeB.Bounds.Combine(nodeA.Bounds, nodeD.Bounds);
+				nodeA.Height = 1 + std::max(nodeC.Height, nodeE.Height);
+				nodeB.Height = 1 + std::max(nodeA.Height, nodeD.Height);
+			}
+			else
+			{
+				nodeB.Child2 = e;
+				nodeA.Child1 = d;
+				nodeD.Parent = a;
+				nodeA.Bounds.Combine(nodeC.Bounds, nodeD.Bounds);
+				nodeB.Bounds.Combine(nodeA.Bounds, nodeE.Bounds);
+				nodeA.Height = 1 + std::max(nodeC.Height, nodeD.Height);
+				nodeB.Height = 1 + std::max(nodeA.Height, nodeE.Height);
+			}
+			return b;
+		}
+
+		return a;
+	}
+
+	void DynamicAABBTree::ReplaceChild(int32 parent, int32 oldChild, int32 newChild)
+	{
+		Node & node = m_Nodes[parent];
+		if(node.Child1 == oldChild)
+		{
+			node.Child1 = newChild;
+		}
+		else
+		{
+			node.Child2 = newChild;
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../../defines.h"
+#include "AABB.h"
+#include <vector>
+
+namespace star
+{
+	class BaseColliderComponent;
+
+	//Bounding volume hierarchy over collider bounds. Leaves hold fat
+	//bounds, the tight bounds grown by a margin, so a collider that moves
+	//a little stays in its leaf. New leaves are placed where they grow
+	//the tree the least and rotations keep it balanced, so queries stay
+	//logarithmic however much the collider sizes differ.
+	class DynamicAABBTree final
+	{
+	public:
+		static const int32 NULL_NODE = -1;
+		static const float32 DEFAULT_MARGIN;
+		//Queries traverse with a stack of this size on the call stack.
+		//It holds at most the height of the tree plus one, which the
+		//balancing keeps far below this for any number of proxies.
+		static const int32 STACK_SIZE = 256;
+
+		explicit DynamicAABBTree(float32 margin = DEFAULT_MARGIN);
+		~DynamicAABBTree();
+
+		int32 CreateProxy(
+			const AABB & bounds,
+			BaseColliderComponent * collider,
+			uint32 userData = 0
+			);
+		void DestroyProxy(int32 proxy);
+		//Returns true when the proxy left its fat bounds and was reinserted.
+		bool MoveProxy(int32 proxy, const AABB & bounds);
+		void Clear();
+
+		BaseColliderComponent * GetCollider(int32 proxy) const;
+		uint32 GetUserData(int32 proxy) const;
+		void SetUserData(int32 proxy, uint32 userData);
+		const AABB & GetFatBounds(int32 proxy) const;
+		int32 GetHeight() const;
+		uint32 GetProxyCount() const;
+
+		//The callbacks get the proxy of every leaf whose fat bounds are hit
+		//and return false to stop the query. Queries only read the tree,
+		//so they can run from several threads at once.
+		template <typename T>
+		void Query(const AABB & bounds, T & callback) const;
+		template <typename T>
+		void RayCast(const vec2 & from, const vec2 & to, T & callback) const;
+
+	private:
+		struct Node
+		{
+			Node();
+
+			bool IsLeaf() const;
+
+			AABB Bounds;
+			BaseColliderComponent * pCollider;
+			uint32 UserData;
+			//Links the free nodes when the node isn't used.
+			int32 Parent;
+			int32 Child1,
+				Child2;
+			//0 for leaves, -1 for free nodes.
+			int32 Height;
+		};
+
+		int32 AllocateNode();
+		void FreeNode(int32 node);
+		void InsertLeaf(int32 leaf);
+		void RemoveLeaf(int32 leaf);
+		void RefitFrom(int32 node);
+		int32 Balance(int32 node);
+		void ReplaceChild(int32 parent, int32 oldChild, int32 newChild);
+
+		std::vector<Node> m_Nodes;
+		int32 m_Root,
+			m_FreeList;
+		uint32 m_ProxyCount;
+		float32 m_Margin;
+
+		DynamicAABBTree(const DynamicAABBTree &);
+		DynamicAABBTree(DynamicAABBTree &&);
+		DynamicAABBTree & operator=(const DynamicAABBTree &);
+		DynamicAABBTree & operator=(DynamicAABBTree &&);
+	};
+}
+
+#include "DynamicAABBTree.inl"
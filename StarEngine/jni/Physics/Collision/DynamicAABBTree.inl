@@ -0,0 +1,68 @@
+namespace star
+{
+	template <typename T>
+	void DynamicAABBTree::Query(const AABB & bounds, T & callback) const
+	{
+		int32 stack[STACK_SIZE];
+		int32 count(0);
+		stack[count++] = m_Root;
+		while(count > 0)
+		{
+			int32 index = stack[--count];
+			if(index == NULL_NODE)
+			{
+				continue;
+			}
+
+			const Node & node = m_Nodes[index];
+			if(node.Bounds.Overlaps(bounds))
+			{
+				if(node.IsLeaf())
+				{
+					if(!callback(index))
+					{
+						return;
+					}
+				}
+				else
+				{
+					stack[count++] = node.Child1;
+					stack[count++] = node.Child2;
+				}
+			}
+		}
+	}
+
+	template <typename T>
+	void DynamicAABBTree::RayCast(const vec2 & from, const vec2 & to, T & callback) const
+	{
+		int32 stack[STACK_SIZE];
+		int32 count(0);
+		stack[count++] = m_Root;
+		while(count > 0)
+		{
+			int32 index = stack[--count];
+			if(index == NULL_NODE)
+			{
+				continue;
+			}
+
+			const Node & node = m_Nodes[index];
+			if(node.Bounds.IntersectsSegment(from, to))
+			{
+				if(node.IsLeaf())
+				{
+					if(!callback(index))
+					{
+						return;
+					}
+				}
+				else
+				{
+					stack[count++] = node.Child1;
+					stack[count++] = node.Child2;
+				}
+			}
+		}
+	}
+}
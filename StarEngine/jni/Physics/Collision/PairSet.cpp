@@ -0,0 +1,123 @@
+#include "PairSet.h"
+
+namespace star
+{
+	PairSet::PairSet()
+		: m_Pairs()
+		, m_Slots(MIN_CAPACITY, uint32(EMPTY_SLOT))
+		, m_Mask(MIN_CAPACITY - 1)
+	{
+	}
+
+	PairSet::~PairSet()
+	{
+	}
+
+	bool PairSet::Add(const ColliderPair & pair)
+	{
+		//Probe sequences stay short as long as the table is at most half full.
+		if((m_Pairs.size() + 1) * 2 > m_Slots.size())
+		{
+			Rehash(uint32(m_Slots.size()) * 2);
+		}
+
+		uint32 slot = FindSlot(pair);
+		if(m_Slots[slot] != EMPTY_SLOT)
+		{
+			return false;
+		}
+		m_Slots[slot] = uint32(m_Pairs.size());
+		m_Pairs.push_back(pair);
+		return true;
+	}
+
+	bool PairSet::Remove(const ColliderPair & pair)
+	{
+		uint32 index = m_Slots[FindSlot(pair)];
+		if(index == EMPTY_SLOT)
+		{
+			return false;
+		}
+		RemoveAt(index);
+		return true;
+	}
+
+	void PairSet::RemoveAt(uint32 index)
+	{
+		uint32 hole = FindSlot(m_Pairs[index]);
+		m_Slots[hole] = EMPTY_SLOT;
+
+		//Backward shift deletion, the same as in the ContactSet.
+		uint32 next = (hole + 1) & m_Mask;
+		while(m_Slots[next] != EMPTY_SLOT)
+		{
+			uint32 home = Hash(m_Pairs[m_Slots[next]]) & m_Mask;
+			if(((next - home) & m_Mask) >= ((next - hole) & m_Mask))
+			{
+				m_Slots[hole] = m_Slots[next];
+				m_Slots[next] = EMPTY_SLOT;
+				hole = next;
+			}
+			next = (next + 1) & m_Mask;
+		}
+
+		uint32 last = uint32(m_Pairs.size()) - 1;
+		if(index != last)
+		{
+			m_Pairs[index] = m_Pairs[last];
+			m_Slots[FindSlot(m_Pairs[index])] = index;
+		}
+		m_Pairs.pop_back();
+	}
+
+	void PairSet::Clear()
+	{
+		m_Pairs.clear();
+		m_Slots.assign(m_Slots.size(), uint32(EMPTY_SLOT));
+	}
+
+	uint32 PairSet::GetCount() const
+	{
+		return uint32(m_Pairs.size());
+	}
+
+	const ColliderPair & PairSet::GetPair(uint32 index) const
+	{
+		return m_Pairs[index];
+	}
+
+	const std::vector<ColliderPair> & PairSet::GetPairs() const
+	{
+		return m_Pairs;
+	}
+
+	uint32 PairSet::Hash(const ColliderPair & pair)
+	{
+		uint64 hash = (uint64(pair.First) << 32) | pair.Second;
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		return uint32(hash);
+	}
+
+	uint32 PairSet::FindSlot(const ColliderPair & pair) const
+	{
+		//Either the slot of the pair or the empty slot it would go in.
+		uint32 slot = Hash(pair) & m_Mask;
+		while(m_Slots[slot] != EMPTY_SLOT && !(m_Pairs[m_Slots[slot]] == pair))
+		{
+			slot = (slot + 1) & m_Mask;
+		}
+		return slot;
+	}
+
+	void PairSet::Rehash(uint32 capacity)
+	{
+		m_Slots.assign(capacity, uint32(EMPTY_SLOT));
+		m_Mask = capacity - 1;
+		for(uint32 i = 0 ; i < m_Pairs.size() ; ++i)
+		{
+			m_Slots[FindSlot(m_Pairs[i])] = i;
+		}
+	}
+}
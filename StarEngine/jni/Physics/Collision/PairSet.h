@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../defines.h"
+#include "Broadphase.h"
+#include <vector>
+
+namespace star
+{
+	//The overlapping pairs a broadphase keeps between updates. Like the
+	//ContactSet, the pairs are kept in a dense array and an open
+	//addressing table with linear probing finds a pair in that array.
+	//Removing a pair moves the last one in its place.
+	class PairSet final
+	{
+	public:
+		PairSet();
+		~PairSet();
+
+		//Returns false when the pair was in the set already.
+		bool Add(const ColliderPair & pair);
+		//Returns false when the pair wasn't in the set.
+		bool Remove(const ColliderPair & pair);
+		void RemoveAt(uint32 index);
+		void Clear();
+
+		uint32 GetCount() const;
+		const ColliderPair & GetPair(uint32 index) const;
+		//In no particular order.
+		const std::vector<ColliderPair> & GetPairs() const;
+
+	private:
+		static const uint32 EMPTY_SLOT = 0xFFFFFFFF;
+		static const uint32 MIN_CAPACITY = 64;
+
+		static uint32 Hash(const ColliderPair & pair);
+		uint32 FindSlot(const ColliderPair & pair) const;
+		void Rehash(uint32 capacity);
+
+		std::vector<ColliderPair> m_Pairs;
+		//Index of a pair in m_Pairs, or EMPTY_SLOT.
+		std::vector<uint32> m_Slots;
+		uint32 m_Mask;
+
+		PairSet(const PairSet &);
+		PairSet(PairSet &&);
+		PairSet & operator=(const PairSet &);
+		PairSet & operator=(PairSet &&);
+	};
+}
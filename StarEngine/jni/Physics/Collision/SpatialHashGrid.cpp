@@ -0,0 +1,280 @@
+#include "SpatialHashGrid.h"
+#include "../../Components/Physics/BaseColliderComponent.h"
+#include "../../Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace star
+{
+	const float32 SpatialHashGrid::DEFAULT_CELL_SIZE = 128.0f;
+
+	SpatialHashGrid::Proxy::Proxy()
+		: pCollider(nullptr)
+		, Bounds()
+		, MinX(0)
+		, MinY(0)
+		, MaxX(0)
+		, MaxY(0)
+		, bInserted(false)
+		, bOversized(false)
+	{
+	}
+
+	SpatialHashGrid::SpatialHashGrid(float32 cellSize)
+		: Broadphase()
+		, m_CellSize(DEFAULT_CELL_SIZE)
+		, m_InverseCellSize(1.0f / DEFAULT_CELL_SIZE)
+		, m_Proxies()
+		, m_Cells()
+		, m_Oversized()
+	{
+		SetCellSize(cellSize);
+	}
+
+	SpatialHashGrid::~SpatialHashGrid()
+	{
+	}
+
+	void SpatialHashGrid::AddCollider(BaseColliderComponent * collider)
+	{
+		Proxy proxy;
+		proxy.pCollider = collider;
+		m_Proxies.push_back(proxy);
+	}
+
+	void SpatialHashGrid::RemoveCollider(uint32 index)
+	{
+		//Swap-and-pop, only the entries of the last proxy change.
+		RemoveProxy(index);
+		uint32 last = uint32(m_Proxies.size()) - 1;
+		if(index != last)
+		{
+			RenumberProxy(last, index);
+			m_Proxies[index] = m_Proxies[last];
+		}
+		m_Proxies.pop_back();
+	}
+
+	void SpatialHashGrid::FindPairs(std::vector<ColliderPair> & pairs)
+	{
+		pairs.clear();
+
+		uint32 count = uint32(m_Proxies.size());
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			UpdateProxy(i);
+		}
+
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			const Proxy & proxy = m_Proxies[i];
+			if(proxy.bOversized)
+			{
+				continue;
+			}
+			for(int32 x = proxy.MinX ; x <= proxy.MaxX ; ++x)
+			{
+				for(int32 y = proxy.MinY ; y <= proxy.MaxY ; ++y)
+				{
+					auto it = m_Cells.find(GetCellKey(x, y));
+					if(it == m_Cells.end())
+					{
+						continue;
+					}
+					for(uint32 j : it->second)
+					{
+						if(j <= i)
+						{
+							continue;
+						}
+						//Colliders can share more than one cell, the pair is
+						//only reported by the first cell of their overlap.
+						const Proxy & other = m_Proxies[j];
+						if(x != std::max(proxy.MinX, other.MinX)
+							|| y != std::max(proxy.MinY, other.MinY))
+						{
+							continue;
+						}
+						if(proxy.Bounds.Overlaps(other.Bounds))
+						{
+							pairs.push_back(ColliderPair(i, j));
+						}
+					}
+				}
+			}
+		}
+
+		//Oversized proxies aren't in any cell, they are tested against
+		//all others. A pair of two of them is reported by the lower one.
+		for(uint32 i : m_Oversized)
+		{
+			const Proxy & proxy = m_Proxies[i];
+			for(uint32 j = 0 ; j < count ; ++j)
+			{
+				if(j == i || (j < i && m_Proxies[j].bOversized))
+				{
+					continue;
+				}
+				if(proxy.Bounds.Overlaps(m_Proxies[j].Bounds))
+				{
+					pairs.push_back(ColliderPair(std::min(i, j), std::max(i, j)));
+				}
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end());
+	}
+
+	const AABB & SpatialHashGrid::GetBounds(uint32 index) const
+	{
+		return m_Proxies[index].Bounds;
+	}
+
+	void SpatialHashGrid::SetCellSize(float32 cellSize)
+	{
+		if(cellSize <= 0.0f)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("SpatialHashGrid::SetCellSize: The cell size has to be positive."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		for(uint32 i = 0 ; i < m_Proxies.size() ; ++i)
+		{
+			RemoveProxy(i);
+		}
+		m_CellSize = cellSize;
+		m_InverseCellSize = 1.0f / cellSize;
+	}
+
+	float32 SpatialHashGrid::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	void SpatialHashGrid::UpdateProxy(uint32 index)
+	{
+		Proxy & proxy = m_Proxies[index];
+		AABB bounds;
+		proxy.pCollider->GetBounds(bounds);
+		if(proxy.bInserted && bounds.Equals(proxy.Bounds))
+		{
+			return;
+		}
+		proxy.Bounds = bounds;
+
+		int32 minX = GetCellCoordinate(bounds.Min.x),
+			minY = GetCellCoordinate(bounds.Min.y),
+			maxX = GetCellCoordinate(bounds.Max.x),
+			maxY = GetCellCoordinate(bounds.Max.y);
+		if(proxy.bInserted
+			&& minX == proxy.MinX && minY == proxy.MinY
+			&& maxX == proxy.MaxX && maxY == proxy.MaxY)
+		{
+			return;
+		}
+
+		RemoveProxy(index);
+		proxy.MinX = minX;
+		proxy.MinY = minY;
+		proxy.MaxX = maxX;
+		proxy.MaxY = maxY;
+		InsertProxy(index);
+	}
+
+	void SpatialHashGrid::InsertProxy(uint32 index)
+	{
+		Proxy & proxy = m_Proxies[index];
+		proxy.bInserted = true;
+		uint64 cellCount = uint64(int64(proxy.MaxX) - proxy.MinX + 1)
+			* uint64(int64(proxy.MaxY) - proxy.MinY + 1);
+		proxy.bOversized = cellCount > MAX_PROXY_CELLS;
+		if(proxy.bOversized)
+		{
+			m_Oversized.push_back(index);
+			return;
+		}
+
+		for(int32 x = proxy.MinX ; x <= proxy.MaxX ; ++x)
+		{
+			for(int32 y = proxy.MinY ; y <= proxy.MaxY ; ++y)
+			{
+				m_Cells[GetCellKey(x, y)].push_back(index);
+			}
+		}
+	}
+
+	void SpatialHashGrid::RemoveProxy(uint32 index)
+	{
+		Proxy & proxy = m_Proxies[index];
+		if(!proxy.bInserted)
+		{
+			return;
+		}
+		proxy.bInserted = false;
+		if(proxy.bOversized)
+		{
+			auto entry = std::find(m_Oversized.begin(), m_Oversized.end(), index);
+			*entry = m_Oversized.back();
+			m_Oversized.pop_back();
+			return;
+		}
+
+		for(int32 x = proxy.MinX ; x <= proxy.MaxX ; ++x)
+		{
+			for(int32 y = proxy.MinY ; y <= proxy.MaxY ; ++y)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				if(it == m_Cells.end())
+				{
+					continue;
+				}
+				Cell & cell = it->second;
+				auto entry = std::find(cell.begin(), cell.end(), index);
+				if(entry != cell.end())
+				{
+					*entry = cell.back();
+					cell.pop_back();
+				}
+				if(cell.empty())
+				{
+					m_Cells.erase(it);
+				}
+			}
+		}
+	}
+
+	void SpatialHashGrid::RenumberProxy(uint32 from, uint32 to)
+	{
+		const Proxy & proxy = m_Proxies[from];
+		if(!proxy.bInserted)
+		{
+			return;
+		}
+		if(proxy.bOversized)
+		{
+			*std::find(m_Oversized.begin(), m_Oversized.end(), from) = to;
+			return;
+		}
+
+		for(int32 x = proxy.MinX ; x <= proxy.MaxX ; ++x)
+		{
+			for(int32 y = proxy.MinY ; y <= proxy.MaxY ; ++y)
+			{
+				Cell & cell = m_Cells[GetCellKey(x, y)];
+				*std::find(cell.begin(), cell.end(), from) = to;
+			}
+		}
+	}
+
+	int32 SpatialHashGrid::GetCellCoordinate(float32 position) const
+	{
+		return int32(std::floor(position * m_InverseCellSize));
+	}
+
+	uint64 SpatialHashGrid::GetCellKey(int32 x, int32 y)
+	{
+		return (uint64(uint32(x)) << 32) | uint64(uint32(y));
+	}
+}
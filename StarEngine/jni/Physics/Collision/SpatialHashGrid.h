@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "AABB.h"
+#include <unordered_map>
+
+namespace star
+{
+	//Uniform grid of square cells, stored sparsely by cell coordinate.
+	//A collider is in every cell its bounds touch and is only moved
+	//between cells when its bounds move. Works best when the cell size
+	//is a bit larger than the typical collider of the layer. Colliders
+	//touching more than MAX_PROXY_CELLS cells are kept out of the grid
+	//and tested against every other collider instead.
+	class SpatialHashGrid final : public Broadphase
+	{
+	public:
+		static const float32 DEFAULT_CELL_SIZE;
+		static const uint32 MAX_PROXY_CELLS = 64;
+
+		explicit SpatialHashGrid(float32 cellSize = DEFAULT_CELL_SIZE);
+		~SpatialHashGrid();
+
+		void AddCollider(BaseColliderComponent * collider);
+		void RemoveCollider(uint32 index);
+		void FindPairs(std::vector<ColliderPair> & pairs);
+		const AABB & GetBounds(uint32 index) const;
+
+		//Moves all colliders to the new cells on the next FindPairs.
+		void SetCellSize(float32 cellSize);
+		float32 GetCellSize() const;
+
+	private:
+		struct Proxy
+		{
+			Proxy();
+
+			BaseColliderComponent * pCollider;
+			AABB Bounds;
+			int32 MinX, MinY,
+				MaxX, MaxY;
+			bool bInserted,
+				bOversized;
+		};
+
+		typedef std::vector<uint32> Cell;
+
+		void UpdateProxy(uint32 index);
+		void InsertProxy(uint32 index);
+		void RemoveProxy(uint32 index);
+		//Points the grid entries of proxy from at index to instead.
+		void RenumberProxy(uint32 from, uint32 to);
+		int32 GetCellCoordinate(float32 position) const;
+		static uint64 GetCellKey(int32 x, int32 y);
+
+		float32 m_CellSize,
+			m_InverseCellSize;
+		std::vector<Proxy> m_Proxies;
+		std::unordered_map<uint64, Cell> m_Cells;
+		std::vector<uint32> m_Oversized;
+
+		SpatialHashGrid(const SpatialHashGrid &);
+		SpatialHashGrid(SpatialHashGrid &&);
+		SpatialHashGrid & operator=(const SpatialHashGrid &);
+		SpatialHashGrid & operator=(SpatialHashGrid &&);
+	};
+}
@@ -0,0 +1,247 @@
+#include "SweepAndPrune.h"
+#include "../../Components/Physics/BaseColliderComponent.h"
+#include <algorithm>
+
+namespace star
+{
+	SweepAndPrune::Proxy::Proxy()
+		: pCollider(nullptr)
+		, Bounds()
+		, PairIndex(INVALID_INDEX)
+	{
+		for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+		{
+			Min[axis] = 0;
+			Max[axis] = 0;
+		}
+	}
+
+	SweepAndPrune::SweepAndPrune()
+		: Broadphase()
+		, m_Proxies()
+		, m_Pairs()
+		, m_PairedCount(0)
+		, m_bRemoved(false)
+		, m_Renumbering()
+	{
+	}
+
+	SweepAndPrune::~SweepAndPrune()
+	{
+	}
+
+	void SweepAndPrune::AddCollider(BaseColliderComponent * collider)
+	{
+		//The endpoints start at the end of the arrays, the next sort moves
+		//them in place and finds the pairs of the collider on the way.
+		uint32 index = uint32(m_Proxies.size());
+		Proxy proxy;
+		proxy.pCollider = collider;
+		collider->GetBounds(proxy.Bounds);
+		for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+		{
+			auto & endpoints = m_Endpoints[axis];
+			Endpoint min, max;
+			min.Value = GetAxisValue(proxy.Bounds.Min, axis);
+			min.Data = index << 1;
+			max.Value = GetAxisValue(proxy.Bounds.Max, axis);
+			max.Data = (index << 1) | 1;
+
+			proxy.Min[axis] = uint32(endpoints.size());
+			endpoints.push_back(min);
+			proxy.Max[axis] = uint32(endpoints.size());
+			endpoints.push_back(max);
+		}
+		m_Proxies.push_back(proxy);
+	}
+
+	void SweepAndPrune::RemoveCollider(uint32 index)
+	{
+		//Swap-and-pop: the last proxy takes over the index. The endpoints
+		//of the removed proxy stay in place until the next sort, the
+		//pairs are renumbered by the next FindPairs.
+		uint32 last = uint32(m_Proxies.size()) - 1;
+		const Proxy & proxy = m_Proxies[index];
+		for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+		{
+			m_Endpoints[axis][proxy.Min[axis]].Data = DEAD_ENDPOINT;
+			m_Endpoints[axis][proxy.Max[axis]].Data = DEAD_ENDPOINT;
+		}
+
+		if(index != last)
+		{
+			const Proxy & lastProxy = m_Proxies[last];
+			for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+			{
+				m_Endpoints[axis][lastProxy.Min[axis]].Data = index << 1;
+				m_Endpoints[axis][lastProxy.Max[axis]].Data = (index << 1) | 1;
+			}
+			m_Proxies[index] = lastProxy;
+		}
+		m_Proxies.pop_back();
+		m_bRemoved = true;
+	}
+
+	void SweepAndPrune::FindPairs(std::vector<ColliderPair> & pairs)
+	{
+		if(m_bRemoved)
+		{
+			RenumberPairs();
+		}
+
+		//All bounds are refreshed first, so the overlap tests
+		//during the sort see where the colliders end up.
+		for(uint32 index = 0 ; index < m_Proxies.size() ; ++index)
+		{
+			Proxy & proxy = m_Proxies[index];
+			proxy.PairIndex = index;
+			proxy.pCollider->GetBounds(proxy.Bounds);
+			for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+			{
+				m_Endpoints[axis][proxy.Min[axis]].Value =
+					GetAxisValue(proxy.Bounds.Min, axis);
+				m_Endpoints[axis][proxy.Max[axis]].Value =
+					GetAxisValue(proxy.Bounds.Max, axis);
+			}
+		}
+
+		for(uint32 axis = 0 ; axis < AXIS_COUNT ; ++axis)
+		{
+			SortAxis(axis);
+		}
+		m_PairedCount = uint32(m_Proxies.size());
+
+		pairs.assign(m_Pairs.GetPairs().begin(), m_Pairs.GetPairs().end());
+		std::sort(pairs.begin(), pairs.end());
+	}
+
+	const AABB & SweepAndPrune::GetBounds(uint32 index) const
+	{
+		return m_Proxies[index].Bounds;
+	}
+
+	bool SweepAndPrune::IsBefore(const Endpoint & first, const Endpoint & second)
+	{
+		return first.Value < second.Value
+			|| (first.Value == second.Value
+				&& (first.Data & 1) == 0 && (second.Data & 1) != 0);
+	}
+
+	void SweepAndPrune::SortAxis(uint32 axis)
+	{
+		//Dead endpoints are left behind, the live ones are sorted
+		//into the front of the array.
+		auto & endpoints = m_Endpoints[axis];
+		uint32 count = uint32(endpoints.size());
+		uint32 live(0);
+		for(uint32 i = 0 ; i < count ; ++i)
+		{
+			Endpoint key = endpoints[i];
+			if(key.Data == DEAD_ENDPOINT)
+			{
+				continue;
+			}
+			uint32 keyProxy = key.Data >> 1;
+			bool keyIsMax = (key.Data & 1) != 0;
+
+			uint32 j = live;
+			while(j > 0 && IsBefore(key, endpoints[j - 1]))
+			{
+				const Endpoint & other = endpoints[j - 1];
+				uint32 otherProxy = other.Data >> 1;
+				bool otherIsMax = (other.Data & 1) != 0;
+
+				//A min passing a max to the left might start an overlap,
+				//a max passing a min to the left might end one.
+				if(keyProxy != otherProxy && keyIsMax != otherIsMax)
+				{
+					ColliderPair pair(
+						std::min(keyProxy, otherProxy),
+						std::max(keyProxy, otherProxy));
+					bool overlaps = m_Proxies[keyProxy].Bounds.Overlaps(
+						m_Proxies[otherProxy].Bounds);
+					if(!keyIsMax && overlaps)
+					{
+						m_Pairs.Add(pair);
+					}
+					else if(keyIsMax && !overlaps)
+					{
+						m_Pairs.Remove(pair);
+					}
+				}
+
+				endpoints[j] = other;
+				SetEndpointPosition(axis, j);
+				--j;
+			}
+
+			if(j != i)
+			{
+				endpoints[j] = key;
+				SetEndpointPosition(axis, j);
+			}
+			++live;
+		}
+		endpoints.resize(live);
+	}
+
+	void SweepAndPrune::RenumberPairs()
+	{
+		m_Renumbering.assign(m_PairedCount, uint32(INVALID_INDEX));
+		for(uint32 index = 0 ; index < m_Proxies.size() ; ++index)
+		{
+			uint32 pairIndex = m_Proxies[index].PairIndex;
+			if(pairIndex != INVALID_INDEX)
+			{
+				m_Renumbering[pairIndex] = index;
+			}
+		}
+
+		//Renumbered pairs are added back after the walk, so they can't
+		//clash with pairs that still use the old indices.
+		std::vector<ColliderPair> renumbered;
+		uint32 pairIndex(0);
+		while(pairIndex < m_Pairs.GetCount())
+		{
+			const ColliderPair & pair = m_Pairs.GetPair(pairIndex);
+			uint32 first = m_Renumbering[pair.First];
+			uint32 second = m_Renumbering[pair.Second];
+			if(first == pair.First && second == pair.Second)
+			{
+				++pairIndex;
+				continue;
+			}
+			if(first != INVALID_INDEX && second != INVALID_INDEX)
+			{
+				renumbered.push_back(ColliderPair(
+					std::min(first, second),
+					std::max(first, second)));
+			}
+			m_Pairs.RemoveAt(pairIndex);
+		}
+		for(auto & pair : renumbered)
+		{
+			m_Pairs.Add(pair);
+		}
+		m_bRemoved = false;
+	}
+
+	void SweepAndPrune::SetEndpointPosition(uint32 axis, uint32 position)
+	{
+		const Endpoint & endpoint = m_Endpoints[axis][position];
+		Proxy & proxy = m_Proxies[endpoint.Data >> 1];
+		if((endpoint.Data & 1) != 0)
+		{
+			proxy.Max[axis] = position;
+		}
+		else
+		{
+			proxy.Min[axis] = position;
+		}
+	}
+
+	float32 SweepAndPrune::GetAxisValue(const vec2 & value, uint32 axis)
+	{
+		return axis == 0 ? value.x : value.y;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "AABB.h"
+#include "PairSet.h"
+
+namespace star
+{
+	//Keeps the bounds of all colliders as sorted endpoints on both axes.
+	//Colliders barely move between frames, so the insertion sort that
+	//restores the order only does a few swaps, and every swap of a min
+	//and a max endpoint is exactly where a pair starts or stops
+	//overlapping. The overlapping pairs are kept between updates.
+	//Removing a collider only marks its endpoints dead, the next sort
+	//drops them, and the pairs are renumbered once for all removals.
+	//Suits layers spread out along one axis, like scrolling levels.
+	class SweepAndPrune final : public Broadphase
+	{
+	public:
+		SweepAndPrune();
+		~SweepAndPrune();
+
+		void AddCollider(BaseColliderComponent * collider);
+		void RemoveCollider(uint32 index);
+		void FindPairs(std::vector<ColliderPair> & pairs);
+		const AABB & GetBounds(uint32 index) const;
+
+	private:
+		static const uint32 AXIS_COUNT = 2;
+		static const uint32 DEAD_ENDPOINT = 0xFFFFFFFF;
+		static const uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+		struct Endpoint
+		{
+			float32 Value;
+			//Index of the collider shifted left, lowest bit set for a max,
+			//or DEAD_ENDPOINT once the collider was removed.
+			uint32 Data;
+		};
+
+		struct Proxy
+		{
+			Proxy();
+
+			BaseColliderComponent * pCollider;
+			AABB Bounds;
+			//Where the endpoints of the proxy are in the sorted arrays.
+			uint32 Min[AXIS_COUNT],
+				Max[AXIS_COUNT];
+			//The index the pairs know the proxy by, INVALID_INDEX for
+			//proxies added since the last FindPairs.
+			uint32 PairIndex;
+		};
+
+		//On equal values a min goes before a max, so touching bounds
+		//count as overlapping, the same as in AABB::Overlaps.
+		static bool IsBefore(const Endpoint & first, const Endpoint & second);
+		void SortAxis(uint32 axis);
+		void RenumberPairs();
+		void SetEndpointPosition(uint32 axis, uint32 position);
+		static float32 GetAxisValue(const vec2 & value, uint32 axis);
+
+		std::vector<Proxy> m_Proxies;
+		std::vector<Endpoint> m_Endpoints[AXIS_COUNT];
+		PairSet m_Pairs;
+		//The proxy count as of the last FindPairs.
+		uint32 m_PairedCount;
+		bool m_bRemoved;
+		//Maps the index the pairs use to the current one.
+		std::vector<uint32> m_Renumbering;
+
+		SweepAndPrune(const SweepAndPrune &);
+		SweepAndPrune(SweepAndPrune &&);
+		SweepAndPrune & operator=(const SweepAndPrune &);
+		SweepAndPrune & operator=(SweepAndPrune &&);
+	};
+}
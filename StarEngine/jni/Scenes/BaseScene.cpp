@@ -12,6 +12,10 @@
 #include "../Graphics/UI/UIBaseCursor.h"
 #include "SceneManager.h"
 #include "../Input/Gestures/BaseGesture.h"
+#include "../Components/TransformStore.h"
+#include "../Components/UpdateScheduler.h"
+#include "SceneSnapshot.h"
+#include <cstdlib>
 
 namespace star 
 {
@@ -21,6 +25,10 @@ namespace star
 		: Entity(name)
 		, m_GestureManagerPtr(nullptr)
 		, m_CollisionManagerPtr(nullptr)
+		, m_UpdateSchedulerPtr(nullptr)
+#ifdef STAR2D
+		, m_TransformStorePtr(nullptr)
+#endif
 		, m_Objects()
 		, m_Garbage()
 		, m_pDefaultCamera(nullptr)
@@ -28,25 +36,39 @@ namespace star
 		, m_pCursor(nullptr)
 		, m_CullingOffsetX(0)
 		, m_CullingOffsetY(0)
+		, m_UpdateLODDistance(512.0f)
+		, m_UpdateLODInterval(4)
+		, m_bUpdateLODEnabled(false)
+		, m_bSnapshotOnSaveState(false)
+		, m_bDenseComponentStorage(false)
+		, m_RestoreState()
 		, m_Initialized(false)
 		, m_CursorIsHidden(false)
 		, m_SystemCursorIsHidden(false)
 		, m_GestureID(0)
+		, m_NameIndex()
+		, m_GroupIndex()
+		, m_TickObjects()
+		, m_bTickListDirty(true)
 	{
 		m_pStopwatch = std::make_shared<Stopwatch>();
 		m_GestureManagerPtr = std::make_shared<GestureManager>();
 		m_CollisionManagerPtr = std::make_shared<CollisionManager>();
+		m_UpdateSchedulerPtr = std::make_shared<UpdateScheduler>();
+#ifdef STAR2D
+		m_TransformStorePtr = std::make_shared<TransformStore>();
+#endif
 	}
 	
 	BaseScene::~BaseScene()
 	{
-		for(auto & object : m_Objects)
-		{
-			SafeDelete(object);
-		}
-		m_Objects.clear();
+		DeleteObjects();
 		m_GestureManagerPtr = nullptr;
 		m_CollisionManagerPtr = nullptr;
+		m_UpdateSchedulerPtr = nullptr;
+#ifdef STAR2D
+		m_TransformStorePtr = nullptr;
+#endif
 		SafeDelete(m_pCursor);
 	}
 
@@ -59,7 +81,23 @@ namespace star
 	{
 		if(!m_Initialized)
 		{
-			CreateObjects();
+			bool restored(false);
+			if(!m_RestoreState.empty())
+			{
+				restored = LoadSnapshot(&m_RestoreState[0],
+					uint32(m_RestoreState.size()));
+				std::vector<schar>().swap(m_RestoreState);
+				if(!restored)
+				{
+					//Start over rather than continuing a partial restore.
+					DeleteObjects();
+					m_pDefaultCamera = nullptr;
+				}
+			}
+			if(!restored)
+			{
+				CreateObjects();
+			}
 
 			if(m_pDefaultCamera == nullptr)
 			{
@@ -87,6 +125,10 @@ namespace star
 		InputManager::GetInstance()->SetGestureManager(m_GestureManagerPtr);
 		SetOSCursorHidden(m_CursorIsHidden || m_SystemCursorIsHidden);
 		SetActiveCursorLocked(false);
+#ifdef STAR2D
+		//Drops what was interpolated when the scene was last active.
+		m_TransformStorePtr->StorePreviousState();
+#endif
 		return OnActivate();
 	}
 
@@ -103,6 +145,10 @@ namespace star
 	void BaseScene::BaseUpdate(const Context& context)
 	{	
 		CollectGarbage();
+		if(m_bTickListDirty)
+		{
+			RebuildTickList();
+		}
 
 		m_pStopwatch->Update(context);
 		
@@ -119,21 +165,49 @@ namespace star
 			}
 		}
 #endif
-		
+
+		UpdateSceneSystems(context);
 		Update(context);
 
-		for(auto object : m_Objects)
+		if(m_bUpdateLODEnabled)
+		{
+			UpdateObjectsWithLOD(context);
+		}
+		else
 		{
-			object->BaseUpdate(context);
+			for(auto object : m_TickObjects)
+			{
+				object->BaseUpdate(context);
+			}
 		}
 
+		m_UpdateSchedulerPtr->Update(UpdatePhase::Animation, context);
+		m_UpdateSchedulerPtr->Update(UpdatePhase::AI, context);
+		m_UpdateSchedulerPtr->Update(UpdatePhase::Movement, context);
+		m_UpdateSchedulerPtr->Update(UpdatePhase::Transform, context);
+
+#ifdef STAR2D
+		//Resolve all transforms changed this frame in one ordered pass,
+		//the view has to follow the resolved position of the camera.
+		m_TransformStorePtr->Update();
+		if(m_pActiveCamera)
+		{
+			m_pActiveCamera->GetComponent<CameraComponent>()->CalculateViewMatrix();
+		}
+#endif
+
 		//[COMMENT] Updating the collisionManager before the objects or here?
 		//			If i do it before the objects, there is the problem that
 		//			the objects won't be translated correctly...
 		//			So i think here is best, unless somebody proves me wrong
+		m_UpdateSchedulerPtr->Update(UpdatePhase::Physics, context);
 		m_CollisionManagerPtr->Update(context);
 	}
 
+	void BaseScene::UpdateSceneSystems(const Context & context)
+	{
+	}
+
 	void BaseScene::BaseDraw()
 	{
 		if(!CULLING_IS_ENABLED)
@@ -145,15 +219,8 @@ namespace star
 		}
 		else
 		{
-			pos camPos = m_pDefaultCamera->GetTransform()->GetWorldPosition();
-
-			int32 screenWidth = GraphicsManager::GetInstance()->GetScreenWidth();
-			int32 screenHeight = GraphicsManager::GetInstance()->GetScreenHeight();
-
-			float32 left = camPos.pos2D().x - m_CullingOffsetX;
-			float32 right = camPos.pos2D().x + screenWidth + m_CullingOffsetX;
-			float32 top = camPos.pos2D().y + screenHeight + m_CullingOffsetY;
-			float32 bottom = camPos.pos2D().y - m_CullingOffsetY;
+			float32 left, right, top, bottom;
+			GetCullingRect(left, right, top, bottom);
 
 			for(auto object : m_Objects)
 			{
@@ -180,7 +247,24 @@ namespace star
 
 	void BaseScene::OnSaveState(void** pData, size_t* pSize)
 	{
+		if(!m_bSnapshotOnSaveState)
+		{
+			return;
+		}
 
+		SnapshotWriter writer;
+		SceneSnapshot::Write(this, writer);
+		//The native app glue releases the saved state with free.
+		*pData = malloc(writer.GetSize());
+		if(*pData != nullptr)
+		{
+			memcpy(*pData, writer.GetData(), writer.GetSize());
+			*pSize = writer.GetSize();
+		}
+		else
+		{
+			*pSize = 0;
+		}
 	}
 
 	void BaseScene::OnConfigurationChanged()
@@ -206,15 +290,20 @@ namespace star
 				_T("BaseScene::AddObjec: Trying to add a nullptr object."));
 			return;
 		}
-		auto it = std::find(m_Objects.begin(), m_Objects.end(), object);
-		if(it == m_Objects.end())
+		if(!IsSceneObject(object))
 		{
+			object->m_SlotIndex = uint32(m_Objects.size());
+			m_Objects.push_back(object);
+			m_NameIndex.Add(object->GetNameHash(), object);
+			m_GroupIndex.Add(object->m_GroupTag.GetHash(), object);
+			//The scene is set first, so the components can
+			//register with the scheduler and the store.
+			object->SetScene(this);
+			m_bTickListDirty = true;
 			if(m_Initialized)
 			{
 				object->BaseInitialize();
 			}
-			m_Objects.push_back(object);
-			object->SetScene(this);
 		}
 		else
 		{
@@ -238,10 +327,13 @@ namespace star
 
 	void BaseScene::RemoveObject(Object * object)
 	{
-		auto it = std::find(m_Objects.begin(), m_Objects.end(), object);
-		if(it != m_Objects.end())
+		if(IsSceneObject(object))
 		{
-			m_Garbage.push_back(object);
+			if(!object->m_bIsGarbage)
+			{
+				object->m_bIsGarbage = true;
+				m_Garbage.push_back(object);
+			}
 		}
 		else
 		{
@@ -253,13 +345,11 @@ namespace star
 	
 	void BaseScene::RemoveObject(const tstring & name)
 	{
-		for(auto object : m_Objects)
+		auto object = m_NameIndex.Find(GenerateHash(name));
+		if(object)
 		{
-			if(object->CompareName(name))
-			{
-				RemoveObject(object);
-				return;
-			}
+			RemoveObject(object);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("BaseScene::RemoveObject: \
@@ -267,6 +357,11 @@ namespace star
 				   + name + _T("'."), STARENGINE_LOG_TAG);
 	}
 
+	void BaseScene::ReserveObjects(uint32 count)
+	{
+		m_Objects.reserve(m_Objects.size() + count);
+	}
+
 	void BaseScene::AddGesture(BaseGesture* gesture)
 	{
 		Logger::GetInstance()->Log(LogLevel::Warning, 
@@ -296,13 +391,11 @@ using BaseScene::AddGesture(BaseGesture* gesture) is much slower, use with care!
 
 	void BaseScene::SetObjectFrozen(const tstring & name, bool freeze)
 	{
-		for(auto object : m_Objects)
+		auto object = m_NameIndex.Find(GenerateHash(name));
+		if(object)
 		{
-			if(object->CompareName(name))
-			{
-				object->Freeze(freeze);
-				return;
-			}
+			object->Freeze(freeze);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("BaseScene::SetObjectFrozen: \
@@ -312,13 +405,11 @@ using BaseScene::AddGesture(BaseGesture* gesture) is much slower, use with care!
 
 	void BaseScene::SetObjectDisabled(const tstring & name, bool disabled)
 	{
-		for(auto object : m_Objects)
+		auto object = m_NameIndex.Find(GenerateHash(name));
+		if(object)
 		{
-			if(object->CompareName(name))
-			{
-				object->SetDisabled(disabled);
-				return;
-			}
+			object->SetDisabled(disabled);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("BaseScene::SetObjectDisabled: \
@@ -328,13 +419,11 @@ using BaseScene::AddGesture(BaseGesture* gesture) is much slower, use with care!
 
 	void BaseScene::SetObjectVisible(const tstring & name, bool visible)
 	{
-		for(auto object : m_Objects)
+		auto object = m_NameIndex.Find(GenerateHash(name));
+		if(object)
 		{
-			if(object->CompareName(name))
-			{
-				object->SetVisible(visible);
-				return;
-			}
+			object->SetVisible(visible);
+			return;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("BaseScene::SetObjectVisible: \
@@ -344,47 +433,32 @@ using BaseScene::AddGesture(BaseGesture* gesture) is much slower, use with care!
 
 	void BaseScene::SetGroupFrozen(const tstring & tag, bool visible)
 	{
-		for(auto object : m_Objects)
+		m_GroupIndex.ForEach(GenerateHash(tag), [&](Object * object)
 		{
-			if(object->CompareGroupTag(tag))
-			{
-				object->Freeze(visible);
-			}
-		}
+			object->Freeze(visible);
+		});
 	}
 
 	void BaseScene::SetGroupDisabled(const tstring & tag, bool visible)
 	{
-		for(auto object : m_Objects)
+		m_GroupIndex.ForEach(GenerateHash(tag), [&](Object * object)
 		{
-			if(object->CompareGroupTag(tag))
-			{
-				object->SetDisabled(visible);
-			}
-		}
+			object->SetDisabled(visible);
+		});
 	}
 
 	void BaseScene::SetGroupVisible(const tstring & tag, bool visible)
 	{
-		for(auto object : m_Objects)
+		m_GroupIndex.ForEach(GenerateHash(tag), [&](Object * object)
 		{
-			if(object->CompareGroupTag(tag))
-			{
-				object->SetVisible(visible);
-			}
-		}
+			object->SetVisible(visible);
+		});
 	}
 
 	void BaseScene::GetGroup(const tstring & tag, std::vector<Object*> & group)
 	{
 		group.clear();
-		for(auto object : m_Objects)
-		{
-			if(object->CompareGroupTag(tag))
-			{
-				group.push_back(object);
-			}
-		}
+		m_GroupIndex.FindAll(GenerateHash(tag), group);
 	}
 
 	void BaseScene::SetActiveCamera(BaseCamera* pCamera)
@@ -537,6 +611,45 @@ the custom cursor code in your game project."), STARENGINE_LOG_TAG);
 		return m_CollisionManagerPtr;
 	}
 
+	std::shared_ptr<UpdateScheduler> BaseScene::GetUpdateScheduler() const
+	{
+		return m_UpdateSchedulerPtr;
+	}
+
+	void BaseScene::SetDenseComponentStorage(bool enabled)
+	{
+		if(enabled == m_bDenseComponentStorage)
+		{
+			return;
+		}
+		m_bDenseComponentStorage = enabled;
+		if(enabled)
+		{
+			//Components that were initialized before are picked up here,
+			//later ones get added when they are initialized.
+			for(auto object : m_Objects)
+			{
+				StoreComponents(object);
+			}
+		}
+		else
+		{
+			m_UpdateSchedulerPtr->RemoveUnscheduledComponents();
+		}
+	}
+
+	bool BaseScene::IsDenseComponentStorage() const
+	{
+		return m_bDenseComponentStorage;
+	}
+
+#ifdef STAR2D
+	std::shared_ptr<TransformStore> BaseScene::GetTransformStore() const
+	{
+		return m_TransformStorePtr;
+	}
+#endif
+
 	void BaseScene::SetCullingOffset(int32 offset)
 	{
 		m_CullingOffsetX = offset;
@@ -549,19 +662,212 @@ the custom cursor code in your game project."), STARENGINE_LOG_TAG);
 		m_CullingOffsetY = offsetY;
 	}
 
+	void BaseScene::SetUpdateLOD(bool enabled, float32 nearDistance,
+		uint32 reducedInterval)
+	{
+		m_bUpdateLODEnabled = enabled;
+		m_UpdateLODDistance = nearDistance;
+		m_UpdateLODInterval = reducedInterval > 0 ? reducedInterval : 1;
+		if(!enabled)
+		{
+			for(auto object : m_Objects)
+			{
+				object->ResetUpdateLOD();
+			}
+		}
+	}
+
+	bool BaseScene::IsUpdateLODEnabled() const
+	{
+		return m_bUpdateLODEnabled;
+	}
+
+	void BaseScene::SaveSnapshot(const tstring & file, DirectoryMode directory) const
+	{
+		SnapshotWriter writer;
+		SceneSnapshot::Write(this, writer);
+		WriteBinaryFile(file, const_cast<schar*>(writer.GetData()),
+			writer.GetSize(), directory);
+	}
+
+	bool BaseScene::LoadSnapshot(const tstring & file, DirectoryMode directory)
+	{
+		schar * buffer(nullptr);
+		uint32 size(0);
+		if(!ReadBinaryFileSafe(file, buffer, size, directory))
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("BaseScene::LoadSnapshot: Couldn't read '") + file + _T("'."),
+				STARENGINE_LOG_TAG);
+			return false;
+		}
+		bool result = LoadSnapshot(buffer, size);
+		delete [] buffer;
+		return result;
+	}
+
+	bool BaseScene::LoadSnapshot(const schar * pData, uint32 size)
+	{
+		SnapshotReader reader(pData, size);
+		return SceneSnapshot::Read(this, reader);
+	}
+
+	void BaseScene::SetSnapshotOnSaveState(bool enabled)
+	{
+		m_bSnapshotOnSaveState = enabled;
+	}
+
+	bool BaseScene::IsSnapshotOnSaveState() const
+	{
+		return m_bSnapshotOnSaveState;
+	}
+
+	bool BaseScene::RestoreState(const void * pData, size_t size)
+	{
+		if(m_Initialized || !m_bSnapshotOnSaveState || pData == nullptr)
+		{
+			return false;
+		}
+		const schar * pBytes = static_cast<const schar*>(pData);
+		SnapshotReader reader(pBytes, uint32(size));
+		uint32 sceneHash(0);
+		if(!SceneSnapshot::ReadHeader(reader, sceneHash)
+			|| sceneHash != GetNameHash())
+		{
+			return false;
+		}
+		m_RestoreState.assign(pBytes, pBytes + size);
+		return true;
+	}
+
+	void BaseScene::GetCullingRect(float32 & left, float32 & right,
+		float32 & top, float32 & bottom) const
+	{
+		pos camPos = m_pDefaultCamera->GetTransform()->GetWorldPosition();
+
+		int32 screenWidth = GraphicsManager::GetInstance()->GetScreenWidth();
+		int32 screenHeight = GraphicsManager::GetInstance()->GetScreenHeight();
+
+		left = camPos.pos2D().x - m_CullingOffsetX;
+		right = camPos.pos2D().x + screenWidth + m_CullingOffsetX;
+		top = camPos.pos2D().y + screenHeight + m_CullingOffsetY;
+		bottom = camPos.pos2D().y - m_CullingOffsetY;
+	}
+
+	void BaseScene::UpdateObjectsWithLOD(const Context & context)
+	{
+		float32 left, right, top, bottom;
+		GetCullingRect(left, right, top, bottom);
+
+		for(auto object : m_TickObjects)
+		{
+			UpdateLOD lod = UpdateLOD::Full;
+			if(object->IsUpdateLODEnabled())
+			{
+				if(!object->IsInUpdateRange(
+					left - m_UpdateLODDistance,
+					right + m_UpdateLODDistance,
+					top + m_UpdateLODDistance,
+					bottom - m_UpdateLODDistance))
+				{
+					lod = UpdateLOD::Suspended;
+				}
+				else if(!object->IsInUpdateRange(left, right, top, bottom))
+				{
+					lod = UpdateLOD::Reduced;
+				}
+			}
+			object->BaseUpdateLOD(context, lod, m_UpdateLODInterval);
+		}
+	}
+
+	void BaseScene::DeleteObjects()
+	{
+		for(auto & object : m_Objects)
+		{
+			SafeDelete(object);
+		}
+		m_Objects.clear();
+		m_NameIndex.Clear();
+		m_GroupIndex.Clear();
+		m_TickObjects.clear();
+		m_bTickListDirty = true;
+	}
+
+	void BaseScene::RebuildTickList()
+	{
+		m_TickObjects.clear();
+		for(auto object : m_Objects)
+		{
+			if(object->HasTickWork())
+			{
+				m_TickObjects.push_back(object);
+			}
+		}
+		m_bTickListDirty = false;
+	}
+
+	void BaseScene::StoreComponents(Object * object)
+	{
+		for(auto component : object->m_pComponents)
+		{
+			if(component->IsInitialized()
+				&& !UpdateScheduler::IsScheduledType(component->GetTypeID()))
+			{
+				m_UpdateSchedulerPtr->AddComponent(component);
+			}
+		}
+		for(auto child : object->m_pChildren)
+		{
+			StoreComponents(child);
+		}
+	}
+
 	void BaseScene::CollectGarbage()
 	{
 		for(auto elem : m_Garbage)
 		{
-			auto it = std::find(m_Objects.begin(), m_Objects.end(), elem);
-			Logger::GetInstance()->Log(it != m_Objects.end(),
-				_T("BaseScene::CollectGarbage: Trying to delete unknown object"),
-				STARENGINE_LOG_TAG);
-			(*it)->UnsetScene();
-			m_Objects.erase(it);
+			if(!IsSceneObject(elem))
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("BaseScene::CollectGarbage: Trying to delete unknown object"),
+					STARENGINE_LOG_TAG);
+				continue;
+			}
+
+			//Swap-and-pop, the order of the objects is not preserved.
+			uint32 index = elem->m_SlotIndex;
+			Object * pLast = m_Objects.back();
+			m_Objects[index] = pLast;
+			pLast->m_SlotIndex = index;
+			m_Objects.pop_back();
+			m_NameIndex.Remove(elem->GetNameHash(), elem);
+			m_GroupIndex.Remove(elem->m_GroupTag.GetHash(), elem);
+
+			//The scene stays set, the components unregister from
+			//it and the transforms are destroyed in its store.
+			elem->m_SlotIndex = Object::INVALID_SLOT;
 			delete elem;
+			m_bTickListDirty = true;
 		}
 		m_Garbage.clear();
 		
 	}
+
+	bool BaseScene::IsSceneObject(const Object * object) const
+	{
+		return object->GetParent() == nullptr
+			&& object->m_SlotIndex < m_Objects.size()
+			&& m_Objects[object->m_SlotIndex] == object;
+	}
+
+	void BaseScene::UpdateObjectName(Object * object, uint32 previousHash)
+	{
+		m_NameIndex.Move(previousHash, object->GetNameHash(), object);
+	}
+
+	void BaseScene::UpdateObjectGroup(Object * object, uint32 previousHash)
+	{
+		m_GroupIndex.Move(previousHash, object->m_GroupTag.GetHash(), object);
+	}
 }
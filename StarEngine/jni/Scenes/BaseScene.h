@@ -3,6 +3,7 @@
 #include "../Entity.h"
 
 #include "../Helpers/Stopwatch.h"
+#include "../Helpers/HashIndex.h"
 #include "../Objects/Object.h"
 #include "../Input/Gestures/GestureManager.h"
 
@@ -14,6 +15,8 @@ namespace star
 	struct Context;
 	class CameraComponent;
 	class CollisionManager;
+	class UpdateScheduler;
+	class TransformStore;
 	class BaseCamera;
 	class UIBaseCursor;
 	class BaseGesture;
@@ -43,6 +46,8 @@ namespace star
 		void AddObject(Object * object, const tstring & name); 
 		virtual void RemoveObject(Object * object);
 		void RemoveObject(const tstring & name);
+		//Makes room for count more objects before a batch spawn.
+		void ReserveObjects(uint32 count);
 
 		void AddGesture(BaseGesture* gesture);
 		void AddGesture(BaseGesture* gesture, const tstring & name);
@@ -83,10 +88,53 @@ namespace star
 		void SetCullingOffset(int32 offset);
 		void SetCullingOffset(int32 offsetX, int32 offsetY);
 
+		//Objects off screen but within nearDistance of the culling area
+		//update every reducedInterval frames with the time they skipped,
+		//objects further away are suspended.
+		void SetUpdateLOD(bool enabled, float32 nearDistance = 512.0f,
+			uint32 reducedInterval = 4);
+		bool IsUpdateLODEnabled() const;
+
+		//Binary snapshots of the object graph, see SceneSnapshot.
+		//Loading one from CreateObjects replaces building the level.
+		void SaveSnapshot(const tstring & file,
+			DirectoryMode directory = DEFAULT_DIRECTORY_MODE) const;
+		bool LoadSnapshot(const tstring & file,
+			DirectoryMode directory = DEFAULT_DIRECTORY_MODE);
+		bool LoadSnapshot(const schar * pData, uint32 size);
+
+		//When enabled, OnSaveState stores a snapshot of the scene and a
+		//restarted activity rebuilds the scene from it instead of calling
+		//CreateObjects. Such a scene has to look its objects up by name
+		//in AfterInitializedObjects.
+		void SetSnapshotOnSaveState(bool enabled);
+		bool IsSnapshotOnSaveState() const;
+		//Returns false when the data isn't a snapshot of this scene
+		//or the scene is initialized already.
+		bool RestoreState(const void * pData, size_t size);
+
 		std::shared_ptr<Stopwatch> GetStopwatch() const;
 
 		std::shared_ptr<GestureManager> GetGestureManager() const;
 		std::shared_ptr<CollisionManager> GetCollisionManager() const;
+		std::shared_ptr<UpdateScheduler> GetUpdateScheduler() const;
+#ifdef STAR2D
+		std::shared_ptr<TransformStore> GetTransformStore() const;
+#endif
+
+		//Also keeps the components of types without a registered update
+		//in the per-type arrays of the UpdateScheduler, which makes
+		//ForEach iterate an array for every type instead of walking the
+		//objects. The arrays hold pointers: components are polymorphic,
+		//owned by their objects and referenced by pointer throughout the
+		//engine, so they stay in their MemoryPool slabs.
+		void SetDenseComponentStorage(bool enabled);
+		bool IsDenseComponentStorage() const;
+
+		//Calls func(T*) for every initialized component of exactly type T.
+		//Components that func removes stay valid until the end of the frame.
+		template <typename T, typename Func>
+		void ForEach(Func func) const;
 
 	protected:
 		virtual void CreateObjects() = 0;
@@ -97,9 +145,15 @@ namespace star
 		virtual void Draw() = 0;
 
 		void SetOSCursorHidden(bool hidden);
+		void GetCullingRect(float32 & left, float32 & right,
+			float32 & top, float32 & bottom) const;
 
 		std::shared_ptr<GestureManager> m_GestureManagerPtr;
 		std::shared_ptr<CollisionManager> m_CollisionManagerPtr;
+		std::shared_ptr<UpdateScheduler> m_UpdateSchedulerPtr;
+#ifdef STAR2D
+		std::shared_ptr<TransformStore> m_TransformStorePtr;
+#endif
 
 		std::vector<Object*> m_Objects;
 		std::vector<Object*> m_Garbage;
@@ -109,13 +163,42 @@ namespace star
 
 	private:
 		void CollectGarbage();
+		bool IsSceneObject(const Object * object) const;
+		void UpdateObjectName(Object * object, uint32 previousHash);
+		void UpdateObjectGroup(Object * object, uint32 previousHash);
+		void UpdateObjectsWithLOD(const Context & context);
+		void DeleteObjects();
+		void RebuildTickList();
+		void StoreComponents(Object * object);
+		//Engine work of a scene type that has to run every frame,
+		//whatever its subclasses do with Update.
+		virtual void UpdateSceneSystems(const Context & context);
+
+		template <typename T, typename Func>
+		static void ForEachInObject(const Object * object, uint32 typeID, Func & func);
+
+		HashIndex<Object> m_NameIndex,
+			m_GroupIndex;
+
+		//The root objects with anything to do in BaseUpdate.
+		std::vector<Object*> m_TickObjects;
+		bool m_bTickListDirty;
 
 		int32 m_CullingOffsetX,
 			m_CullingOffsetY;
+		float32 m_UpdateLODDistance;
+		uint32 m_UpdateLODInterval;
+		bool m_bUpdateLODEnabled;
+		bool m_bSnapshotOnSaveState;
+		bool m_bDenseComponentStorage;
+		std::vector<schar> m_RestoreState;
 		bool m_Initialized;
 		static bool CULLING_IS_ENABLED;
 		bool m_CursorIsHidden, m_SystemCursorIsHidden;
 		uint32 m_GestureID;
+
+		friend class Object;
+		friend class SceneSnapshot;
 	
 		BaseScene(const BaseScene& t);
 		BaseScene(BaseScene&& t);
@@ -1,26 +1,26 @@
 #include "../defines.h"
 #include "../Objects/Object.h"
+#include "../Helpers/Helpers.h"
 #include "../Input/Gestures/GestureManager.h"
+#include "../Components/UpdateScheduler.h"
 
 namespace star
 {
 	template <typename T>
 	T * BaseScene::GetObjectByName(const tstring & name) const
 	{
-		for(auto object : m_Objects)
+		auto object = m_NameIndex.Find(GenerateHash(name));
+		if(object)
 		{
-			if(object->CompareName(name))
+			auto returnObject = dynamic_cast<T*>(object);
+			if(returnObject == nullptr)
 			{
-				auto returnObject = dynamic_cast<T*>(object);
-				if(returnObject == nullptr)
-				{
-					Logger::GetInstance()->Log(LogLevel::Error,
-						_T("BaseScene::GetObjectByName: couldn't convert object '")
-						+ name + _T("' to the requested type. Returning nullptr..."),
-						STARENGINE_LOG_TAG);
-				}
-				return returnObject;
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("BaseScene::GetObjectByName: couldn't convert object '")
+					+ name + _T("' to the requested type. Returning nullptr..."),
+					STARENGINE_LOG_TAG);
 			}
+			return returnObject;
 		}
 		Logger::GetInstance()->Log(LogLevel::Warning,
 				_T("BaseScene::GetObjectByName: Trying to get an unknown object '")
@@ -33,4 +33,39 @@ namespace star
 	{
 		return m_GestureManagerPtr->GetGesture<T>(name);
 	}
+
+	template <typename T, typename Func>
+	void BaseScene::ForEach(Func func) const
+	{
+		uint32 typeID = ComponentType::GetID<T>();
+		if(m_bDenseComponentStorage || UpdateScheduler::IsScheduledType(typeID))
+		{
+			//Indexed, components added by func are visited as well.
+			const auto & components = m_UpdateSchedulerPtr->GetComponents(typeID);
+			for(size_t i = 0 ; i < components.size() ; ++i)
+			{
+				func(static_cast<T*>(components[i]));
+			}
+			return;
+		}
+
+		for(auto object : m_Objects)
+		{
+			ForEachInObject<T>(object, typeID, func);
+		}
+	}
+
+	template <typename T, typename Func>
+	void BaseScene::ForEachInObject(const Object * object, uint32 typeID, Func & func)
+	{
+		auto component = object->GetComponentByID(typeID);
+		if(component != nullptr && component->IsInitialized())
+		{
+			func(static_cast<T*>(component));
+		}
+		for(auto child : object->m_pChildren)
+		{
+			ForEachInObject<T>(child, typeID, func);
+		}
+	}
 }
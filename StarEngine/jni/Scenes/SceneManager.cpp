@@ -11,6 +11,7 @@
 #include "../Sound/AudioManager.h"
 #include "../Input/InputManager.h"
 #include "../Helpers/Debug/DebugDraw.h"
+#include "../StarEngine.h"
 
 #define INPUT_MANAGER (InputManager::GetInstance())
 
@@ -177,6 +178,19 @@ namespace star
 		}
 		Logger::GetInstance()->Log(LogLevel::Info,
 			_T("Initializing Scene :") + m_CurrentSceneName, STARENGINE_LOG_TAG);
+#ifdef ANDROID
+		//State saved before the activity got killed goes to the scene it
+		//was saved from, once that scene is initialized again.
+		android_app * pApplication = StarEngine::GetInstance()->GetAndroidApp();
+		if(pApplication != nullptr && pApplication->savedState != nullptr
+			&& m_NewActiveScene->RestoreState(
+				pApplication->savedState, pApplication->savedStateSize))
+		{
+			free(pApplication->savedState);
+			pApplication->savedState = nullptr;
+			pApplication->savedStateSize = 0;
+		}
+#endif
 		m_NewActiveScene->BaseInitialize();
 		m_bInitialized = m_NewActiveScene->IsInitialized();
 		return m_bInitialized;
@@ -236,9 +250,9 @@ namespace star
 		}
 		if(m_ActiveScene != nullptr)
 		{
+			//Flush also records the debug primitives of the frame.
 			m_ActiveScene->BaseDraw();
 			SpriteBatch::GetInstance()->Flush();
-			DebugDraw::GetInstance()->Flush();
 		}
 	}
 
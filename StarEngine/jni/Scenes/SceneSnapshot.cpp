@@ -0,0 +1,937 @@
+#include "SceneSnapshot.h"
+#include "BaseScene.h"
+#include "../Logger.h"
+#include "../Objects/Object.h"
+#include "../Objects/BaseCamera.h"
+#include "../Objects/FreeCamera.h"
+#include "../Components/TransformComponent.h"
+#include "../Components/CameraComponent.h"
+#include "../Components/Graphics/SpriteComponent.h"
+#include "../Components/Graphics/SpriteSheetComponent.h"
+#include "../Components/Graphics/TextComponent.h"
+#include "../Components/Physics/RectangleColliderComponent.h"
+#include "../Components/Physics/CircleColliderComponent.h"
+#include "../Components/AI/PathFindNodeComponent.h"
+#include "../Actions/TimedMoveAction.h"
+#include "../Actions/TimedScaleAction.h"
+#include "../Actions/TimedFadeAction.h"
+#include "../Actions/DelayedFramesAction.h"
+
+namespace star
+{
+	std::vector<uint32> SceneSnapshot::m_ObjectHashes;
+	std::map<uint32, SceneSnapshot::ObjectFactory> SceneSnapshot::m_ObjectFactories;
+	std::vector<uint32> SceneSnapshot::m_ComponentHashes;
+	std::map<uint32, SceneSnapshot::ComponentDescriptor> SceneSnapshot::m_ComponentTypes;
+	std::vector<uint32> SceneSnapshot::m_ActionHashes;
+	std::map<uint32, SceneSnapshot::ActionFactory> SceneSnapshot::m_ActionFactories;
+	bool SceneSnapshot::m_bDefaultTypesRegistered = false;
+
+	SnapshotWriter::SnapshotWriter()
+		: m_Buffer()
+		, m_OpenBlocks()
+	{
+	}
+
+	SnapshotWriter::~SnapshotWriter()
+	{
+	}
+
+	void SnapshotWriter::WriteString(const tstring & value)
+	{
+		sstring converted = string_cast<sstring>(value);
+		Write<uint32>(uint32(converted.size()));
+		WriteBytes(converted.c_str(), uint32(converted.size()));
+	}
+
+	void SnapshotWriter::WriteBytes(const void * pData, uint32 size)
+	{
+		const schar * pBytes = static_cast<const schar*>(pData);
+		m_Buffer.insert(m_Buffer.end(), pBytes, pBytes + size);
+	}
+
+	void SnapshotWriter::BeginBlock()
+	{
+		m_OpenBlocks.push_back(GetSize());
+		Write<uint32>(0);
+	}
+
+	void SnapshotWriter::EndBlock()
+	{
+		if(m_OpenBlocks.empty())
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SnapshotWriter::EndBlock: There is no open block."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+		uint32 start = m_OpenBlocks.back();
+		m_OpenBlocks.pop_back();
+		WriteAt<uint32>(start, GetSize() - start - uint32(sizeof(uint32)));
+	}
+
+	const schar * SnapshotWriter::GetData() const
+	{
+		return m_Buffer.empty() ? nullptr : &m_Buffer[0];
+	}
+
+	uint32 SnapshotWriter::GetSize() const
+	{
+		return uint32(m_Buffer.size());
+	}
+
+	SnapshotReader::SnapshotReader(const schar * pData, uint32 size)
+		: m_pData(pData)
+		, m_Size(pData != nullptr ? size : 0)
+		, m_Position(0)
+		, m_BlockEnds()
+		, m_bIsValid(pData != nullptr)
+	{
+	}
+
+	SnapshotReader::~SnapshotReader()
+	{
+	}
+
+	tstring SnapshotReader::ReadString()
+	{
+		uint32 length = Read<uint32>();
+		if(!Require(length))
+		{
+			return EMPTY_STRING;
+		}
+		sstring value(m_pData + m_Position, length);
+		m_Position += length;
+		return string_cast<tstring>(value);
+	}
+
+	bool SnapshotReader::ReadBytes(void * pData, uint32 size)
+	{
+		if(!Require(size))
+		{
+			memset(pData, 0, size);
+			return false;
+		}
+		memcpy(pData, m_pData + m_Position, size);
+		m_Position += size;
+		return true;
+	}
+
+	void SnapshotReader::BeginBlock()
+	{
+		uint32 size = Read<uint32>();
+		if(Require(size))
+		{
+			m_BlockEnds.push_back(m_Position + size);
+		}
+		else
+		{
+			//Keeps EndBlock balanced on corrupt data.
+			m_BlockEnds.push_back(m_Size);
+		}
+	}
+
+	void SnapshotReader::EndBlock()
+	{
+		if(m_BlockEnds.empty())
+		{
+			m_bIsValid = false;
+			return;
+		}
+		if(m_bIsValid)
+		{
+			m_Position = m_BlockEnds.back();
+		}
+		m_BlockEnds.pop_back();
+	}
+
+	bool SnapshotReader::IsValid() const
+	{
+		return m_bIsValid;
+	}
+
+	uint32 SnapshotReader::GetPosition() const
+	{
+		return m_Position;
+	}
+
+	const schar * SnapshotReader::GetData() const
+	{
+		return m_pData;
+	}
+
+	bool SnapshotReader::Require(uint32 size)
+	{
+		uint32 end = m_BlockEnds.empty() ? m_Size : m_BlockEnds.back();
+		if(m_bIsValid && size <= end - m_Position)
+		{
+			return true;
+		}
+		if(m_bIsValid)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SnapshotReader: Reading past the end of the snapshot data."),
+				STARENGINE_LOG_TAG);
+		}
+		m_bIsValid = false;
+		return false;
+	}
+
+	void SceneSnapshot::Write(const BaseScene * pScene, SnapshotWriter & writer)
+	{
+		RegisterDefaultTypes();
+
+		writer.Write<uint32>(MAGIC);
+		writer.Write<uint32>(VERSION);
+		writer.Write<uint32>(pScene->GetNameHash());
+		uint32 countOffset = writer.GetSize();
+		writer.Write<uint32>(0);
+
+		uint32 count(0);
+		for(auto object : pScene->m_Objects)
+		{
+			WriteObject(pScene, object, NO_PARENT, count, writer);
+		}
+		writer.WriteAt<uint32>(countOffset, count);
+	}
+
+	bool SceneSnapshot::Read(BaseScene * pScene, SnapshotReader & reader)
+	{
+		RegisterDefaultTypes();
+
+		uint32 sceneHash(0);
+		if(!ReadHeader(reader, sceneHash))
+		{
+			return false;
+		}
+
+		//Parsed in full first, so a corrupt snapshot leaves the scene as it was.
+		ObjectTreeTemplate tree;
+		if(!ParseObjects(reader, tree))
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::Read: The snapshot of scene '") +
+				pScene->GetName() + _T("' is corrupt, it wasn't loaded."),
+				STARENGINE_LOG_TAG);
+			return false;
+		}
+
+		std::vector<Object*> objects;
+		BuildObjects(pScene, tree, objects);
+		return true;
+	}
+
+	void SceneSnapshot::WriteObjectTree(const Object * pRoot, SnapshotWriter & writer)
+	{
+		RegisterDefaultTypes();
+
+		writer.Write<uint32>(MAGIC);
+		writer.Write<uint32>(VERSION);
+		writer.Write<uint32>(0);
+		uint32 countOffset = writer.GetSize();
+		writer.Write<uint32>(0);
+
+		uint32 count(0);
+		WriteObject(nullptr, pRoot, NO_PARENT, count, writer);
+		writer.WriteAt<uint32>(countOffset, count);
+	}
+
+	Object * SceneSnapshot::ReadObjectTree(SnapshotReader & reader)
+	{
+		ObjectTreeTemplate tree;
+		if(!ReadObjectTree(reader, tree))
+		{
+			return nullptr;
+		}
+		return BuildObjectTree(tree);
+	}
+
+	bool SceneSnapshot::ReadObjectTree(
+		SnapshotReader & reader,
+		ObjectTreeTemplate & tree
+		)
+	{
+		RegisterDefaultTypes();
+
+		uint32 sceneHash(0);
+		if(!ReadHeader(reader, sceneHash))
+		{
+			return false;
+		}
+		if(!ParseObjects(reader, tree))
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::ReadObjectTree: The snapshot is corrupt."),
+				STARENGINE_LOG_TAG);
+			tree.Objects.clear();
+			tree.Data.clear();
+			return false;
+		}
+		return true;
+	}
+
+	Object * SceneSnapshot::BuildObjectTree(const ObjectTreeTemplate & tree)
+	{
+		std::vector<Object*> objects;
+		BuildObjects(nullptr, tree, objects);
+		return objects.empty() ? nullptr : objects[0];
+	}
+
+	bool SceneSnapshot::ParseObjects(
+		SnapshotReader & reader,
+		ObjectTreeTemplate & tree
+		)
+	{
+		tree.Objects.clear();
+		tree.Data.clear();
+
+		uint32 count = reader.Read<uint32>();
+		for(uint32 i = 0 ; i < count && reader.IsValid() ; ++i)
+		{
+			tree.Objects.push_back(ObjectTreeTemplate::ObjectRecord());
+			ObjectTreeTemplate::ObjectRecord & record = tree.Objects.back();
+			record.TypeHash = reader.Read<uint32>();
+			record.ParentIndex = reader.Read<uint32>();
+			record.Flags = reader.Read<uint8>();
+			record.Name = reader.ReadString();
+			record.NameHash = GenerateHash(record.Name);
+			record.GroupTag = reader.ReadString();
+			record.PhysicsTag = reader.ReadString();
+			record.Position.x = reader.Read<float32>();
+			record.Position.y = reader.Read<float32>();
+			record.Position.l = reader.Read<lay>();
+			record.Rotation = reader.Read<float32>();
+			record.Scale.x = reader.Read<float32>();
+			record.Scale.y = reader.Read<float32>();
+			record.CenterPoint.x = reader.Read<float32>();
+			record.CenterPoint.y = reader.Read<float32>();
+			record.Mirrors = reader.Read<uint8>();
+
+			//Unregistered objects are kept without a factory, a child
+			//created by the constructor of its parent can still match.
+			auto factory = m_ObjectFactories.find(record.TypeHash);
+			if(factory != m_ObjectFactories.end())
+			{
+				record.Factory = factory->second;
+			}
+			ParseData(reader, tree, record.Data);
+			ParseComponents(reader, tree, record);
+			ParseActions(reader, tree, record);
+		}
+		return reader.IsValid();
+	}
+
+	void SceneSnapshot::BuildObjects(
+		BaseScene * pScene,
+		const ObjectTreeTemplate & tree,
+		std::vector<Object*> & objects
+		)
+	{
+		objects.reserve(tree.Objects.size());
+		for(const auto & record : tree.Objects)
+		{
+			Object * pParent(nullptr);
+			bool hasParent = record.ParentIndex != NO_PARENT;
+			if(hasParent && record.ParentIndex < objects.size())
+			{
+				pParent = objects[record.ParentIndex];
+			}
+
+			//Children created by the constructor of their parent
+			//already exist and are restored in place.
+			Object * pObject(nullptr);
+			bool isNew(false);
+			if(pParent != nullptr)
+			{
+				for(auto child : pParent->m_pChildren)
+				{
+					if(child->GetNameHash() == record.NameHash
+						&& GetTypeHash(m_ObjectHashes, child->GetTypeID())
+							== record.TypeHash)
+					{
+						pObject = child;
+						break;
+					}
+				}
+			}
+			if(pObject == nullptr && (!hasParent || pParent != nullptr))
+			{
+				if(record.Factory)
+				{
+					pObject = record.Factory();
+					isNew = true;
+				}
+				else
+				{
+					Logger::GetInstance()->Log(LogLevel::Error,
+						_T("SceneSnapshot::Read: Object '") + record.Name +
+						_T("' has an unregistered type and is skipped."),
+						STARENGINE_LOG_TAG);
+				}
+			}
+
+			if(pObject == nullptr)
+			{
+				objects.push_back(nullptr);
+				continue;
+			}
+
+			if(isNew)
+			{
+				pObject->SetName(record.Name);
+			}
+			pObject->SetGroupTag(record.GroupTag);
+			pObject->SetPhysicsTag(record.PhysicsTag);
+
+			TransformComponent * pTransform = pObject->GetTransform();
+			pTransform->Translate(record.Position);
+			pTransform->Rotate(record.Rotation);
+			pTransform->Scale(record.Scale);
+			pTransform->SetCenterPoint(record.CenterPoint);
+			pTransform->Mirror((record.Mirrors & 1) != 0, (record.Mirrors & 2) != 0);
+
+			DeserializeData(pObject, tree, record.Data);
+			BuildComponents(pObject, tree, record);
+			BuildActions(pObject, tree, record);
+
+			if(isNew)
+			{
+				if(pParent != nullptr)
+				{
+					pParent->AddChild(pObject);
+				}
+				else if(pScene != nullptr)
+				{
+					pScene->AddObject(pObject);
+				}
+			}
+
+			bool visible = (record.Flags & OBJECT_VISIBLE) != 0;
+			if(pObject->IsVisible() != visible)
+			{
+				pObject->SetVisible(visible);
+			}
+			bool frozen = (record.Flags & OBJECT_FROZEN) != 0;
+			if(pObject->IsFrozen() != frozen)
+			{
+				pObject->Freeze(frozen);
+			}
+			if(pScene != nullptr && (record.Flags & OBJECT_DEFAULT_CAMERA) != 0)
+			{
+				pScene->m_pDefaultCamera = dynamic_cast<BaseCamera*>(pObject);
+			}
+			objects.push_back(pObject);
+		}
+	}
+
+	void SceneSnapshot::ParseData(
+		SnapshotReader & reader,
+		ObjectTreeTemplate & tree,
+		ObjectTreeTemplate::DataSlice & slice
+		)
+	{
+		reader.BeginBlock();
+		uint32 start = reader.GetPosition();
+		reader.EndBlock();
+		slice.Offset = uint32(tree.Data.size());
+		slice.Size = 0;
+		if(reader.IsValid())
+		{
+			slice.Size = reader.GetPosition() - start;
+			const schar * pBlock = reader.GetData() + start;
+			tree.Data.insert(tree.Data.end(), pBlock, pBlock + slice.Size);
+		}
+	}
+
+	bool SceneSnapshot::ReadHeader(SnapshotReader & reader, uint32 & sceneHash)
+	{
+		uint32 magic = reader.Read<uint32>();
+		uint32 version = reader.Read<uint32>();
+		sceneHash = reader.Read<uint32>();
+		if(!reader.IsValid() || magic != MAGIC)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::ReadHeader: The data is not a scene snapshot."),
+				STARENGINE_LOG_TAG);
+			return false;
+		}
+		if(version != VERSION)
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("SceneSnapshot::ReadHeader: Snapshot version ") +
+				string_cast<tstring>(version) + _T(" is not supported."),
+				STARENGINE_LOG_TAG);
+			return false;
+		}
+		return true;
+	}
+
+	void SceneSnapshot::RegisterObjectType(
+		uint32 typeID,
+		const tstring & name,
+		const ObjectFactory & factory
+		)
+	{
+		//A type that doesn't override GetTypeID would be
+		//written as its base type, and read back as one.
+		Object * pProbe = factory();
+		bool isValid = pProbe != nullptr && pProbe->GetTypeID() == typeID;
+		SafeDelete(pProbe);
+		if(!isValid)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::RegisterObjectType: Type '") + name +
+				_T("' doesn't override GetTypeID and can't be registered."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		uint32 previousHash = GetTypeHash(m_ObjectHashes, typeID);
+		if(previousHash != 0)
+		{
+			m_ObjectFactories.erase(previousHash);
+		}
+		uint32 hash = GenerateHash(name);
+		SetTypeHash(m_ObjectHashes, typeID, hash);
+		m_ObjectFactories[hash] = factory;
+	}
+
+	void SceneSnapshot::RegisterComponentType(
+		uint32 typeID,
+		const tstring & name,
+		const ComponentFactory & factory
+		)
+	{
+		uint32 previousHash = GetTypeHash(m_ComponentHashes, typeID);
+		if(previousHash != 0)
+		{
+			m_ComponentTypes.erase(previousHash);
+		}
+		uint32 hash = GenerateHash(name);
+		SetTypeHash(m_ComponentHashes, typeID, hash);
+
+		ComponentDescriptor descriptor;
+		descriptor.TypeID = typeID;
+		descriptor.Factory = factory;
+		m_ComponentTypes[hash] = descriptor;
+	}
+
+	void SceneSnapshot::RegisterActionType(
+		uint32 typeID,
+		const tstring & name,
+		const ActionFactory & factory
+		)
+	{
+		Action * pProbe = factory();
+		bool isValid = pProbe != nullptr && pProbe->GetTypeID() == typeID;
+		SafeDelete(pProbe);
+		if(!isValid)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::RegisterActionType: Type '") + name +
+				_T("' doesn't override GetTypeID and can't be registered."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		uint32 previousHash = GetTypeHash(m_ActionHashes, typeID);
+		if(previousHash != 0)
+		{
+			m_ActionFactories.erase(previousHash);
+		}
+		uint32 hash = GenerateHash(name);
+		SetTypeHash(m_ActionHashes, typeID, hash);
+		m_ActionFactories[hash] = factory;
+	}
+
+	void SceneSnapshot::SetTypeHash(
+		std::vector<uint32> & hashes,
+		uint32 typeID,
+		uint32 hash
+		)
+	{
+		if(typeID >= hashes.size())
+		{
+			hashes.resize(typeID + 1, 0);
+		}
+		hashes[typeID] = hash;
+	}
+
+	uint32 SceneSnapshot::GetTypeHash(
+		const std::vector<uint32> & hashes,
+		uint32 typeID
+		)
+	{
+		return typeID < hashes.size() ? hashes[typeID] : 0;
+	}
+
+	void SceneSnapshot::RegisterDefaultTypes()
+	{
+		if(m_bDefaultTypesRegistered)
+		{
+			return;
+		}
+		m_bDefaultTypesRegistered = true;
+
+		RegisterObjectType<Object>(_T("Object"));
+		RegisterObjectType<BaseCamera>(_T("BaseCamera"));
+		RegisterObjectType<FreeCamera>(_T("FreeCamera"));
+		RegisterComponentType<CameraComponent>(_T("CameraComponent"));
+		RegisterComponentType<SpriteComponent>(_T("SpriteComponent"),
+			[]() -> BaseComponent*
+			{
+				return new SpriteComponent(EMPTY_STRING, EMPTY_STRING);
+			});
+		RegisterComponentType<SpriteSheetComponent>(_T("SpriteSheetComponent"),
+			[]() -> BaseComponent*
+			{
+				return new SpriteSheetComponent(EMPTY_STRING, EMPTY_STRING, EMPTY_STRING);
+			});
+		RegisterComponentType<TextComponent>(_T("TextComponent"),
+			[]() -> BaseComponent*
+			{
+				return new TextComponent();
+			});
+		RegisterComponentType<RectangleColliderComponent>(
+			_T("RectangleColliderComponent"));
+		RegisterComponentType<CircleColliderComponent>(
+			_T("CircleColliderComponent"));
+		RegisterComponentType<PathFindNodeComponent>(_T("PathFindNodeComponent"));
+
+		RegisterActionType<TimedMoveAction>(_T("TimedMoveAction"),
+			[]() -> Action*
+			{
+				return new TimedMoveAction(0.0f, vec2());
+			});
+		RegisterActionType<TimedScaleAction>(_T("TimedScaleAction"),
+			[]() -> Action*
+			{
+				return new TimedScaleAction(0.0f, 0.0f, 0.0f);
+			});
+		RegisterActionType<TimedFadeAction>(_T("TimedFadeAction"),
+			[]() -> Action*
+			{
+				return new TimedFadeAction(0.0f, Color::White, Color::White);
+			});
+		RegisterActionType<DelayedFramesAction>(_T("DelayedFramesAction"));
+	}
+
+	void SceneSnapshot::WriteObject(
+		const BaseScene * pScene,
+		const Object * pObject,
+		uint32 parentIndex,
+		uint32 & count,
+		SnapshotWriter & writer
+		)
+	{
+		if(pObject->m_bIsGarbage)
+		{
+			return;
+		}
+		uint32 typeHash = GetTypeHash(m_ObjectHashes, pObject->GetTypeID());
+		if(typeHash == 0)
+		{
+			Logger::GetInstance()->Log(LogLevel::Error,
+				_T("SceneSnapshot::Write: Object '") + pObject->GetName() +
+				_T("' has an unregistered type and is left out, with its children."),
+				STARENGINE_LOG_TAG);
+			return;
+		}
+
+		uint8 flags(0);
+		if(pObject->IsVisible())
+		{
+			flags |= OBJECT_VISIBLE;
+		}
+		if(pObject->IsFrozen())
+		{
+			flags |= OBJECT_FROZEN;
+		}
+		if(pScene != nullptr && pObject == pScene->m_pDefaultCamera)
+		{
+			flags |= OBJECT_DEFAULT_CAMERA;
+		}
+
+		writer.Write<uint32>(typeHash);
+		writer.Write<uint32>(parentIndex);
+		writer.Write<uint8>(flags);
+		writer.WriteString(pObject->GetName());
+		writer.WriteString(pObject->GetGroupTag());
+		writer.WriteString(pObject->GetPhysicsTag());
+
+		TransformComponent * pTransform = pObject->GetTransform();
+		const pos & position = pTransform->GetLocalPosition();
+		writer.Write<float32>(position.x);
+		writer.Write<float32>(position.y);
+		writer.Write<lay>(position.l);
+		writer.Write<float32>(pTransform->GetLocalRotation());
+		const vec2 & scale = pTransform->GetLocalScale();
+		writer.Write<float32>(scale.x);
+		writer.Write<float32>(scale.y);
+		const vec2 & centerPoint = pTransform->GetCenterPoint();
+		writer.Write<float32>(centerPoint.x);
+		writer.Write<float32>(centerPoint.y);
+		uint8 mirrors(0);
+		if(pTransform->IsMirroredX())
+		{
+			mirrors |= 1;
+		}
+		if(pTransform->IsMirroredY())
+		{
+			mirrors |= 2;
+		}
+		writer.Write<uint8>(mirrors);
+
+		writer.BeginBlock();
+		pObject->Serialize(writer);
+		writer.EndBlock();
+		WriteComponents(pObject, writer);
+		WriteActions(pObject, writer);
+
+		uint32 index = count++;
+		for(auto child : pObject->m_pChildren)
+		{
+			WriteObject(pScene, child, index, count, writer);
+		}
+	}
+
+	void SceneSnapshot::WriteComponents(
+		const Object * pObject,
+		SnapshotWriter & writer
+		)
+	{
+		uint32 countOffset = writer.GetSize();
+		writer.Write<uint32>(0);
+
+		uint32 count(0);
+		for(auto component : pObject->m_pComponents)
+		{
+			//The transform is stored with the object itself.
+			if(component == pObject->m_pTransform)
+			{
+				continue;
+			}
+			uint32 typeHash = GetTypeHash(m_ComponentHashes, component->GetTypeID());
+			if(typeHash == 0)
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("SceneSnapshot::Write: A component of object '") +
+					pObject->GetName() +
+					_T("' has an unregistered type and is left out."),
+					STARENGINE_LOG_TAG);
+				continue;
+			}
+
+			uint8 flags(0);
+			if(component->IsEnabled())
+			{
+				flags |= COMPONENT_ENABLED;
+			}
+			if(component->IsVisible())
+			{
+				flags |= COMPONENT_VISIBLE;
+			}
+			writer.Write<uint32>(typeHash);
+			writer.Write<uint8>(flags);
+			writer.BeginBlock();
+			component->Serialize(writer);
+			writer.EndBlock();
+			++count;
+		}
+		writer.WriteAt<uint32>(countOffset, count);
+	}
+
+	void SceneSnapshot::ParseComponents(
+		SnapshotReader & reader,
+		ObjectTreeTemplate & tree,
+		ObjectTreeTemplate::ObjectRecord & record
+		)
+	{
+		uint32 count = reader.Read<uint32>();
+		for(uint32 i = 0 ; i < count && reader.IsValid() ; ++i)
+		{
+			ObjectTreeTemplate::ComponentRecord component;
+			uint32 typeHash = reader.Read<uint32>();
+			component.Flags = reader.Read<uint8>();
+			ParseData(reader, tree, component.Data);
+
+			auto type = m_ComponentTypes.find(typeHash);
+			if(type == m_ComponentTypes.end())
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("SceneSnapshot::Read: A component of object '") +
+					record.Name +
+					_T("' has an unregistered type and is skipped."),
+					STARENGINE_LOG_TAG);
+				continue;
+			}
+			component.TypeID = type->second.TypeID;
+			component.Factory = type->second.Factory;
+			record.Components.push_back(component);
+		}
+	}
+
+	void SceneSnapshot::BuildComponents(
+		Object * pObject,
+		const ObjectTreeTemplate & tree,
+		const ObjectTreeTemplate::ObjectRecord & record
+		)
+	{
+		for(const auto & component : record.Components)
+		{
+			//Components created by the constructor of the object
+			//are restored in place.
+			BaseComponent * pComponent = pObject->GetComponentByID(component.TypeID);
+			bool isNew = pComponent == nullptr;
+			if(isNew)
+			{
+				pComponent = component.Factory();
+			}
+			if(!DeserializeData(pComponent, tree, component.Data) && isNew)
+			{
+				SafeDelete(pComponent);
+				continue;
+			}
+			pComponent->SetEnabled((component.Flags & COMPONENT_ENABLED) != 0);
+			pComponent->SetVisible((component.Flags & COMPONENT_VISIBLE) != 0);
+			if(isNew)
+			{
+				pObject->RegisterComponent(pComponent, component.TypeID);
+			}
+		}
+	}
+
+	void SceneSnapshot::WriteActions(
+		const Object * pObject,
+		SnapshotWriter & writer
+		)
+	{
+		uint32 countOffset = writer.GetSize();
+		writer.Write<uint32>(0);
+
+		uint32 count(0);
+		for(auto action : pObject->m_pActions)
+		{
+			//Actions that are removed at the end of this frame are left out.
+			bool isGarbage(false);
+			for(const auto & info : pObject->m_pGarbageContainer)
+			{
+				if(info.Element == action)
+				{
+					isGarbage = true;
+					break;
+				}
+			}
+			if(isGarbage)
+			{
+				continue;
+			}
+
+			uint32 typeHash = GetTypeHash(m_ActionHashes, action->GetTypeID());
+			if(typeHash == 0)
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("SceneSnapshot::Write: Action '") + action->GetName() +
+					_T("' of object '") + pObject->GetName() +
+					_T("' has an unregistered type and is left out."),
+					STARENGINE_LOG_TAG);
+				continue;
+			}
+
+			uint8 flags(0);
+			if(action->m_IsPaused)
+			{
+				flags |= ACTION_PAUSED;
+			}
+			writer.Write<uint32>(typeHash);
+			writer.Write<uint8>(flags);
+			writer.WriteString(action->GetName());
+			writer.BeginBlock();
+			action->Serialize(writer);
+			writer.EndBlock();
+			++count;
+		}
+		writer.WriteAt<uint32>(countOffset, count);
+	}
+
+	void SceneSnapshot::ParseActions(
+		SnapshotReader & reader,
+		ObjectTreeTemplate & tree,
+		ObjectTreeTemplate::ObjectRecord & record
+		)
+	{
+		uint32 count = reader.Read<uint32>();
+		for(uint32 i = 0 ; i < count && reader.IsValid() ; ++i)
+		{
+			ObjectTreeTemplate::ActionRecord action;
+			action.TypeHash = reader.Read<uint32>();
+			action.Flags = reader.Read<uint8>();
+			action.Name = reader.ReadString();
+			action.NameHash = GenerateHash(action.Name);
+			ParseData(reader, tree, action.Data);
+
+			auto factory = m_ActionFactories.find(action.TypeHash);
+			if(factory == m_ActionFactories.end())
+			{
+				Logger::GetInstance()->Log(LogLevel::Error,
+					_T("SceneSnapshot::Read: Action '") + action.Name +
+					_T("' of object '") + record.Name +
+					_T("' has an unregistered type and is skipped."),
+					STARENGINE_LOG_TAG);
+				continue;
+			}
+			action.Factory = factory->second;
+			record.Actions.push_back(action);
+		}
+	}
+
+	void SceneSnapshot::BuildActions(
+		Object * pObject,
+		const ObjectTreeTemplate & tree,
+		const ObjectTreeTemplate::ObjectRecord & record
+		)
+	{
+		for(const auto & action : record.Actions)
+		{
+			bool paused = (action.Flags & ACTION_PAUSED) != 0;
+
+			//Actions created by the constructor of the object
+			//are restored in place.
+			Action * pAction(nullptr);
+			for(auto existing : pObject->m_pActions)
+			{
+				if(existing->GetNameHash() == action.NameHash
+					&& GetTypeHash(m_ActionHashes, existing->GetTypeID())
+						== action.TypeHash)
+				{
+					pAction = existing;
+					break;
+				}
+			}
+
+			if(pAction != nullptr)
+			{
+				DeserializeData(pAction, tree, action.Data);
+				if(paused && !pAction->m_IsPaused)
+				{
+					pAction->Pause();
+				}
+				else if(!paused && pAction->m_IsPaused)
+				{
+					pAction->Resume();
+				}
+				continue;
+			}
+
+			pAction = action.Factory();
+			pAction->SetName(action.Name);
+			if(!DeserializeData(pAction, tree, action.Data))
+			{
+				SafeDelete(pAction);
+				continue;
+			}
+			pAction->m_IsPaused = paused;
+			pObject->AddAction(pAction);
+		}
+	}
+}
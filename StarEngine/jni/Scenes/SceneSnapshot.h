@@ -0,0 +1,333 @@
+#pragma once
+
+#include "../defines.h"
+#include <vector>
+#include <map>
+#include <functional>
+
+namespace star
+{
+	class BaseScene;
+	class Object;
+	class BaseComponent;
+	class Action;
+
+	//Appends plain values to a growing byte buffer. Values keep the
+	//byte order of the device, snapshots aren't meant to be shared
+	//between platforms.
+	class SnapshotWriter final
+	{
+	public:
+		SnapshotWriter();
+		~SnapshotWriter();
+
+		template <typename T>
+		void Write(const T & value);
+		//Overwrites a value written earlier, at the offset it was written.
+		template <typename T>
+		void WriteAt(uint32 offset, const T & value);
+		void WriteString(const tstring & value);
+		void WriteBytes(const void * pData, uint32 size);
+
+		//A block is prefixed with its size,
+		//so a reader can skip what it doesn't understand.
+		void BeginBlock();
+		void EndBlock();
+
+		const schar * GetData() const;
+		uint32 GetSize() const;
+
+	private:
+		std::vector<schar> m_Buffer;
+		std::vector<uint32> m_OpenBlocks;
+
+		SnapshotWriter(const SnapshotWriter &);
+		SnapshotWriter(SnapshotWriter &&);
+		SnapshotWriter & operator=(const SnapshotWriter &);
+		SnapshotWriter & operator=(SnapshotWriter &&);
+	};
+
+	//Reads a snapshot in place, without copying the buffer.
+	//Reading past the end of the data or of the current block
+	//invalidates the reader, after which all reads return zero.
+	class SnapshotReader final
+	{
+	public:
+		SnapshotReader(const schar * pData, uint32 size);
+		~SnapshotReader();
+
+		template <typename T>
+		T Read();
+		tstring ReadString();
+		bool ReadBytes(void * pData, uint32 size);
+
+		void BeginBlock();
+		//Skips whatever wasn't read of the current block.
+		void EndBlock();
+
+		bool IsValid() const;
+		uint32 GetPosition() const;
+		const schar * GetData() const;
+
+	private:
+		bool Require(uint32 size);
+
+		const schar * m_pData;
+		uint32 m_Size,
+			m_Position;
+		std::vector<uint32> m_BlockEnds;
+		bool m_bIsValid;
+
+		SnapshotReader(const SnapshotReader &);
+		SnapshotReader(SnapshotReader &&);
+		SnapshotReader & operator=(const SnapshotReader &);
+		SnapshotReader & operator=(SnapshotReader &&);
+	};
+
+	//Writes the object graph of a scene to a binary snapshot and
+	//rebuilds it in one pass, with the actions of every object.
+	//Types are stored by the hash of the name they were registered
+	//with, so that name has to stay the same between versions of the
+	//game. Objects, components and actions of types that weren't
+	//registered are left out and logged as errors.
+	//The data of a type itself goes through its Serialize and
+	//Deserialize hooks. Callbacks can't be stored, they have to be
+	//set again after reading.
+	class SceneSnapshot final
+	{
+	public:
+		typedef std::function<Object*()> ObjectFactory;
+		typedef std::function<BaseComponent*()> ComponentFactory;
+		typedef std::function<Action*()> ActionFactory;
+
+		//An object tree parsed once, so it can be built any number of
+		//times without reading the snapshot again. Types are resolved to
+		//their factories, and what every object, component and action
+		//wrote itself is kept as a slice of Data for its Deserialize hook.
+		struct ObjectTreeTemplate
+		{
+			struct DataSlice
+			{
+				uint32 Offset;
+				uint32 Size;
+			};
+
+			struct ComponentRecord
+			{
+				uint32 TypeID;
+				uint8 Flags;
+				ComponentFactory Factory;
+				DataSlice Data;
+			};
+
+			struct ActionRecord
+			{
+				uint32 TypeHash;
+				uint8 Flags;
+				tstring Name;
+				uint32 NameHash;
+				ActionFactory Factory;
+				DataSlice Data;
+			};
+
+			struct ObjectRecord
+			{
+				uint32 TypeHash;
+				uint32 ParentIndex;
+				uint8 Flags;
+				tstring Name;
+				uint32 NameHash;
+				tstring GroupTag;
+				tstring PhysicsTag;
+				pos Position;
+				float32 Rotation;
+				vec2 Scale;
+				vec2 CenterPoint;
+				uint8 Mirrors;
+				//Empty for a type that wasn't registered.
+				ObjectFactory Factory;
+				DataSlice Data;
+				std::vector<ComponentRecord> Components;
+				std::vector<ActionRecord> Actions;
+			};
+
+			//Parents come before their children.
+			std::vector<ObjectRecord> Objects;
+			std::vector<schar> Data;
+		};
+
+		//Object and action types are told apart by GetTypeID, so a
+		//registered type has to override it. Registering a type that
+		//doesn't is refused with an error.
+		template <typename T>
+		static void RegisterObjectType(const tstring & name);
+		template <typename T>
+		static void RegisterObjectType(
+			const tstring & name,
+			const ObjectFactory & factory
+			);
+
+		//The factory only has to create the component,
+		//its state is restored by Deserialize afterwards.
+		template <typename T>
+		static void RegisterComponentType(const tstring & name);
+		template <typename T>
+		static void RegisterComponentType(
+			const tstring & name,
+			const ComponentFactory & factory
+			);
+
+		template <typename T>
+		static void RegisterActionType(const tstring & name);
+		template <typename T>
+		static void RegisterActionType(
+			const tstring & name,
+			const ActionFactory & factory
+			);
+
+		static void Write(const BaseScene * pScene, SnapshotWriter & writer);
+		static bool Read(BaseScene * pScene, SnapshotReader & reader);
+		static bool ReadHeader(SnapshotReader & reader, uint32 & sceneHash);
+
+		//A single object with its children. The root that is read back
+		//isn't added to a scene yet.
+		static void WriteObjectTree(const Object * pRoot, SnapshotWriter & writer);
+		static Object * ReadObjectTree(SnapshotReader & reader);
+		//Reads the tree into a template instead, to build it later.
+		static bool ReadObjectTree(
+			SnapshotReader & reader,
+			ObjectTreeTemplate & tree
+			);
+		static Object * BuildObjectTree(const ObjectTreeTemplate & tree);
+
+	private:
+		static const uint32 MAGIC = 0x53535453;
+		static const uint32 VERSION = 2;
+		static const uint32 NO_PARENT = 0xFFFFFFFF;
+
+		enum ObjectFlags : uint8
+		{
+			OBJECT_VISIBLE = 1,
+			OBJECT_FROZEN = 2,
+			OBJECT_DEFAULT_CAMERA = 4
+		};
+
+		enum ComponentFlags : uint8
+		{
+			COMPONENT_ENABLED = 1,
+			COMPONENT_VISIBLE = 2
+		};
+
+		enum ActionFlags : uint8
+		{
+			ACTION_PAUSED = 1
+		};
+
+		struct ComponentDescriptor
+		{
+			uint32 TypeID;
+			ComponentFactory Factory;
+		};
+
+		static void RegisterObjectType(
+			uint32 typeID,
+			const tstring & name,
+			const ObjectFactory & factory
+			);
+		static void RegisterComponentType(
+			uint32 typeID,
+			const tstring & name,
+			const ComponentFactory & factory
+			);
+		static void RegisterActionType(
+			uint32 typeID,
+			const tstring & name,
+			const ActionFactory & factory
+			);
+		static void SetTypeHash(
+			std::vector<uint32> & hashes,
+			uint32 typeID,
+			uint32 hash
+			);
+		static uint32 GetTypeHash(
+			const std::vector<uint32> & hashes,
+			uint32 typeID
+			);
+		static void RegisterDefaultTypes();
+
+		static void WriteObject(
+			const BaseScene * pScene,
+			const Object * pObject,
+			uint32 parentIndex,
+			uint32 & count,
+			SnapshotWriter & writer
+			);
+		static void WriteComponents(
+			const Object * pObject,
+			SnapshotWriter & writer
+			);
+		static void WriteActions(
+			const Object * pObject,
+			SnapshotWriter & writer
+			);
+
+		static bool ParseObjects(
+			SnapshotReader & reader,
+			ObjectTreeTemplate & tree
+			);
+		static void ParseComponents(
+			SnapshotReader & reader,
+			ObjectTreeTemplate & tree,
+			ObjectTreeTemplate::ObjectRecord & record
+			);
+		static void ParseActions(
+			SnapshotReader & reader,
+			ObjectTreeTemplate & tree,
+			ObjectTreeTemplate::ObjectRecord & record
+			);
+		//Copies the next block of the reader to the data of the tree.
+		static void ParseData(
+			SnapshotReader & reader,
+			ObjectTreeTemplate & tree,
+			ObjectTreeTemplate::DataSlice & slice
+			);
+
+		static void BuildObjects(
+			BaseScene * pScene,
+			const ObjectTreeTemplate & tree,
+			std::vector<Object*> & objects
+			);
+		static void BuildComponents(
+			Object * pObject,
+			const ObjectTreeTemplate & tree,
+			const ObjectTreeTemplate::ObjectRecord & record
+			);
+		static void BuildActions(
+			Object * pObject,
+			const ObjectTreeTemplate & tree,
+			const ObjectTreeTemplate::ObjectRecord & record
+			);
+		//Returns false if the hook read past its data.
+		template <typename T>
+		static bool DeserializeData(
+			T * pTarget,
+			const ObjectTreeTemplate & tree,
+			const ObjectTreeTemplate::DataSlice & slice
+			);
+
+		//Indexed by ObjectType ID, 0 for types that weren't registered.
+		static std::vector<uint32> m_ObjectHashes;
+		static std::map<uint32, ObjectFactory> m_ObjectFactories;
+		//Indexed by ComponentType ID, 0 for types that weren't registered.
+		static std::vector<uint32> m_ComponentHashes;
+		static std::map<uint32, ComponentDescriptor> m_ComponentTypes;
+		//Indexed by ActionType ID, 0 for types that weren't registered.
+		static std::vector<uint32> m_ActionHashes;
+		static std::map<uint32, ActionFactory> m_ActionFactories;
+		static bool m_bDefaultTypesRegistered;
+
+		SceneSnapshot();
+	};
+}
+
+#include "SceneSnapshot.inl"
@@ -0,0 +1,98 @@
+#include "../Components/BaseComponent.h"
+#include "../Objects/Object.h"
+#include "../Actions/Action.h"
+#include <cstring>
+
+namespace star
+{
+	template <typename T>
+	void SnapshotWriter::Write(const T & value)
+	{
+		WriteBytes(&value, sizeof(T));
+	}
+
+	template <typename T>
+	void SnapshotWriter::WriteAt(uint32 offset, const T & value)
+	{
+		memcpy(&m_Buffer[offset], &value, sizeof(T));
+	}
+
+	template <typename T>
+	T SnapshotReader::Read()
+	{
+		T value = T();
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterObjectType(const tstring & name)
+	{
+		RegisterObjectType<T>(name, []() -> Object*
+		{
+			return new T();
+		});
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterObjectType(
+		const tstring & name,
+		const ObjectFactory & factory
+		)
+	{
+		RegisterObjectType(ObjectType::GetID<T>(), name, factory);
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterComponentType(const tstring & name)
+	{
+		RegisterComponentType<T>(name, []() -> BaseComponent*
+		{
+			return new T();
+		});
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterComponentType(
+		const tstring & name,
+		const ComponentFactory & factory
+		)
+	{
+		RegisterComponentType(ComponentType::GetID<T>(), name, factory);
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterActionType(const tstring & name)
+	{
+		RegisterActionType<T>(name, []() -> Action*
+		{
+			return new T();
+		});
+	}
+
+	template <typename T>
+	void SceneSnapshot::RegisterActionType(
+		const tstring & name,
+		const ActionFactory & factory
+		)
+	{
+		RegisterActionType(ActionType::GetID<T>(), name, factory);
+	}
+
+	template <typename T>
+	bool SceneSnapshot::DeserializeData(
+		T * pTarget,
+		const ObjectTreeTemplate & tree,
+		const ObjectTreeTemplate::DataSlice & slice
+		)
+	{
+		//Types that wrote nothing have nothing to read either.
+		if(slice.Size == 0)
+		{
+			return true;
+		}
+		SnapshotReader reader(&tree.Data[slice.Offset], slice.Size);
+		pTarget->Deserialize(reader);
+		return reader.IsValid();
+	}
+}
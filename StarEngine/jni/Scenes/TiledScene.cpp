@@ -6,6 +6,7 @@
 #include "../Objects/FreeCamera.h"
 
 #include "../Components/Graphics/SpriteComponent.h"
+#include <cmath>
 
 namespace star
 {
@@ -20,25 +21,84 @@ namespace star
 		, m_TileSets()
 		, m_TiledObjects()
 		, m_Scale(scale)
+		, m_TileLayers()
+		, m_Sectors()
+		, m_ActiveSectors()
+		, m_CommitQueue()
+		, m_StreamedTiles()
+		, m_DecodedMutex()
+		, m_DecodedSectors()
+		, m_SectorSize(16)
+		, m_SectorsX(0)
+		, m_SectorsY(0)
+		, m_TilesPerFrame(64)
+		, m_StreamDistance(256.0f)
+		, m_TotalLoadLatency(0)
+		, m_bIsStreaming(false)
+		, m_StreamingStats()
+		, m_SectorDecoding()
 	{
 
 	}
 
 	TiledScene::~TiledScene()
 	{
+		m_SectorDecoding.Wait();
 	}
 
 	void TiledScene::RemoveObject(Object * object)
 	{
-		auto it = std::find(m_TiledObjects.begin(), m_TiledObjects.end(), object);
-		if(it != m_TiledObjects.end())
+		auto streamed = m_StreamedTiles.find(object);
+		if(streamed != m_StreamedTiles.end())
 		{
-			m_TiledObjects.erase(it);
+			auto & objects = m_Sectors[streamed->second].Objects;
+			auto it = std::find(objects.begin(), objects.end(), object);
+			*it = objects.back();
+			objects.pop_back();
+			m_StreamedTiles.erase(streamed);
+			--m_StreamingStats.ResidentTiles;
+		}
+		else
+		{
+			auto it = std::find(m_TiledObjects.begin(), m_TiledObjects.end(), object);
+			if(it != m_TiledObjects.end())
+			{
+				m_TiledObjects.erase(it);
+			}
 		}
 
 		BaseScene::RemoveObject(object);
 	}
 
+	void TiledScene::SetLevelStreaming(bool enabled, uint32 sectorSize,
+		float32 streamDistance)
+	{
+		if(!m_TileLayers.empty() || !m_TiledObjects.empty())
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("TiledScene::SetLevelStreaming: Only applies to levels created afterwards."),
+				STARENGINE_LOG_TAG);
+		}
+		m_bIsStreaming = enabled;
+		m_SectorSize = sectorSize > 0 ? sectorSize : 1;
+		m_StreamDistance = streamDistance;
+	}
+
+	bool TiledScene::IsLevelStreaming() const
+	{
+		return m_bIsStreaming;
+	}
+
+	void TiledScene::SetStreamingBudget(uint32 tilesPerFrame)
+	{
+		m_TilesPerFrame = tilesPerFrame > 0 ? tilesPerFrame : 1;
+	}
+
+	const TiledScene::StreamingStats & TiledScene::GetStreamingStats() const
+	{
+		return m_StreamingStats;
+	}
+
 	void TiledScene::DefineSpecialObject(
 		const tstring & object_id,
 		const std::function<Object*(const TileObject&)> & func)
@@ -128,6 +188,28 @@ namespace star
 	{
 	}
 
+	TiledScene::StreamingStats::StreamingStats()
+		: SectorCount(0)
+		, ResidentSectors(0)
+		, LoadingSectors(0)
+		, ResidentTiles(0)
+		, LoadedSectors(0)
+		, ReleasedSectors(0)
+		, LastLoadLatency(0)
+		, AverageLoadLatency(0)
+		, MaxLoadLatency(0)
+	{
+	}
+
+	TiledScene::Sector::Sector()
+		: State(SectorState::Unloaded)
+		, Spawns()
+		, CommitIndex(0)
+		, Objects()
+		, RequestTime(0)
+	{
+	}
+
 	void TiledScene::CreateObjects()
 	{
 		if(m_pDefaultCamera == nullptr)
@@ -160,6 +242,11 @@ namespace star
 
 	}
 
+	void TiledScene::UpdateSceneSystems(const Context & context)
+	{
+		UpdateStreaming(context);
+	}
+
 	void TiledScene::Draw()
 	{
 
@@ -233,20 +320,55 @@ namespace star
 
 	void TiledScene::ClearLevel()
 	{
+		ClearSectors();
 		for(auto obj : m_TiledObjects)
 		{
-			RemoveObject(obj);
+			BaseScene::RemoveObject(obj);
 		}
 		m_TiledObjects.clear();
 	}
 
 	void TiledScene::CreateTiledObjects(XMLContainer & container)
+	{
+		//Decoding jobs of a streamed level read the tile layers,
+		//they have to be done before the next level is read in.
+		if(!m_Sectors.empty())
+		{
+			Logger::GetInstance()->Log(LogLevel::Warning,
+				_T("TiledScene::CreateLevel: The streamed tiles of the previous level are released, call ClearLevel first."),
+				STARENGINE_LOG_TAG);
+			ClearSectors();
+		}
+
+		ReadTileLayers(container);
+
+		if(m_bIsStreaming)
+		{
+			InitializeSectors();
+			return;
+		}
+
+		for(const auto & layer : m_TileLayers)
+		{
+			for(uint32 i = 0 ; i < layer.Gids.size() ; ++i)
+			{
+				if(layer.Gids[i] != 0)
+				{
+					TileSpawn spawn;
+					GetTileSpawn(layer, i, spawn);
+					m_TiledObjects.push_back(CreateTile(spawn));
+				}
+			}
+		}
+		//Only streamed levels keep the tile data around.
+		m_TileLayers.clear();
+	}
+
+	void TiledScene::ReadTileLayers(XMLContainer & container)
 	{
 		auto OIT = container.lower_bound(_T("layer"));
 		auto objectsEnd = container.upper_bound(_T("layer"));
 
-		tstring tsName = GetName() + _T("_tileset_default");
-
 		int32 height(0);
 		while ( OIT != objectsEnd )
 		{
@@ -270,56 +392,325 @@ namespace star
 				++lpIT;
 			} while(lpIT != lpEnd);
 
-			float32 sX(m_Scale * m_TileWidth);
-			float32 sY(m_Scale * m_TileHeight);
-
-			uint32 i = 0;
+			TileLayer layer;
+			layer.Height = height;
+			layer.Gids.reserve(m_Width * m_Height);
 			while(TIT != tilesEnd)
 			{
-				uint32 tID = string_cast<int32>(TIT->second->GetAttributes().at(_T("gid")));
-				if(tID != 0)
+				layer.Gids.push_back(
+					string_cast<int32>(TIT->second->GetAttributes().at(_T("gid"))));
+				++TIT;
+			}
+			m_TileLayers.push_back(layer);
+			++OIT;
+		}
+	}
+
+	void TiledScene::GetTileSpawn(const TileLayer & layer, uint32 index,
+		TileSpawn & spawn) const
+	{
+		spawn.Gid = layer.Gids[index];
+		spawn.X = (index % m_Width) * m_Scale * m_TileWidth;
+		spawn.Y = (m_Height - (index / m_Width) - 1) * m_Scale * m_TileHeight;
+		spawn.Height = layer.Height;
+	}
+
+	Object * TiledScene::CreateTile(const TileSpawn & spawn)
+	{
+		TileSet tileSet;
+
+		GetCorrectTileset(spawn.Gid, tileSet);
+
+		Object * obj = new Object();
+		auto transform = obj->GetTransform();
+	#ifdef STAR2D
+		// [TODO] Use height from layer name instead of this hack
+		transform->Translate(
+			spawn.X,
+			spawn.Y,
+			spawn.Height
+			);
+		transform->Scale(m_Scale, m_Scale);
+	#else
+		transform->Translate(
+			spawn.X,
+			spawn.Y,
+			spawn.Height * m_Scale
+			);
+		transform->Scale(m_Scale, m_Scale, m_Scale);
+	#endif
+
+		auto texture = CreateSpriteFromGid(spawn.Gid, tileSet);
+		obj->AddComponent(texture);
+
+		auto extension = m_ExtensionTiles.find(spawn.Gid);
+		if(extension != m_ExtensionTiles.end())
+		{
+			extension->second(obj);
+		}
+
+		AddObject(obj);
+		return obj;
+	}
+
+	void TiledScene::InitializeSectors()
+	{
+		m_SectorsX = (m_Width + m_SectorSize - 1) / m_SectorSize;
+		m_SectorsY = (m_Height + m_SectorSize - 1) / m_SectorSize;
+		m_Sectors.clear();
+		m_Sectors.resize(m_SectorsX * m_SectorsY);
+
+		m_StreamingStats = StreamingStats();
+		m_StreamingStats.SectorCount = m_SectorsX * m_SectorsY;
+		m_TotalLoadLatency = 0;
+
+		Logger::GetInstance()->Log(LogLevel::Info,
+			_T("TiledScene: Streaming the level in ")
+			+ string_cast<tstring>(m_StreamingStats.SectorCount)
+			+ _T(" sectors."), STARENGINE_LOG_TAG);
+	}
+
+	void TiledScene::GetSectorRect(uint32 index, float32 & left, float32 & right,
+		float32 & top, float32 & bottom) const
+	{
+		//Sector rows count from the top of the map, like the tile rows.
+		float32 sectorWidth(m_SectorSize * m_Scale * m_TileWidth);
+		float32 sectorHeight(m_SectorSize * m_Scale * m_TileHeight);
+		uint32 column = index % m_SectorsX;
+		uint32 row = index / m_SectorsX;
+		float32 mapHeight(m_Height * m_Scale * m_TileHeight);
+
+		left = column * sectorWidth;
+		right = left + sectorWidth;
+		top = mapHeight - row * sectorHeight;
+		bottom = top - sectorHeight;
+	}
+
+	bool TiledScene::SectorOverlaps(uint32 index, float32 left, float32 right,
+		float32 top, float32 bottom) const
+	{
+		float32 sectorLeft, sectorRight, sectorTop, sectorBottom;
+		GetSectorRect(index, sectorLeft, sectorRight, sectorTop, sectorBottom);
+		return sectorLeft <= right && sectorRight >= left
+			&& sectorBottom <= top && sectorTop >= bottom;
+	}
+
+	void TiledScene::UpdateStreaming(const Context & context)
+	{
+		if(!m_bIsStreaming || m_Sectors.empty())
+		{
+			return;
+		}
+
+		float32 left, right, top, bottom;
+		GetCullingRect(left, right, top, bottom);
+		left -= m_StreamDistance;
+		right += m_StreamDistance;
+		top += m_StreamDistance;
+		bottom -= m_StreamDistance;
+
+		//Sectors are released one sector further than they are loaded,
+		//so moving along a sector border doesn't keep reloading them.
+		float32 margin(m_SectorSize * m_Scale * std::max(m_TileWidth, m_TileHeight));
+		float32 keepLeft(left - margin), keepRight(right + margin),
+			keepTop(top + margin), keepBottom(bottom - margin);
+
+		float64 time = context.mTimeManager->GetMilliSecondsSinceStart();
+
+		CollectDecodedSectors();
+
+		for(uint32 i = 0 ; i < m_ActiveSectors.size() ;)
+		{
+			uint32 index = m_ActiveSectors[i];
+			if(!SectorOverlaps(index, keepLeft, keepRight, keepTop, keepBottom))
+			{
+				ReleaseSector(index);
+				m_ActiveSectors[i] = m_ActiveSectors.back();
+				m_ActiveSectors.pop_back();
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		RequestSectors(left, right, top, bottom, time);
+		CommitSectors(time);
+	}
+
+	void TiledScene::RequestSectors(float32 left, float32 right, float32 top,
+		float32 bottom, float64 time)
+	{
+		float32 sectorWidth(m_SectorSize * m_Scale * m_TileWidth);
+		float32 sectorHeight(m_SectorSize * m_Scale * m_TileHeight);
+		float32 mapHeight(m_Height * m_Scale * m_TileHeight);
+
+		int32 firstColumn = std::max(int32(floor(left / sectorWidth)), 0);
+		int32 lastColumn = std::min(int32(floor(right / sectorWidth)),
+			int32(m_SectorsX) - 1);
+		int32 firstRow = std::max(int32(floor((mapHeight - top) / sectorHeight)), 0);
+		int32 lastRow = std::min(int32(floor((mapHeight - bottom) / sectorHeight)),
+			int32(m_SectorsY) - 1);
+
+		for(int32 row = firstRow ; row <= lastRow ; ++row)
+		{
+			for(int32 column = firstColumn ; column <= lastColumn ; ++column)
+			{
+				uint32 index = uint32(row) * m_SectorsX + uint32(column);
+				Sector & sector = m_Sectors[index];
+				if(sector.State != SectorState::Unloaded)
 				{
-					TileSet tileSet;
+					continue;
+				}
 
-					GetCorrectTileset(tID, tileSet);
+				sector.State = SectorState::Decoding;
+				sector.RequestTime = time;
+				m_ActiveSectors.push_back(index);
+				++m_StreamingStats.LoadingSectors;
+				m_SectorDecoding.Run([this, index]()
+				{
+					DecodeSector(index);
+				});
+			}
+		}
+	}
 
-					Object * obj = new Object();
-					auto transform = obj->GetTransform();
-					float32 x((i % m_Width) * sX);
-					float32 y((m_Height - (i / m_Width) - 1) * sY);
-				#ifdef STAR2D
-					// [TODO] Use height from layer name instead of this hack
-					transform->Translate(
-						x,
-						y,
-						height
-						);
-					transform->Scale(m_Scale, m_Scale);
-				#else
-					transform->Translate(
-						x,
-						y,
-						height * m_Scale
-						);
-					transform->Scale(m_Scale, m_Scale, m_Scale);
-				#endif
+	void TiledScene::DecodeSector(uint32 index)
+	{
+		//Runs on a worker, only reads the tile data of the level.
+		std::vector<TileSpawn> spawns;
 
-					auto texture = CreateSpriteFromGid(tID, tileSet);
-					obj->AddComponent(texture);
+		uint32 firstColumn = (index % m_SectorsX) * m_SectorSize;
+		uint32 firstRow = (index / m_SectorsX) * m_SectorSize;
+		uint32 lastColumn = std::min(firstColumn + m_SectorSize, m_Width);
+		uint32 lastRow = std::min(firstRow + m_SectorSize, m_Height);
 
-					if(m_ExtensionTiles.find(tID) != m_ExtensionTiles.end())
+		for(const auto & layer : m_TileLayers)
+		{
+			for(uint32 row = firstRow ; row < lastRow ; ++row)
+			{
+				for(uint32 column = firstColumn ; column < lastColumn ; ++column)
+				{
+					uint32 tile = row * m_Width + column;
+					if(tile < layer.Gids.size() && layer.Gids[tile] != 0)
 					{
-						m_ExtensionTiles[tID](obj);
+						TileSpawn spawn;
+						GetTileSpawn(layer, tile, spawn);
+						spawns.push_back(spawn);
 					}
-
-					AddObject(obj);
-					m_TiledObjects.push_back(obj);
 				}
-				++i;
-				++TIT;
 			}
-			++OIT;
 		}
+
+		std::lock_guard<std::mutex> lock(m_DecodedMutex);
+		m_DecodedSectors.push_back(DecodedSector());
+		m_DecodedSectors.back().Index = index;
+		m_DecodedSectors.back().Spawns.swap(spawns);
+	}
+
+	void TiledScene::CollectDecodedSectors()
+	{
+		std::vector<DecodedSector> decodedSectors;
+		{
+			std::lock_guard<std::mutex> lock(m_DecodedMutex);
+			decodedSectors.swap(m_DecodedSectors);
+		}
+
+		for(auto & decoded : decodedSectors)
+		{
+			//Results of sectors released while decoding are dropped.
+			Sector & sector = m_Sectors[decoded.Index];
+			if(sector.State == SectorState::Decoding)
+			{
+				sector.State = SectorState::Decoded;
+				sector.Spawns.swap(decoded.Spawns);
+				sector.CommitIndex = 0;
+				m_CommitQueue.push_back(decoded.Index);
+			}
+		}
+	}
+
+	void TiledScene::CommitSectors(float64 time)
+	{
+		uint32 budget = m_TilesPerFrame;
+		while(budget > 0 && !m_CommitQueue.empty())
+		{
+			uint32 index = m_CommitQueue.front();
+			Sector & sector = m_Sectors[index];
+			while(budget > 0 && sector.CommitIndex < sector.Spawns.size())
+			{
+				Object * tile = CreateTile(sector.Spawns[sector.CommitIndex]);
+				sector.Objects.push_back(tile);
+				m_StreamedTiles[tile] = index;
+				++m_StreamingStats.ResidentTiles;
+				++sector.CommitIndex;
+				--budget;
+			}
+
+			if(sector.CommitIndex == sector.Spawns.size())
+			{
+				sector.State = SectorState::Resident;
+				std::vector<TileSpawn>().swap(sector.Spawns);
+				m_CommitQueue.pop_front();
+
+				float64 latency = time - sector.RequestTime;
+				m_TotalLoadLatency += latency;
+				++m_StreamingStats.LoadedSectors;
+				--m_StreamingStats.LoadingSectors;
+				++m_StreamingStats.ResidentSectors;
+				m_StreamingStats.LastLoadLatency = latency;
+				m_StreamingStats.MaxLoadLatency =
+					std::max(m_StreamingStats.MaxLoadLatency, latency);
+				m_StreamingStats.AverageLoadLatency =
+					m_TotalLoadLatency / m_StreamingStats.LoadedSectors;
+			}
+		}
+	}
+
+	void TiledScene::ReleaseSector(uint32 index)
+	{
+		Sector & sector = m_Sectors[index];
+		if(sector.State == SectorState::Resident)
+		{
+			--m_StreamingStats.ResidentSectors;
+		}
+		else
+		{
+			--m_StreamingStats.LoadingSectors;
+		}
+		if(sector.State == SectorState::Decoded)
+		{
+			m_CommitQueue.erase(
+				std::find(m_CommitQueue.begin(), m_CommitQueue.end(), index));
+		}
+
+		for(auto obj : sector.Objects)
+		{
+			m_StreamedTiles.erase(obj);
+			BaseScene::RemoveObject(obj);
+		}
+		m_StreamingStats.ResidentTiles -= uint32(sector.Objects.size());
+		std::vector<Object*>().swap(sector.Objects);
+		std::vector<TileSpawn>().swap(sector.Spawns);
+		sector.CommitIndex = 0;
+		sector.State = SectorState::Unloaded;
+		++m_StreamingStats.ReleasedSectors;
+	}
+
+	void TiledScene::ClearSectors()
+	{
+		m_SectorDecoding.Wait();
+		for(uint32 index : m_ActiveSectors)
+		{
+			ReleaseSector(index);
+		}
+		m_ActiveSectors.clear();
+		m_CommitQueue.clear();
+		m_DecodedSectors.clear();
+		m_Sectors.clear();
+		m_TileLayers.clear();
+		m_SectorsX = 0;
+		m_SectorsY = 0;
 	}
 
 	void TiledScene::CreateGroupedObjects(XMLContainer & container)
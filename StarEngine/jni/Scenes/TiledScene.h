@@ -1,7 +1,11 @@
 #pragma once
 
 #include "BaseScene.h"
+#include "../Helpers/JobSystem.h"
 #include <map>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <functional>
 
 namespace star
@@ -27,10 +31,39 @@ namespace star
 			TileObject();
 		};
 
+		struct StreamingStats
+		{
+			uint32 SectorCount,
+				ResidentSectors,
+				LoadingSectors,
+				ResidentTiles,
+				LoadedSectors,
+				ReleasedSectors;
+			//From the request of a sector until its last tile is created, in ms.
+			float64 LastLoadLatency,
+				AverageLoadLatency,
+				MaxLoadLatency;
+
+			StreamingStats();
+		};
+
 		TiledScene(const tstring & name, float32 scale = 1.0f);
 		virtual ~TiledScene();
 
 		virtual void RemoveObject(Object * object);
+
+		//Call before CreateLevel. The tiles are then streamed in sectors of
+		//sectorSize by sectorSize tiles: sectors within streamDistance of
+		//the culling area are decoded on the JobSystem and created over the
+		//next frames, sectors further away are released. Object groups are
+		//still created up front. Streaming runs before the scene's Update.
+		void SetLevelStreaming(bool enabled, uint32 sectorSize = 16,
+			float32 streamDistance = 256.0f);
+		bool IsLevelStreaming() const;
+		//The maximum amount of tiles created per frame.
+		void SetStreamingBudget(uint32 tilesPerFrame);
+		const StreamingStats & GetStreamingStats() const;
+
 	protected:
 
 		virtual void CreateObjects();
@@ -69,8 +102,84 @@ namespace star
 		std::map<uint32, std::function<void(Object*)>> m_ExtensionTiles;
 
 	private:
+		struct TileLayer
+		{
+			int32 Height;
+			std::vector<uint32> Gids;
+		};
+
+		struct TileSpawn
+		{
+			uint32 Gid;
+			float32 X, Y;
+			int32 Height;
+		};
+
+		enum class SectorState : byte
+		{
+			Unloaded = 0,
+			Decoding = 1,
+			Decoded = 2,
+			Resident = 3
+		};
+
+		struct Sector
+		{
+			Sector();
+
+			SectorState State;
+			std::vector<TileSpawn> Spawns;
+			uint32 CommitIndex;
+			std::vector<Object*> Objects;
+			float64 RequestTime;
+		};
+
+		struct DecodedSector
+		{
+			uint32 Index;
+			std::vector<TileSpawn> Spawns;
+		};
+
+		void UpdateSceneSystems(const Context & context) final;
+
 		void CreateTiledObjects(XMLContainer & container);
 		void CreateGroupedObjects(XMLContainer & container);
+		void ReadTileLayers(XMLContainer & container);
+		void GetTileSpawn(const TileLayer & layer, uint32 index,
+			TileSpawn & spawn) const;
+		Object * CreateTile(const TileSpawn & spawn);
+
+		void InitializeSectors();
+		void GetSectorRect(uint32 index, float32 & left, float32 & right,
+			float32 & top, float32 & bottom) const;
+		bool SectorOverlaps(uint32 index, float32 left, float32 right,
+			float32 top, float32 bottom) const;
+		void UpdateStreaming(const Context & context);
+		void RequestSectors(float32 left, float32 right, float32 top,
+			float32 bottom, float64 time);
+		void DecodeSector(uint32 index);
+		void CollectDecodedSectors();
+		void CommitSectors(float64 time);
+		void ReleaseSector(uint32 index);
+		void ClearSectors();
+
+		std::vector<TileLayer> m_TileLayers;
+		std::vector<Sector> m_Sectors;
+		std::vector<uint32> m_ActiveSectors;
+		std::deque<uint32> m_CommitQueue;
+		std::unordered_map<const Object*, uint32> m_StreamedTiles;
+		std::mutex m_DecodedMutex;
+		std::vector<DecodedSector> m_DecodedSectors;
+		uint32 m_SectorSize,
+			m_SectorsX,
+			m_SectorsY,
+			m_TilesPerFrame;
+		float32 m_StreamDistance;
+		float64 m_TotalLoadLatency;
+		bool m_bIsStreaming;
+		StreamingStats m_StreamingStats;
+		//Last member, so decoding jobs are done before the data they use goes.
+		TaskGroup m_SectorDecoding;
 
 		TiledScene(const TiledScene& t);
 		TiledScene(TiledScene&& t);
@@ -13,6 +13,15 @@
 #include "AI/Pathfinding/PathFindManager.h"
 #include "Physics/Collision/CollisionManager.h"
 #include "Helpers/Debug/DebugDraw.h"
+#include "Components/TransformStore.h"
+#include "Helpers/MemoryPool.h"
+#include "Helpers/StringTable.h"
+#include "Helpers/JobSystem.h"
+#include "Helpers/Handle.h"
+#include "Scenes/BaseScene.h"
+#include "Objects/BaseCamera.h"
+#include "Components/CameraComponent.h"
+#include <cmath>
 
 namespace star
 {
@@ -33,6 +42,9 @@ namespace star
 
 	void StarEngine::Initialize(int32 window_width, int32 window_height)
 	{
+		//Before anything creates pooled objects.
+		MemoryPool::Create();
+
 		std::random_device seeder;
 		m_RandomEngine.seed(seeder());
 
@@ -51,20 +63,89 @@ namespace star
 	void StarEngine::Update(const Context & context)
 	{
 		m_FPS.Update(context);
-		SceneManager::GetInstance()->Update(context);
+		ScaleSystem::GetInstance()->UpdateDynamicResolution(context);
+		uint32 steps(1);
+		if(m_FixedTimeStep > 0)
+		{
+			steps = UpdateFixedSteps(context);
+		}
+		else
+		{
+			SceneManager::GetInstance()->Update(context);
+		}
 		GraphicsManager::GetInstance()->Update();
-		InputManager::GetInstance()->EndUpdate();
+		//Input of a frame without a step is kept for the next one.
+		if(steps > 0)
+		{
+			InputManager::GetInstance()->EndUpdate();
+			m_bInitialized = true;
+		}
+		if(m_bInitialized && SpriteBatch::GetInstance()->IsPipelined())
+		{
+			SceneManager::GetInstance()->Draw();
+		}
 		Logger::GetInstance()->Update(context);
 #if defined(DEBUG) | defined(_DEBUG)
 		Logger::GetInstance()->CheckGlError();
 #endif
-		m_bInitialized = true;
+	}
+
+	uint32 StarEngine::UpdateFixedSteps(const Context & context)
+	{
+		TimeManager * timeManager = context.mTimeManager;
+		m_Accumulator += timeManager->GetFrameSeconds();
+
+		uint32 steps(0);
+		while(m_Accumulator >= m_FixedTimeStep && steps < m_MaxFixedSteps)
+		{
+#ifdef STAR2D
+			//Looked up every step, a step can switch the active scene.
+			BaseScene * pStepScene = SceneManager::GetInstance()->GetActiveScene();
+			if(pStepScene != nullptr)
+			{
+				pStepScene->GetTransformStore()->StorePreviousState();
+			}
+#endif
+			timeManager->SetStepDelta(m_FixedTimeStep);
+			SceneManager::GetInstance()->Update(context);
+			m_Accumulator -= m_FixedTimeStep;
+			++steps;
+		}
+		timeManager->RestoreFrameDelta();
+
+		//Time that couldn't be caught up with is dropped,
+		//the game slows down rather than falling further behind.
+		if(m_Accumulator >= m_FixedTimeStep)
+		{
+			m_Accumulator = fmod(m_Accumulator, m_FixedTimeStep);
+		}
+
+		m_InterpolationAlpha = float32(m_Accumulator / m_FixedTimeStep);
+
+		//The view follows the interpolated camera position.
+		auto scene = SceneManager::GetInstance()->GetActiveScene();
+#ifdef STAR2D
+		if(scene != nullptr)
+		{
+			scene->GetTransformStore()->Interpolate(m_InterpolationAlpha);
+		}
+#endif
+		if(scene != nullptr && scene->GetActiveCamera() != nullptr)
+		{
+			scene->GetActiveCamera()->GetComponent<CameraComponent>()
+				->CalculateViewMatrix();
+		}
+		return steps;
 	}
 
 	void StarEngine::Draw()
 	{
 		GraphicsManager::GetInstance()->StartDraw();
-		if(m_bInitialized)
+		if(SpriteBatch::GetInstance()->IsPipelined())
+		{
+			SpriteBatch::GetInstance()->SubmitPacket();
+		}
+		else if(m_bInitialized)
 		{
 			SceneManager::GetInstance()->Draw();
 		}
@@ -84,6 +165,16 @@ namespace star
 		delete AudioManager::GetInstance();
 		delete PathFindManager::GetInstance();
 		delete SceneManager::GetInstance();
+		//After the scenes, which unregister their objects and components.
+		delete HandleTable<Object>::GetInstance();
+		delete HandleTable<BaseComponent>::GetInstance();
+#ifdef STAR2D
+		delete TransformStore::GetInstance();
+#endif
+		delete JobSystem::GetInstance();
+		delete StringTable::GetInstance();
+		//Pooled objects deleted after this leave their blocks to the OS.
+		delete MemoryPool::GetInstance();
 		delete Logger::GetInstance();
 	}
 	
@@ -107,6 +198,74 @@ namespace star
 		return m_FPS.PreviousFPS;
 	}
 
+	void StarEngine::SetFixedTimeStep(uint32 stepsPerSecond, uint32 maxSteps)
+	{
+		m_FixedTimeStep = stepsPerSecond > 0
+			? 1.0 / float64(stepsPerSecond)
+			: 0;
+		m_MaxFixedSteps = maxSteps > 0 ? maxSteps : 1;
+		m_Accumulator = 0;
+		m_InterpolationAlpha = 1.0f;
+#ifdef STAR2D
+		//Drops any interpolated state, drawing uses the world state again.
+		//Other scenes drop theirs when they are activated.
+		auto scene = SceneManager::GetInstance()->GetActiveScene();
+		if(scene != nullptr)
+		{
+			scene->GetTransformStore()->StorePreviousState();
+		}
+#endif
+	}
+
+	bool StarEngine::IsFixedTimeStep() const
+	{
+		return m_FixedTimeStep > 0;
+	}
+
+	float64 StarEngine::GetFixedTimeStep() const
+	{
+		return m_FixedTimeStep;
+	}
+
+	float32 StarEngine::GetInterpolationAlpha() const
+	{
+		return m_InterpolationAlpha;
+	}
+
+	FramePacer & StarEngine::GetFramePacer()
+	{
+		return m_FramePacer;
+	}
+
+	void StarEngine::SetFramePipelining(bool pipelined)
+	{
+		SpriteBatch::GetInstance()->SetPipelined(pipelined);
+	}
+
+	bool StarEngine::IsFramePipelining() const
+	{
+		return SpriteBatch::GetInstance()->IsPipelined();
+	}
+
+	uint32 StarEngine::GetFrameLatency() const
+	{
+		return SpriteBatch::GetInstance()->GetFrameLatency();
+	}
+
+	void StarEngine::BenchmarkJobSystem(uint32 spriteCount)
+	{
+		//Restarting the workers drops queued jobs,
+		//no packet may be building while it runs.
+		SpriteBatch::GetInstance()->DiscardPackets();
+		SpriteBatch::GetInstance()->BenchmarkQuadGeneration(spriteCount);
+
+		auto scene = SceneManager::GetInstance()->GetActiveScene();
+		if(scene != nullptr)
+		{
+			scene->GetCollisionManager()->BenchmarkPairTests();
+		}
+	}
+
 	void StarEngine::SetGameTitle(const tstring & title)
 	{
 		m_Title = title;
@@ -162,11 +321,16 @@ namespace star
 
 	StarEngine::StarEngine()
 		: m_FPS()
+		, m_FramePacer()
 		, m_Title(EMPTY_STRING)
 		, m_SubTitle(EMPTY_STRING)
 		, m_TitleHasUpdated(false) 
 		, m_bInitialized (false)
 		, m_RandomEngine()
+		, m_FixedTimeStep(0)
+		, m_Accumulator(0)
+		, m_MaxFixedSteps(5)
+		, m_InterpolationAlpha(1.0f)
 	{
 
 	}
@@ -2,6 +2,7 @@
 
 #include "defines.h"
 #include "Helpers/FPS.h"
+#include "Helpers/FramePacer.h"
 #include <memory>
 
 #include "Scenes/LoadScreen.h"
@@ -38,6 +39,32 @@ namespace star
 		int32 GetCurrentFPS() const;
 		int32 GetPreviousFPS() const;
 
+		//Records the frame at the end of Update and draws it during the
+		//next Draw, so its quads are built while the next frame simulates.
+		//Adds one frame of latency between update and display. Scenes
+		//that issue GL calls of their own in Draw should leave it off.
+		void SetFramePipelining(bool pipelined);
+		bool IsFramePipelining() const;
+		uint32 GetFrameLatency() const;
+
+		//Logs how the JobSystem scales over 1, 2, 4 and 8 threads on its
+		//two consumers: quad generation for spriteCount sprites and the
+		//collision pair tests of the active scene. Drops the frames that
+		//are being pipelined, as the workers are restarted.
+		void BenchmarkJobSystem(uint32 spriteCount = 10000);
+
+		//Updates the scenes at a fixed rate instead of once per frame,
+		//with at most maxSteps steps to catch up in a single frame.
+		//Drawing interpolates the transforms between the last two steps.
+		//A rate of 0 goes back to one variable update per frame.
+		void SetFixedTimeStep(uint32 stepsPerSecond, uint32 maxSteps = 5);
+		bool IsFixedTimeStep() const;
+		float64 GetFixedTimeStep() const;
+		float32 GetInterpolationAlpha() const;
+
+		//Used by the platform loop to pace frames and idle in low-power mode.
+		FramePacer & GetFramePacer();
+
 		void SetGameTitle(const tstring & title);
 		void SetGameSubTitle(const tstring & title);
 
@@ -56,11 +83,18 @@ namespace star
 #endif
 
 	private:
+		uint32 UpdateFixedSteps(const Context & context);
+
 		static std::shared_ptr<StarEngine> m_pEngine;
 		FPS m_FPS;
+		FramePacer m_FramePacer;
 		tstring m_Title, m_SubTitle;
 		bool m_TitleHasUpdated;
 		std::mt19937 m_RandomEngine;
+		float64 m_FixedTimeStep,
+				m_Accumulator;
+		uint32 m_MaxFixedSteps;
+		float32 m_InterpolationAlpha;
 
 #ifdef ANDROID
 		android_app *m_pAndroidApp;
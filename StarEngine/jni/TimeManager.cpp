@@ -18,6 +18,8 @@ namespace star
 		,mDeltaS(0)
 		,mDeltauS(0)
 		,mTotalMS(0)
+		,mFrameDeltaS(0)
+		,mIsStepDelta(false)
 	{
 
 	}
@@ -56,6 +58,8 @@ namespace star
 		mDeltaS  = (mF2 - mF1);
 #endif
 		mTotalMS += mDeltaMs;
+		mFrameDeltaS = mDeltaS;
+		mIsStepDelta = false;
 	}
 
 	float64 TimeManager::GetSeconds() const
@@ -73,6 +77,30 @@ namespace star
 		return mDeltauS;
 	}
 
+	void TimeManager::SetStepDelta(float64 seconds)
+	{
+		mIsStepDelta = true;
+		mDeltaS = seconds;
+		mDeltaMs = seconds * MILLIMULTIPLIER;
+		mDeltauS = seconds * MICROMULTIPLIER;
+	}
+
+	void TimeManager::RestoreFrameDelta()
+	{
+		if(mIsStepDelta)
+		{
+			mIsStepDelta = false;
+			mDeltaS = mFrameDeltaS;
+			mDeltaMs = mFrameDeltaS * MILLIMULTIPLIER;
+			mDeltauS = mFrameDeltaS * MICROMULTIPLIER;
+		}
+	}
+
+	float64 TimeManager::GetFrameSeconds() const
+	{
+		return mFrameDeltaS;
+	}
+
 	float64 TimeManager::GetMilliSecondsSinceStart() const
 	{
 		return mTotalMS;
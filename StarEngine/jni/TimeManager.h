@@ -29,6 +29,12 @@ namespace star
 		float64 GetSecondsSinceStart() const;
 		float64 GetMilliSecondsSinceStart() const;
 
+		//Lets the deltas report a fixed simulation step instead of the
+		//measured frame time, until the frame delta gets restored.
+		void SetStepDelta(float64 seconds);
+		void RestoreFrameDelta();
+		float64 GetFrameSeconds() const;
+
 		tstring GetTimeStamp();
 
 	private:
@@ -49,6 +55,9 @@ namespace star
 
 		float64	mTotalMS;
 
+		float64	mFrameDeltaS;
+		bool	mIsStepDelta;
+
 		TimeManager(const TimeManager& t);
 		TimeManager(TimeManager&& t);
 		TimeManager& operator=(const TimeManager& t);
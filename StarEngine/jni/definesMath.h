@@ -36,6 +36,9 @@ typedef glm::dmat2 dmat2;
 typedef glm::dmat3 dmat3;
 typedef glm::dmat4 dmat4;
 
+//3 columns of 2 rows: a 2D affine transform (x axis, y axis, translation)
+typedef glm::fmat3x2 fmat3x2;
+
 typedef fvec2 vec2;
 typedef fvec3 vec3;
 typedef fvec4 vec4;
@@ -45,6 +48,7 @@ typedef fquat quat;
 typedef fmat2 mat2;
 typedef fmat3 mat3;
 typedef fmat4 mat4;
+typedef fmat3x2 mat3x2;
 
 /// <summary>
 /// A constant value that represents the mathematical number 'Pi'.